@@ -0,0 +1,576 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+
+using namespace S21;
+
+// Every benchmark reports bytes/s over the elements it reads and writes
+// and, where the operation has a standard count, FLOP/s. The counts of
+// the factorizations are the nominal ones of LU: 2/3 n^3 for the
+// determinant, 2 n^3 for the inverse and 8/3 n^3 for the complements.
+
+namespace {
+
+template <typename T>
+S21Matrix<T> Filled(std::size_t rows, std::size_t cols, std::size_t seed = 0) {
+  S21Matrix<T> matrix(rows, cols);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      matrix(i, j) = static_cast<T>((i * 7 + j * 3 + seed) % 11);
+  return matrix;
+}
+
+// Diagonally dominant with a unit diagonal, so that every factorization is
+// well conditioned and the determinant stays finite at every size.
+template <typename T>
+S21Matrix<T> Invertible(std::size_t n) {
+  S21Matrix<T> matrix(n, n);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      matrix(i, j) = i == j ? T(1)
+                            : static_cast<T>(std::sin(i * 0.7 + j * 0.3) /
+                                             (2.0 * n));
+  return matrix;
+}
+
+// Symmetric and diagonally dominant, so positive definite.
+template <typename T>
+S21Matrix<T> SymmetricPositive(std::size_t n) {
+  S21Matrix<T> matrix(n, n);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      matrix(i, j) = i == j ? T(1)
+                            : static_cast<T>(std::sin((i + j) * 0.7) /
+                                             (2.0 * n));
+  return matrix;
+}
+
+void Report(benchmark::State &state, double flops, double bytes) {
+  const double iterations = static_cast<double>(state.iterations());
+  if (flops > 0)
+    state.counters["FLOP/s"] = benchmark::Counter(
+        flops * iterations, benchmark::Counter::kIsRate,
+        benchmark::Counter::kIs1000);
+  state.counters["bytes/s"] = benchmark::Counter(
+      bytes * iterations, benchmark::Counter::kIsRate,
+      benchmark::Counter::kIs1024);
+}
+
+double Cube(std::size_t n) { return static_cast<double>(n) * n * n; }
+
+}  // namespace
+
+// Constructors and assignment
+
+template <typename T>
+void BM_Construct(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  for (auto _ : state) {
+    S21Matrix<T> matrix(n, n);
+    benchmark::DoNotOptimize(matrix.Data());
+  }
+  Report(state, 0, n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Copy(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> source = Filled<T>(n, n);
+  for (auto _ : state) {
+    S21Matrix<T> copy(source);
+    benchmark::DoNotOptimize(copy.Data());
+  }
+  Report(state, 0, 2.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Move(benchmark::State &state) {
+  S21Matrix<T> matrix = Filled<T>(state.range(0), state.range(0));
+  for (auto _ : state) {
+    S21Matrix<T> moved(std::move(matrix));
+    matrix = std::move(moved);
+    benchmark::DoNotOptimize(matrix.Data());
+  }
+  Report(state, 0, 0);
+}
+
+// Element-wise operations
+
+template <typename T>
+void BM_SumMatrix(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Filled<T>(n, n);
+  const S21Matrix<T> b = Filled<T>(n, n, 1);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  Report(state, n * n, 3.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_SubMatrix(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Filled<T>(n, n);
+  const S21Matrix<T> b = Filled<T>(n, n, 1);
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  Report(state, n * n, 3.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_MulNumber(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Filled<T>(n, n);
+  for (auto _ : state) {
+    a.MulNumber(T(1));
+    benchmark::DoNotOptimize(a.Data());
+  }
+  Report(state, n * n, 2.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_EqMatrix(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n), b = Filled<T>(n, n);
+  for (auto _ : state) benchmark::DoNotOptimize(a.EqMatrix(b));
+  Report(state, 0, 2.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_CompareUlp(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n), b = Filled<T>(n, n);
+  CompareOptions options;
+  options.mode = Comparison::kUlp;
+  for (auto _ : state) benchmark::DoNotOptimize(Compare(a, b, options));
+  Report(state, 0, 2.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Diff(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n), b = Filled<T>(n, n);
+  for (auto _ : state) benchmark::DoNotOptimize(Diff(a, b));
+  Report(state, 0, 2.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Expression(benchmark::State &state) {
+  // a + b * 2 - c, evaluated in one pass into an existing matrix.
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n), b = Filled<T>(n, n, 1);
+  const S21Matrix<T> c = Filled<T>(n, n, 2);
+  S21Matrix<T> result(n, n);
+  for (auto _ : state) {
+    result = a + b * T(2) - c;
+    benchmark::DoNotOptimize(result.Data());
+  }
+  Report(state, 3.0 * n * n, 4.0 * n * n * sizeof(T));
+}
+
+// Products and factorizations
+
+template <typename T>
+void BM_MulMatrix(benchmark::State &state) {
+  const std::size_t m = state.range(0), k = state.range(1);
+  const std::size_t n = state.range(2);
+  const S21Matrix<T> a = Filled<T>(m, k), b = Filled<T>(k, n, 1);
+  for (auto _ : state) {
+    S21Matrix<T> c = a;
+    c.MulMatrix(b);
+    benchmark::DoNotOptimize(c.Data());
+  }
+  Report(state, 2.0 * m * n * k, (m * k + k * n + m * n) * sizeof(T));
+}
+
+template <typename T>
+void BM_GemmReference(benchmark::State &state) {
+  // The naive triple loop, as the baseline for BM_MulMatrix.
+  const std::size_t m = state.range(0), k = state.range(1);
+  const std::size_t n = state.range(2);
+  const S21Matrix<T> a = Filled<T>(m, k), b = Filled<T>(k, n, 1);
+  S21Matrix<T> c(m, n);
+  for (auto _ : state) {
+    detail::GemmReference(m, n, k, T(1), a.Data(), a.Stride(), b.Data(),
+                          b.Stride(), T(0), c.Data(), c.Stride());
+    benchmark::DoNotOptimize(c.Data());
+  }
+  Report(state, 2.0 * m * n * k, (m * k + k * n + m * n) * sizeof(T));
+}
+
+template <typename T>
+void BM_MulMatrixStrassen(benchmark::State &state) {
+  // Counted at the flops of the classical product, for comparison.
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n), b = Filled<T>(n, n, 1);
+  for (auto _ : state) {
+    S21Matrix<T> c = MulMatrixStrassen(a, b);
+    benchmark::DoNotOptimize(c.Data());
+  }
+  Report(state, 2.0 * Cube(n), 3.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Determinant(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Invertible<T>(n);
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+  Report(state, 2.0 / 3.0 * Cube(n), n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_MinorDeterminant(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Invertible<T>(n);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(a.GetMinor(n / 2, n / 2).Determinant());
+  Report(state, 2.0 / 3.0 * Cube(n - 1), n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_MinorViewDeterminant(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Invertible<T>(n);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(LU<T>(a.GetMinorView(n / 2, n / 2)).Determinant());
+  Report(state, 2.0 / 3.0 * Cube(n - 1), n * n * sizeof(T));
+}
+
+// Factorizations of a symmetric positive definite matrix
+
+template <typename T>
+void BM_SymmetricLU(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = SymmetricPositive<T>(n);
+  for (auto _ : state) benchmark::DoNotOptimize(LU<T>(a).Determinant());
+  Report(state, 2.0 / 3.0 * Cube(n), n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Cholesky(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = SymmetricPositive<T>(n);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Cholesky<T>(a).LogDeterminant());
+  Report(state, 1.0 / 3.0 * Cube(n), n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_LDLT(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = SymmetricPositive<T>(n);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(LDLT<T>(a).LogAbsDeterminant());
+  Report(state, 1.0 / 3.0 * Cube(n), n * n * sizeof(T));
+}
+
+// Linear systems with n unknowns and m right-hand sides
+
+template <typename T>
+void BM_Solve(benchmark::State &state) {
+  const std::size_t n = state.range(0), m = state.range(1);
+  const S21Matrix<T> a = Invertible<T>(n), b = Filled<T>(n, m);
+  for (auto _ : state) {
+    S21Matrix<T> x = Solve(a, b);
+    benchmark::DoNotOptimize(x.Data());
+  }
+  Report(state, 2.0 / 3.0 * Cube(n) + 2.0 * n * n * m,
+         (n * n + 2.0 * n * m) * sizeof(T));
+}
+
+template <typename T>
+void BM_SolveMixedPrecision(benchmark::State &state) {
+  const std::size_t n = state.range(0), m = state.range(1);
+  const S21Matrix<T> a = Invertible<T>(n), b = Filled<T>(n, m);
+  for (auto _ : state) {
+    RefinementResult<T> result = SolveMixedPrecision(a, b);
+    benchmark::DoNotOptimize(result.solution.Data());
+  }
+  Report(state, 2.0 / 3.0 * Cube(n) + 2.0 * n * n * m,
+         (n * n + 2.0 * n * m) * sizeof(T));
+}
+
+template <typename T>
+void BM_LUSolve(benchmark::State &state) {
+  const std::size_t n = state.range(0), m = state.range(1);
+  const LU<T> lu(Invertible<T>(n));
+  const S21Matrix<T> b = Filled<T>(n, m);
+  S21Matrix<T> x(n, m);
+  for (auto _ : state) {
+    lu.Solve(b, x);
+    benchmark::DoNotOptimize(x.Data());
+  }
+  Report(state, 2.0 * n * n * m, (n * n + 2.0 * n * m) * sizeof(T));
+}
+
+template <typename T>
+void BM_InverseThenMultiply(benchmark::State &state) {
+  const std::size_t n = state.range(0), m = state.range(1);
+  S21Matrix<T> a = Invertible<T>(n);
+  const S21Matrix<T> b = Filled<T>(n, m);
+  for (auto _ : state) {
+    S21Matrix<T> x = a.InverseMatrix() * b;
+    benchmark::DoNotOptimize(x.Data());
+  }
+  Report(state, 2.0 * Cube(n) + 2.0 * n * n * m,
+         (n * n + 2.0 * n * m) * sizeof(T));
+}
+
+template <typename T>
+void BM_InverseMatrix(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Invertible<T>(n);
+  for (auto _ : state) {
+    S21Matrix<T> inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  Report(state, 2.0 * Cube(n), 2.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_CalcComplements(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Invertible<T>(n);
+  for (auto _ : state) {
+    S21Matrix<T> complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.Data());
+  }
+  Report(state, 8.0 / 3.0 * Cube(n), 2.0 * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_Gemv(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n);
+  S21Vector<T> x(n), y(n);
+  for (std::size_t i = 0; i < n; i++) x[i] = T(1);
+  for (auto _ : state) {
+    Gemv(T(1), a, x, T(0), y);
+    benchmark::DoNotOptimize(y.Data());
+  }
+  Report(state, 2.0 * n * n, (n * n + 2.0 * n) * sizeof(T));
+}
+
+template <typename T>
+void BM_GemvT(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n);
+  S21Vector<T> x(n), y(n);
+  for (std::size_t i = 0; i < n; i++) x[i] = T(1);
+  for (auto _ : state) {
+    GemvT(T(1), a, x, T(0), y);
+    benchmark::DoNotOptimize(y.Data());
+  }
+  Report(state, 2.0 * n * n, (n * n + 2.0 * n) * sizeof(T));
+}
+
+template <typename T>
+void BM_MulMatrixColumn(benchmark::State &state) {
+  // The n x 1 matrix product that Gemv replaces.
+  const std::size_t n = state.range(0);
+  const S21Matrix<T> a = Filled<T>(n, n), x(n, 1);
+  for (auto _ : state) {
+    S21Matrix<T> y = a * x;
+    benchmark::DoNotOptimize(y.Data());
+  }
+  Report(state, 2.0 * n * n, (n * n + 2.0 * n) * sizeof(T));
+}
+
+// Shape changes
+
+template <typename T>
+void BM_Transpose(benchmark::State &state) {
+  const std::size_t m = state.range(0), n = state.range(1);
+  const S21Matrix<T> a = Filled<T>(m, n);
+  for (auto _ : state) {
+    S21Matrix<T> transposed = a.Transpose();
+    benchmark::DoNotOptimize(transposed.Data());
+  }
+  Report(state, 0, 2.0 * m * n * sizeof(T));
+}
+
+template <typename T>
+void BM_TransposeInPlace(benchmark::State &state) {
+  const std::size_t m = state.range(0), n = state.range(1);
+  S21Matrix<T> a = Filled<T>(m, n);
+  for (auto _ : state) {
+    a.TransposeInPlace();
+    benchmark::DoNotOptimize(a.Data());
+  }
+  Report(state, 0, 2.0 * m * n * sizeof(T));
+}
+
+template <typename T>
+void BM_SetRowsCols(benchmark::State &state) {
+  // One row and one column added and removed again per iteration.
+  const std::size_t n = state.range(0);
+  S21Matrix<T> a = Filled<T>(n, n);
+  for (auto _ : state) {
+    a.SetRows(n + 1);
+    a.SetCols(n + 1);
+    a.SetRows(n);
+    a.SetCols(n);
+    benchmark::DoNotOptimize(a.Data());
+  }
+  Report(state, 0, 8.0 * n * n * sizeof(T));
+}
+
+// Companion types
+
+template <typename T>
+void BM_BatchMulMatrix(benchmark::State &state) {
+  const std::size_t count = state.range(0), n = state.range(1);
+  S21MatrixBatch<T> a(count, n, n), b(count, n, n);
+  for (std::size_t i = 0; i < count; i++) a.Set(i, Filled<T>(n, n, i));
+  for (std::size_t i = 0; i < count; i++) b.Set(i, Filled<T>(n, n, i + 1));
+  for (auto _ : state) {
+    S21MatrixBatch<T> c = a;
+    c.MulMatrix(b);
+    benchmark::DoNotOptimize(c.Data());
+  }
+  Report(state, 2.0 * count * Cube(n), 3.0 * count * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_BatchInverse(benchmark::State &state) {
+  const std::size_t count = state.range(0), n = state.range(1);
+  S21MatrixBatch<T> a(count, n, n);
+  for (std::size_t i = 0; i < count; i++) a.Set(i, Invertible<T>(n));
+  for (auto _ : state) {
+    S21MatrixBatch<T> inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.Data());
+  }
+  Report(state, 2.0 * count * Cube(n), 2.0 * count * n * n * sizeof(T));
+}
+
+template <typename T>
+void BM_FixedMulInverse(benchmark::State &state) {
+  S21FixedMatrix<T, 4, 4> a = S21FixedMatrix<T, 4, 4>::Identity();
+  for (std::size_t i = 0; i < 4; i++) a(i, (i + 1) % 4) = T(0.5);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    S21FixedMatrix<T, 4, 4> product = a * a.InverseMatrix();
+    benchmark::DoNotOptimize(product);
+  }
+  Report(state, 2.0 * 64 + 2.0 * 64, 3.0 * 16 * sizeof(T));
+}
+
+template <typename T>
+void BM_SparseMulVector(benchmark::State &state) {
+  // Five entries per row at scattered columns.
+  const std::size_t n = state.range(0);
+  std::vector<typename S21SparseMatrix<T>::Triplet> triplets;
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t k = 0; k < 5; k++)
+      triplets.push_back({i, (i * 7919 + k * 104729) % n, T(k + 1)});
+  const S21SparseMatrix<T> a(n, n, triplets);
+  const std::vector<T> x(n, T(1));
+  for (auto _ : state) benchmark::DoNotOptimize(a.MulVector(x));
+  const double nnz = static_cast<double>(a.GetNonZeros());
+  Report(state, 2.0 * nnz,
+         nnz * (sizeof(T) + sizeof(std::size_t)) + 3.0 * n * sizeof(T));
+}
+
+#define S21_BENCH_SQUARE(name, type, low, high)            \
+  BENCHMARK_TEMPLATE(name, type)                           \
+      ->RangeMultiplier(4)                                 \
+      ->Range(low, high)                                   \
+      ->Unit(benchmark::kMicrosecond)
+
+S21_BENCH_SQUARE(BM_Construct, double, 16, 4096);
+S21_BENCH_SQUARE(BM_Copy, double, 16, 4096);
+S21_BENCH_SQUARE(BM_Move, double, 16, 16);
+
+S21_BENCH_SQUARE(BM_SumMatrix, double, 16, 4096);
+S21_BENCH_SQUARE(BM_SumMatrix, float, 16, 4096);
+S21_BENCH_SQUARE(BM_SumMatrix, std::int32_t, 16, 4096);
+S21_BENCH_SQUARE(BM_SubMatrix, double, 16, 4096);
+S21_BENCH_SQUARE(BM_MulNumber, double, 16, 4096);
+S21_BENCH_SQUARE(BM_MulNumber, float, 16, 4096);
+S21_BENCH_SQUARE(BM_EqMatrix, double, 16, 4096);
+S21_BENCH_SQUARE(BM_CompareUlp, double, 16, 4096);
+S21_BENCH_SQUARE(BM_Diff, double, 16, 4096);
+S21_BENCH_SQUARE(BM_Expression, double, 16, 4096);
+
+BENCHMARK_TEMPLATE(BM_MulMatrix, double)
+    ->Args({16, 16, 16})
+    ->Args({64, 64, 64})
+    ->Args({256, 256, 256})
+    ->Args({1024, 1024, 1024})
+    ->Args({1024, 16, 1024})
+    ->Args({16, 1024, 16})
+    ->Args({4096, 256, 64})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_MulMatrix, float)
+    ->Args({256, 256, 256})
+    ->Args({1024, 1024, 1024})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_GemmReference, double)
+    ->Args({256, 256, 256})
+    ->Args({1024, 1024, 1024})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_MulMatrixStrassen, double)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+S21_BENCH_SQUARE(BM_Gemv, double, 64, 4096);
+S21_BENCH_SQUARE(BM_Gemv, float, 64, 4096);
+S21_BENCH_SQUARE(BM_GemvT, double, 64, 4096);
+S21_BENCH_SQUARE(BM_MulMatrixColumn, double, 64, 4096);
+S21_BENCH_SQUARE(BM_Determinant, double, 4, 1024);
+S21_BENCH_SQUARE(BM_Determinant, float, 4, 1024);
+S21_BENCH_SQUARE(BM_MinorDeterminant, double, 4, 1024);
+S21_BENCH_SQUARE(BM_MinorViewDeterminant, double, 4, 1024);
+S21_BENCH_SQUARE(BM_InverseMatrix, double, 4, 1024);
+S21_BENCH_SQUARE(BM_SymmetricLU, double, 16, 1024);
+S21_BENCH_SQUARE(BM_Cholesky, double, 16, 1024);
+S21_BENCH_SQUARE(BM_LDLT, double, 16, 1024);
+
+BENCHMARK_TEMPLATE(BM_Solve, double)
+    ->Args({64, 1})
+    ->Args({1024, 1})
+    ->Args({1024, 1024})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SolveMixedPrecision, double)
+    ->Args({64, 1})
+    ->Args({1024, 1})
+    ->Args({1024, 1024})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_InverseThenMultiply, double)
+    ->Args({64, 1})
+    ->Args({1024, 1})
+    ->Args({1024, 1024})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_LUSolve, double)
+    ->Args({1024, 1})
+    ->Args({1024, 16})
+    ->Args({1024, 4096})
+    ->Unit(benchmark::kMicrosecond);
+S21_BENCH_SQUARE(BM_CalcComplements, double, 4, 256);
+
+BENCHMARK_TEMPLATE(BM_Transpose, double)
+    ->ArgsProduct({{64, 1024, 4096}, {64, 1024, 4096}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_TransposeInPlace, double)
+    ->ArgsProduct({{64, 1024, 4096}, {64, 1024, 4096}})
+    ->Unit(benchmark::kMicrosecond);
+S21_BENCH_SQUARE(BM_SetRowsCols, double, 16, 1024);
+
+BENCHMARK_TEMPLATE(BM_BatchMulMatrix, double)
+    ->ArgsProduct({{10000}, {2, 4, 8, 16}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BatchInverse, double)
+    ->ArgsProduct({{10000}, {2, 4, 8, 16}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FixedMulInverse, double);
+S21_BENCH_SQUARE(BM_SparseMulVector, double, 1024, 1048576);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,436 @@
+#ifndef S21_BATCH_HPP_
+#define S21_BATCH_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+#ifndef S21_BATCH_PARALLEL
+#define S21_BATCH_PARALLEL 1048576  // count * n^3 below which it is serial
+#endif
+
+namespace S21 {
+
+/// @brief A batch of same-shape matrices stored interleaved, so that SIMD
+/// lanes work on different matrices.
+/// @note Matrices are grouped in chunks of kLanes, one cache-line-sized
+/// vector of a chunk per element: element (i, j) of matrix b lives at
+/// `Data()[b / kLanes * ChunkSize() + (i * GetCols() + j) * kLanes +
+/// b % kLanes]`. Every operation walks the batch chunk by chunk, each one a
+/// contiguous block, with fixed-length inner loops over the lanes that the
+/// compiler turns into vector instructions, and spreads large batches over
+/// ThreadPool::Instance(). The count is padded to a whole number of chunks
+/// with zero matrices that never show up in results.
+/// @note Intended for many small matrices, e.g. 2x2 to 16x16, where
+/// per-object calls are dominated by allocation and loop overhead.
+/// @tparam T The type of the matrix elements; Determinant(), InverseMatrix()
+/// and Solve() require a floating-point type.
+template <typename T = double>
+class S21MatrixBatch {
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+ public:
+  using value_type = T;
+
+  /// @brief Number of matrices processed together by the inner loops.
+  static constexpr std::size_t kLanes = S21Matrix<T>::kAlignment / sizeof(T);
+
+  /// @brief Creates a batch of `count` zero matrices of rows x cols.
+  /// @param resource Memory resource the storage is allocated from.
+  S21MatrixBatch(std::size_t count, std::size_t rows, std::size_t cols,
+                 std::pmr::memory_resource *resource =
+                     std::pmr::get_default_resource());
+
+  std::size_t GetCount() const { return count_; }
+  std::size_t GetRows() const { return rows_; }
+  std::size_t GetCols() const { return cols_; }
+
+  /// @brief Gets the interleaved storage.
+  T *Data() { return storage_.Data(); }
+  const T *Data() const { return storage_.Data(); }
+
+  /// @brief Gets the number of elements in a chunk of kLanes matrices.
+  std::size_t ChunkSize() const { return rows_ * cols_ * kLanes; }
+
+  /// @brief Accesses element (row, col) of matrix `index`.
+  /// @throw std::out_of_range if an index is out of range.
+  T &operator()(std::size_t index, std::size_t row, std::size_t col);
+  const T &operator()(std::size_t index, std::size_t row,
+                      std::size_t col) const;
+
+  /// @brief Copies matrix `index` out of the batch.
+  /// @throw std::out_of_range if the index is out of range.
+  S21Matrix<T> Get(std::size_t index) const;
+
+  /// @brief Overwrites matrix `index` with `matrix`.
+  /// @throw std::out_of_range if the index is out of range.
+  /// @throw std::runtime_error if the shapes differ.
+  void Set(std::size_t index, const S21Matrix<T> &matrix);
+
+  /// @brief Adds the matrices of `other` to the matching ones of this batch.
+  /// @throw std::runtime_error if the counts or shapes differ.
+  void SumMatrix(const S21MatrixBatch &other);
+
+  /// @brief Subtracts the matrices of `other` from the matching ones.
+  /// @throw std::runtime_error if the counts or shapes differ.
+  void SubMatrix(const S21MatrixBatch &other);
+
+  /// @brief Multiplies every matrix by a scalar.
+  void MulNumber(T num);
+
+  /// @brief Replaces every matrix A[b] by A[b] * other[b].
+  /// @throw std::runtime_error if the counts differ or the shapes are
+  /// incompatible for multiplication.
+  void MulMatrix(const S21MatrixBatch &other);
+
+  /// @brief Calculates the determinant of every matrix.
+  /// @note From a per-matrix LU factorization with partial pivoting; a
+  /// matrix with a pivot below EPSILON has determinant zero.
+  /// @return One determinant per matrix.
+  /// @throw std::runtime_error if the matrices are not square.
+  std::vector<T> Determinant() const;
+
+  /// @brief Calculates the inverse of every matrix.
+  /// @throw std::runtime_error if the matrices are not square or one of
+  /// them is not invertible.
+  S21MatrixBatch InverseMatrix() const;
+
+  /// @brief Solves A[b] * X[b] = rhs[b] for every matrix.
+  /// @param rhs The right-hand sides, one batch entry per matrix.
+  /// @return The solutions with the shape of `rhs`.
+  /// @throw std::runtime_error if the shapes are incompatible or one of the
+  /// matrices is not invertible.
+  S21MatrixBatch Solve(const S21MatrixBatch &rhs) const;
+
+ private:
+  void CheckSameShape(const S21MatrixBatch &other) const;
+  void SolveInPlace(S21MatrixBatch &rhs) const;
+  std::size_t Chunks() const { return storage_.GetRows(); }
+  std::size_t Offset(std::size_t index, std::size_t row,
+                     std::size_t col) const {
+    return index / kLanes * ChunkSize() + (row * cols_ + col) * kLanes +
+           index % kLanes;
+  }
+  template <typename Body>
+  void ForEachChunk(std::size_t work, Body &&body) const;
+
+  std::size_t count_;
+  std::size_t rows_;
+  std::size_t cols_;
+  S21Matrix<T> storage_;  // One row per chunk
+};
+
+namespace detail {
+
+/// @brief y[l] -= a[l] * x[l] over one chunk of W lanes.
+/// @note Goes through a local array so that the compiler does not have to
+/// prove that `x` and `y` do not overlap before vectorizing.
+template <typename T, std::size_t W>
+void BatchAxpy(const T *a, const T *x, T *y) {
+  T result[W];
+  for (std::size_t l = 0; l < W; l++) result[l] = y[l] - a[l] * x[l];
+  std::copy_n(result, W, y);
+}
+
+/// @brief Factors kLanes interleaved n x n matrices in place, P A = L U for
+/// each lane, with partial pivoting chosen lane by lane.
+/// @param a Element (i, j) of lane l at `a[(i * n + j) * W + l]`.
+/// @param pivots Row exchanged with row k in lane l at `pivots[k * W + l]`.
+/// @param singular Set for every lane that meets a pivot below EPSILON;
+/// such lanes continue with a unit pivot, stored on the diagonal so that
+/// substitution stays finite, and their factors are meaningless.
+template <typename T, std::size_t W>
+void BatchFactor(std::size_t n, T *a, std::size_t *pivots, bool *singular) {
+  for (std::size_t l = 0; l < W; l++) singular[l] = false;
+  for (std::size_t k = 0; k < n; k++) {
+    std::size_t pivot[W];
+    T best[W];
+    T *diagonal = a + (k * n + k) * W;
+    for (std::size_t l = 0; l < W; l++) {
+      pivot[l] = k;
+      best[l] = std::abs(diagonal[l]);
+    }
+    for (std::size_t r = k + 1; r < n; r++) {
+      const T *candidate = a + (r * n + k) * W;
+      for (std::size_t l = 0; l < W; l++) {
+        const T magnitude = std::abs(candidate[l]);
+        pivot[l] = magnitude > best[l] ? r : pivot[l];
+        best[l] = magnitude > best[l] ? magnitude : best[l];
+      }
+    }
+    // Interchanges differ between lanes, so they are done one lane at a
+    // time; they cost O(n^2) per lane against O(n^3) for the elimination.
+    for (std::size_t l = 0; l < W; l++) {
+      pivots[k * W + l] = pivot[l];
+      if (best[l] < EPSILON) singular[l] = true;
+      if (pivot[l] == k) continue;
+      for (std::size_t j = 0; j < n; j++)
+        std::swap(a[(k * n + j) * W + l], a[(pivot[l] * n + j) * W + l]);
+    }
+
+    T inverse[W];
+    for (std::size_t l = 0; l < W; l++) {
+      if (best[l] < EPSILON) diagonal[l] = T(1);
+      inverse[l] = T(1) / diagonal[l];
+    }
+    const T *u_row = a + k * n * W;
+    for (std::size_t r = k + 1; r < n; r++) {
+      T *row = a + r * n * W;
+      T multiplier[W];
+      for (std::size_t l = 0; l < W; l++)
+        multiplier[l] = row[k * W + l] *= inverse[l];
+      for (std::size_t j = k + 1; j < n; j++)
+        BatchAxpy<T, W>(multiplier, u_row + j * W, row + j * W);
+    }
+  }
+}
+
+/// @brief Solves L U X = P B for kLanes interleaved systems factored by
+/// BatchFactor(), overwriting the n x m right-hand sides `b`.
+template <typename T, std::size_t W>
+void BatchSubstitute(std::size_t n, const T *a, const std::size_t *pivots,
+                     std::size_t m, T *b) {
+  for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t l = 0; l < W; l++) {
+      const std::size_t pivot = pivots[k * W + l];
+      if (pivot == k) continue;
+      for (std::size_t c = 0; c < m; c++)
+        std::swap(b[(k * m + c) * W + l], b[(pivot * m + c) * W + l]);
+    }
+  }
+  for (std::size_t i = 1; i < n; i++) {
+    for (std::size_t p = 0; p < i; p++) {
+      const T *l_ip = a + (i * n + p) * W;
+      for (std::size_t c = 0; c < m; c++)
+        BatchAxpy<T, W>(l_ip, b + (p * m + c) * W, b + (i * m + c) * W);
+    }
+  }
+  for (std::size_t i = n; i-- > 0;) {
+    for (std::size_t p = i + 1; p < n; p++) {
+      const T *u_ip = a + (i * n + p) * W;
+      for (std::size_t c = 0; c < m; c++)
+        BatchAxpy<T, W>(u_ip, b + (p * m + c) * W, b + (i * m + c) * W);
+    }
+    T inverse[W];
+    for (std::size_t l = 0; l < W; l++)
+      inverse[l] = T(1) / a[(i * n + i) * W + l];
+    for (std::size_t c = 0; c < m; c++) {
+      T scaled[W];
+      for (std::size_t l = 0; l < W; l++)
+        scaled[l] = b[(i * m + c) * W + l] * inverse[l];
+      std::copy_n(scaled, W, b + (i * m + c) * W);
+    }
+  }
+}
+
+}  // namespace detail
+
+template <typename T>
+S21MatrixBatch<T>::S21MatrixBatch(std::size_t count, std::size_t rows,
+                                  std::size_t cols,
+                                  std::pmr::memory_resource *resource)
+    : count_(count),
+      rows_(rows),
+      cols_(cols),
+      storage_((count + kLanes - 1) / kLanes, rows * cols * kLanes,
+               resource) {}
+
+template <typename T>
+T &S21MatrixBatch<T>::operator()(std::size_t index, std::size_t row,
+                                 std::size_t col) {
+  if (index >= count_ || row >= rows_ || col >= cols_)
+    throw std::out_of_range("Matrix, row or column index out of range");
+  return storage_.Data()[Offset(index, row, col)];
+}
+
+template <typename T>
+const T &S21MatrixBatch<T>::operator()(std::size_t index, std::size_t row,
+                                       std::size_t col) const {
+  if (index >= count_ || row >= rows_ || col >= cols_)
+    throw std::out_of_range("Matrix, row or column index out of range");
+  return storage_.Data()[Offset(index, row, col)];
+}
+
+template <typename T>
+S21Matrix<T> S21MatrixBatch<T>::Get(std::size_t index) const {
+  if (index >= count_) throw std::out_of_range("Matrix index out of range");
+  S21Matrix<T> result(rows_, cols_, storage_.GetResource());
+  for (std::size_t i = 0; i < rows_; i++)
+    for (std::size_t j = 0; j < cols_; j++)
+      result(i, j) = storage_.Data()[Offset(index, i, j)];
+  return result;
+}
+
+template <typename T>
+void S21MatrixBatch<T>::Set(std::size_t index, const S21Matrix<T> &matrix) {
+  if (index >= count_) throw std::out_of_range("Matrix index out of range");
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_)
+    throw std::runtime_error("Matrices dimensions are not equal");
+  for (std::size_t i = 0; i < rows_; i++)
+    for (std::size_t j = 0; j < cols_; j++)
+      storage_.Data()[Offset(index, i, j)] = matrix(i, j);
+}
+
+template <typename T>
+void S21MatrixBatch<T>::CheckSameShape(const S21MatrixBatch &other) const {
+  if (count_ != other.count_ || rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::runtime_error("Matrices dimensions are not equal");
+}
+
+template <typename T>
+template <typename Body>
+void S21MatrixBatch<T>::ForEachChunk(std::size_t work, Body &&body) const {
+  const std::size_t chunks = Chunks();
+  ThreadPool &pool = ThreadPool::Instance();
+  if (chunks * kLanes * work < S21_BATCH_PARALLEL ||
+      pool.GetThreadCount() == 1 || ThreadPool::IsSerialContext()) {
+    for (std::size_t chunk = 0; chunk < chunks; chunk++) body(chunk);
+    return;
+  }
+  // A few chunks per task keep the scheduling cost per matrix low.
+  const std::size_t tasks = std::min(chunks, 4 * pool.GetThreadCount());
+  const std::size_t per_task = (chunks + tasks - 1) / tasks;
+  pool.ParallelFor((chunks + per_task - 1) / per_task, [&](std::size_t task) {
+    const std::size_t last = std::min(chunks, (task + 1) * per_task);
+    for (std::size_t chunk = task * per_task; chunk < last; chunk++)
+      body(chunk);
+  });
+}
+
+template <typename T>
+void S21MatrixBatch<T>::SumMatrix(const S21MatrixBatch &other) {
+  CheckSameShape(other);
+  storage_.SumMatrix(other.storage_);
+}
+
+template <typename T>
+void S21MatrixBatch<T>::SubMatrix(const S21MatrixBatch &other) {
+  CheckSameShape(other);
+  storage_.SubMatrix(other.storage_);
+}
+
+template <typename T>
+void S21MatrixBatch<T>::MulNumber(T num) {
+  storage_.MulNumber(num);
+}
+
+template <typename T>
+void S21MatrixBatch<T>::MulMatrix(const S21MatrixBatch &other) {
+  if (count_ != other.count_ || cols_ != other.rows_)
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  const std::size_t m = rows_, k = cols_, n = other.cols_;
+  // A product of the same shape overwrites each chunk once it is computed,
+  // so only a chunk-sized buffer is needed.
+  const bool in_place = n == k && this != &other;
+  S21MatrixBatch result(in_place ? 0 : count_, m, n, storage_.GetResource());
+  ForEachChunk(m * n * k, [&](std::size_t chunk) {
+    thread_local detail::AlignedBuffer<T> work;
+    const T *a = Data() + chunk * ChunkSize();
+    const T *b = other.Data() + chunk * other.ChunkSize();
+    T *c = in_place ? work.Reserve(ChunkSize())
+                    : result.Data() + chunk * result.ChunkSize();
+    for (std::size_t i = 0; i < m; i++) {
+      for (std::size_t j = 0; j < n; j++) {
+        T sum[kLanes] = {};
+        for (std::size_t p = 0; p < k; p++) {
+          const T *a_ip = a + (i * k + p) * kLanes;
+          const T *b_pj = b + (p * n + j) * kLanes;
+          for (std::size_t l = 0; l < kLanes; l++) sum[l] += a_ip[l] * b_pj[l];
+        }
+        std::copy_n(sum, kLanes, c + (i * n + j) * kLanes);
+      }
+    }
+    if (in_place) std::copy_n(c, ChunkSize(), Data() + chunk * ChunkSize());
+  });
+  if (!in_place) *this = std::move(result);
+}
+
+template <typename T>
+std::vector<T> S21MatrixBatch<T>::Determinant() const {
+  static_assert(std::is_floating_point_v<T>,
+                "Determinant requires a floating-point type");
+  if (rows_ != cols_)
+    throw std::runtime_error("Matrices dimensions are not equal");
+  const std::size_t n = rows_;
+  std::vector<T> result(Chunks() * kLanes);
+  ForEachChunk(n * n * n, [&](std::size_t chunk) {
+    thread_local detail::AlignedBuffer<T> work;
+    thread_local detail::AlignedBuffer<std::size_t> pivots;
+    T *a = work.Reserve(ChunkSize());
+    std::size_t *p = pivots.Reserve(n * kLanes);
+    bool singular[kLanes];
+    std::copy_n(Data() + chunk * ChunkSize(), ChunkSize(), a);
+    detail::BatchFactor<T, kLanes>(n, a, p, singular);
+    T det[kLanes];
+    for (std::size_t l = 0; l < kLanes; l++) det[l] = T(1);
+    for (std::size_t k = 0; k < n; k++) {
+      for (std::size_t l = 0; l < kLanes; l++) {
+        det[l] *= a[(k * n + k) * kLanes + l];
+        if (p[k * kLanes + l] != k) det[l] = -det[l];
+      }
+    }
+    for (std::size_t l = 0; l < kLanes; l++)
+      result[chunk * kLanes + l] = singular[l] ? T(0) : det[l];
+  });
+  result.resize(count_);
+  return result;
+}
+
+template <typename T>
+S21MatrixBatch<T> S21MatrixBatch<T>::Solve(const S21MatrixBatch &rhs) const {
+  if (rows_ != cols_ || rhs.rows_ != rows_ || rhs.count_ != count_)
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for solving the system");
+  S21MatrixBatch result = rhs;
+  SolveInPlace(result);
+  return result;
+}
+
+template <typename T>
+void S21MatrixBatch<T>::SolveInPlace(S21MatrixBatch &result) const {
+  static_assert(std::is_floating_point_v<T>,
+                "Solve requires a floating-point type");
+  const std::size_t n = rows_, m = result.cols_;
+  std::vector<char> failed(Chunks(), 0);
+  ForEachChunk(n * n * (n + m), [&](std::size_t chunk) {
+    thread_local detail::AlignedBuffer<T> work;
+    thread_local detail::AlignedBuffer<std::size_t> pivots;
+    T *a = work.Reserve(ChunkSize());
+    std::size_t *p = pivots.Reserve(n * kLanes);
+    bool singular[kLanes];
+    std::copy_n(Data() + chunk * ChunkSize(), ChunkSize(), a);
+    detail::BatchFactor<T, kLanes>(n, a, p, singular);
+    for (std::size_t l = 0; l < kLanes && chunk * kLanes + l < count_; l++)
+      if (singular[l]) failed[chunk] = 1;
+    detail::BatchSubstitute<T, kLanes>(
+        n, a, p, m, result.Data() + chunk * result.ChunkSize());
+  });
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+    throw std::runtime_error("Matrix is not invertible");
+}
+
+template <typename T>
+S21MatrixBatch<T> S21MatrixBatch<T>::InverseMatrix() const {
+  if (rows_ != cols_)
+    throw std::runtime_error("Matrix must be square to be inverted");
+  S21MatrixBatch identity(count_, rows_, rows_, storage_.GetResource());
+  for (std::size_t chunk = 0; chunk < Chunks(); chunk++)
+    for (std::size_t i = 0; i < rows_; i++)
+      std::fill_n(identity.Data() + chunk * ChunkSize() + i * (rows_ + 1) *
+                                                           kLanes,
+                  kLanes, T(1));
+  SolveInPlace(identity);
+  return identity;
+}
+
+}  // namespace S21
+
+#endif  // S21_BATCH_HPP_
@@ -0,0 +1,298 @@
+#ifndef S21_COMPARE_HPP_
+#define S21_COMPARE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_simd.hpp"
+#include "s21_thread_pool.hpp"
+
+#ifndef S21_COMPARE_PARALLEL
+#define S21_COMPARE_PARALLEL 1048576  // Elements below which it is serial
+#endif
+
+#ifndef S21_COMPARE_BLOCK
+#define S21_COMPARE_BLOCK 65536  // Elements between two early-exit checks
+#endif
+
+/// @file
+/// @brief Approximate comparison of matrices and reports of where they
+/// differ.
+/// @note Compare() answers whether two matrices match within a tolerance.
+/// It runs the SIMD kernels of s21_simd.hpp, which stop at the first block
+/// with a mismatch. Large matrices are split into bands of rows across
+/// ThreadPool::Instance(), and every band stops once any of them has found
+/// a mismatch.
+/// @note Diff() reads every element and reports how many differ, the
+/// largest error and where it is, for logs of regression checks.
+
+namespace S21 {
+
+/// @brief How two elements are compared.
+enum class Comparison {
+  kAbsolute,  ///< |a - b| <= tolerance
+  kRelative,  ///< |a - b| <= tolerance * max(|a|, |b|)
+  kUlp,       ///< At most max_ulps representable values apart
+};
+
+/// @brief Settings of Compare() and Diff().
+struct CompareOptions {
+  Comparison mode = Comparison::kAbsolute;
+  /// @brief Tolerance of the absolute and relative modes. The default
+  /// matches EqMatrix(); it is truncated to 0 for integer elements.
+  double tolerance = EPSILON;
+  /// @brief Tolerance of the ULP mode. Integers are one ULP apart.
+  std::uint64_t max_ulps = 4;
+};
+
+/// @brief Result of Diff().
+struct MatrixDiff {
+  /// @brief Whether no element is out of tolerance.
+  bool equal = true;
+  /// @brief Number of elements out of tolerance.
+  std::size_t mismatches = 0;
+  /// @brief Largest error, in the unit of the mode: an absolute difference,
+  /// a relative one or a count of ULPs. Infinite where an element is NaN.
+  double max_error = 0.0;
+  /// @brief Row and column of the first element with the largest error.
+  std::size_t row = 0;
+  std::size_t col = 0;
+};
+
+/// @brief Prints a one-line summary of `diff`.
+inline std::ostream &operator<<(std::ostream &out, const MatrixDiff &diff) {
+  out << (diff.equal ? "equal" : "not equal") << ", " << diff.mismatches
+      << " mismatches, max error " << diff.max_error << " at ("
+      << diff.row << ", " << diff.col << ")";
+  return out;
+}
+
+namespace detail {
+
+/// @brief Gets the integer tolerance of `options`, absolute or in ULPs, as
+/// a T the SIMD kernels take.
+/// @return false if T cannot hold it.
+template <typename T>
+bool IntegerTolerance(const CompareOptions &options, T &limit) {
+  const long double value =
+      options.mode == Comparison::kUlp
+          ? static_cast<long double>(options.max_ulps)
+          : std::max<long double>(options.tolerance, 0.0L);
+  if (!(value <= std::numeric_limits<T>::max())) return false;  // Or NaN
+  limit = static_cast<T>(value);
+  return true;
+}
+
+/// @brief Checks one pair of elements with the mode of `options`, with
+/// the same arithmetic as the SIMD kernels.
+template <typename T>
+bool ElementMatches(T lhs, T rhs, const CompareOptions &options) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (options.mode == Comparison::kRelative)
+      return simd::detail::scalar::EqualRelative(
+          &lhs, &rhs, 1, static_cast<T>(options.tolerance));
+    if (options.mode == Comparison::kUlp)
+      return simd::detail::scalar::EqualUlp(&lhs, &rhs, 1, options.max_ulps);
+    return simd::detail::scalar::Equal(&lhs, &rhs, 1,
+                                       static_cast<T>(options.tolerance));
+  } else {
+    // Exact in the unsigned counterpart of T, whatever the signs.
+    const long double diff = simd::detail::scalar::AbsDiff(lhs, rhs);
+    if (options.mode == Comparison::kRelative) {
+      const long double a = lhs, b = rhs;
+      return diff <= options.tolerance * std::max(std::abs(a), std::abs(b));
+    }
+    if (options.mode == Comparison::kUlp)
+      return diff <= static_cast<long double>(options.max_ulps);
+    return diff <= options.tolerance;
+  }
+}
+
+/// @brief Checks `count` consecutive elements with the mode of `options`.
+template <typename T>
+bool ElementsMatch(const T *lhs, const T *rhs, std::size_t count,
+                   const CompareOptions &options) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (options.mode == Comparison::kRelative)
+      return simd::EqualRelative(lhs, rhs, count,
+                                 static_cast<T>(options.tolerance));
+    if (options.mode == Comparison::kUlp)
+      return simd::EqualUlp(lhs, rhs, count, options.max_ulps);
+    return simd::Equal(lhs, rhs, count, static_cast<T>(options.tolerance));
+  } else {
+    T limit;
+    if (options.mode != Comparison::kRelative &&
+        IntegerTolerance(options, limit))
+      return simd::Equal(lhs, rhs, count, limit);
+    for (std::size_t i = 0; i < count; i++)
+      if (!ElementMatches(lhs[i], rhs[i], options)) return false;
+    return true;
+  }
+}
+
+/// @brief Error between two elements in the unit of `mode`.
+template <typename T>
+double ElementError(T lhs, T rhs, Comparison mode) {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(lhs) || std::isnan(rhs)) return kInfinity;
+    if (mode == Comparison::kUlp)
+      return static_cast<double>(simd::UlpDistance(lhs, rhs));
+  }
+  const long double a = lhs, b = rhs;
+  if (mode == Comparison::kRelative) {
+    if (a == b) return 0.0;
+    // An infinity against any other value gives inf / inf.
+    const long double error =
+        std::abs(a - b) / std::max(std::abs(a), std::abs(b));
+    return std::isfinite(error) ? static_cast<double>(error) : kInfinity;
+  }
+  const long double diff = std::abs(a - b);
+  return std::isnan(diff) ? kInfinity : static_cast<double>(diff);
+}
+
+/// @brief Runs `body(first, last)` on bands of the rows [0, rows) of a
+/// comparison of `count` elements, in parallel once it is large enough.
+template <typename Body>
+void CompareParallelFor(std::size_t rows, std::size_t count, Body &&body) {
+  ThreadPool &pool = ThreadPool::Instance();
+  const std::size_t threads = pool.GetThreadCount();
+  if (count < S21_COMPARE_PARALLEL || threads == 1 || rows < 2 ||
+      ThreadPool::IsSerialContext())
+    return body(std::size_t(0), rows);
+  const std::size_t bands = std::min(rows, 4 * threads);
+  pool.ParallelFor(bands, [&](std::size_t band) {
+    body(rows * band / bands, rows * (band + 1) / bands);
+  });
+}
+
+template <typename T>
+bool CompareViews(S21MatrixView<const T> a, S21MatrixView<const T> b,
+                  const CompareOptions &options) {
+  if (a.GetRows() != b.GetRows() || a.GetCols() != b.GetCols()) return false;
+  const std::size_t rows = a.GetRows(), cols = a.GetCols();
+  if (rows * cols == 0) return true;
+  const bool dense = a.Stride() == cols && b.Stride() == cols;
+  // Rows [first, last), in one call when they are contiguous.
+  auto match = [&](std::size_t first, std::size_t last) {
+    if (dense)
+      return ElementsMatch(a.Data() + first * cols, b.Data() + first * cols,
+                           (last - first) * cols, options);
+    for (std::size_t i = first; i < last; i++)
+      if (!ElementsMatch(a.Data() + i * a.Stride(), b.Data() + i * b.Stride(),
+                         cols, options))
+        return false;
+    return true;
+  };
+
+  std::atomic<bool> equal(true);
+  const std::size_t step = std::max<std::size_t>(1, S21_COMPARE_BLOCK / cols);
+  CompareParallelFor(rows, rows * cols, [&](std::size_t first,
+                                            std::size_t last) {
+    for (std::size_t i = first;
+         i < last && equal.load(std::memory_order_relaxed); i += step) {
+      if (!match(i, std::min(i + step, last)))
+        equal.store(false, std::memory_order_relaxed);
+    }
+  });
+  return equal.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+MatrixDiff DiffViews(S21MatrixView<const T> a, S21MatrixView<const T> b,
+                     const CompareOptions &options) {
+  if (a.GetRows() != b.GetRows() || a.GetCols() != b.GetCols())
+    throw std::runtime_error("Matrices dimensions are not equal");
+  const std::size_t rows = a.GetRows(), cols = a.GetCols();
+  // One partial report per band. Ties between bands go to the first
+  // element in row order, whichever band finished first.
+  const std::size_t threads = ThreadPool::Instance().GetThreadCount();
+  std::vector<MatrixDiff> bands(4 * threads);
+  std::atomic<std::size_t> next(0);
+  CompareParallelFor(rows, rows * cols, [&](std::size_t first,
+                                            std::size_t last) {
+    MatrixDiff &diff = bands[next.fetch_add(1, std::memory_order_relaxed)];
+    for (std::size_t i = first; i < last; i++) {
+      const T *lhs = a.Data() + i * a.Stride();
+      const T *rhs = b.Data() + i * b.Stride();
+      for (std::size_t j = 0; j < cols; j++) {
+        if (!ElementMatches(lhs[j], rhs[j], options)) diff.mismatches++;
+        const double error = ElementError(lhs[j], rhs[j], options.mode);
+        if (error > diff.max_error) {
+          diff.max_error = error;
+          diff.row = i;
+          diff.col = j;
+        }
+      }
+    }
+  });
+
+  MatrixDiff result;
+  for (std::size_t band = 0; band < next.load(); band++) {
+    const MatrixDiff &diff = bands[band];
+    result.mismatches += diff.mismatches;
+    if (diff.max_error > result.max_error ||
+        (diff.max_error == result.max_error &&
+         (diff.row < result.row ||
+          (diff.row == result.row && diff.col < result.col)))) {
+      result.max_error = diff.max_error;
+      result.row = diff.row;
+      result.col = diff.col;
+    }
+  }
+  result.equal = result.mismatches == 0;
+  return result;
+}
+
+}  // namespace detail
+
+/// @brief Checks whether two matrices have the same shape and all their
+/// elements match within the tolerance of `options`.
+/// @note Stops at the first block with a mismatch, on every thread. NaN
+/// never matches, so a matrix holding NaN is not equal to itself.
+/// @param a A matrix, a view or an expression.
+/// @param b A matrix, a view or an expression of the same element type.
+/// @param options The comparison mode and its tolerance.
+/// @return false if the shapes differ.
+template <typename L, typename R>
+bool Compare(const MatrixExpression<L> &a, const MatrixExpression<R> &b,
+             const CompareOptions &options = CompareOptions()) {
+  using T = typename L::value_type;
+  static_assert(std::is_same_v<T, typename R::value_type>,
+                "Operands must have the same element type");
+  const auto &ma = detail::Materialize(a.Self());
+  const auto &mb = detail::Materialize(b.Self());
+  S21_INSTRUMENT(kEqMatrix, ma.GetRows() * ma.GetCols());
+  return detail::CompareViews<T>(ma, mb, options);
+}
+
+/// @brief Reports how two matrices of the same shape differ.
+/// @note Reads every element, with rows split across threads as in
+/// Compare(). The mismatches are the elements Compare() would reject.
+/// @param options The comparison mode, which sets the unit of the errors,
+/// and its tolerance.
+/// @throw std::runtime_error if the shapes differ.
+template <typename L, typename R>
+MatrixDiff Diff(const MatrixExpression<L> &a, const MatrixExpression<R> &b,
+                const CompareOptions &options = CompareOptions()) {
+  using T = typename L::value_type;
+  static_assert(std::is_same_v<T, typename R::value_type>,
+                "Operands must have the same element type");
+  const auto &ma = detail::Materialize(a.Self());
+  const auto &mb = detail::Materialize(b.Self());
+  S21_INSTRUMENT(kEqMatrix, ma.GetRows() * ma.GetCols());
+  return detail::DiffViews<T>(ma, mb, options);
+}
+
+}  // namespace S21
+
+#endif  // S21_COMPARE_HPP_
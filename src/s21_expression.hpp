@@ -0,0 +1,138 @@
+#ifndef S21_EXPRESSION_HPP_
+#define S21_EXPRESSION_HPP_
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+/// @file
+/// @brief Expression templates for lazy element-wise matrix arithmetic.
+/// @note `A + B * 2.0 - C` builds a small tree of nodes instead of three
+/// temporary matrices. Nothing is computed until the tree is assigned to an
+/// S21Matrix, which then fills its buffer in one fused pass.
+/// @note Nodes refer to their matrix operands, so an expression must not
+/// outlive them: assign it to an S21Matrix instead of keeping it in an
+/// `auto` variable.
+
+namespace S21 {
+
+template <typename T>
+class S21Matrix;
+
+/// @brief CRTP base of everything that can appear in a matrix expression.
+/// @note A model `E` provides `value_type`, `GetRows()`, `GetCols()` and an
+/// unchecked `Coeff(i, j)` that evaluates one element.
+template <typename Derived>
+class MatrixExpression {
+ public:
+  const Derived &Self() const { return static_cast<const Derived &>(*this); }
+};
+
+namespace detail {
+
+/// @brief Tells whether an operand is held by reference inside expression
+/// nodes. Matrices are; nodes are small and copied by value.
+template <typename E>
+struct StoredByReference : std::false_type {};
+
+template <typename T>
+struct StoredByReference<S21Matrix<T>> : std::true_type {};
+
+template <typename E>
+using ExpressionOperand =
+    std::conditional_t<StoredByReference<E>::value, const E &, const E>;
+
+struct AddOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) {
+    return lhs + rhs;
+  }
+};
+
+struct SubOp {
+  template <typename T>
+  static T Apply(T lhs, T rhs) {
+    return lhs - rhs;
+  }
+};
+
+}  // namespace detail
+
+/// @brief Element-wise combination of two expressions of the same shape.
+template <typename Op, typename L, typename R>
+class BinaryExpression : public MatrixExpression<BinaryExpression<Op, L, R>> {
+  static_assert(std::is_same_v<typename L::value_type, typename R::value_type>,
+                "Operands must have the same element type");
+
+ public:
+  using value_type = typename L::value_type;
+
+  BinaryExpression(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols())
+      throw std::runtime_error("Matrices dimensions are not equal");
+  }
+
+  std::size_t GetRows() const { return lhs_.GetRows(); }
+  std::size_t GetCols() const { return lhs_.GetCols(); }
+  value_type Coeff(std::size_t i, std::size_t j) const {
+    return Op::Apply(lhs_.Coeff(i, j), rhs_.Coeff(i, j));
+  }
+
+ private:
+  detail::ExpressionOperand<L> lhs_;
+  detail::ExpressionOperand<R> rhs_;
+};
+
+/// @brief An expression multiplied element by element by a scalar.
+template <typename E>
+class ScaledExpression : public MatrixExpression<ScaledExpression<E>> {
+ public:
+  using value_type = typename E::value_type;
+
+  ScaledExpression(const E &expr, value_type scalar)
+      : expr_(expr), scalar_(scalar) {}
+
+  std::size_t GetRows() const { return expr_.GetRows(); }
+  std::size_t GetCols() const { return expr_.GetCols(); }
+  value_type Coeff(std::size_t i, std::size_t j) const {
+    return expr_.Coeff(i, j) * scalar_;
+  }
+
+ private:
+  detail::ExpressionOperand<E> expr_;
+  value_type scalar_;
+};
+
+/// @brief Adds two matrix expressions lazily.
+/// @throw std::runtime_error if the shapes differ.
+template <typename L, typename R>
+BinaryExpression<detail::AddOp, L, R> operator+(
+    const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs) {
+  return BinaryExpression<detail::AddOp, L, R>(lhs.Self(), rhs.Self());
+}
+
+/// @brief Subtracts two matrix expressions lazily.
+/// @throw std::runtime_error if the shapes differ.
+template <typename L, typename R>
+BinaryExpression<detail::SubOp, L, R> operator-(
+    const MatrixExpression<L> &lhs, const MatrixExpression<R> &rhs) {
+  return BinaryExpression<detail::SubOp, L, R>(lhs.Self(), rhs.Self());
+}
+
+/// @brief Scales a matrix expression lazily.
+template <typename E>
+ScaledExpression<E> operator*(const MatrixExpression<E> &expr,
+                              typename E::value_type scalar) {
+  return ScaledExpression<E>(expr.Self(), scalar);
+}
+
+/// @brief Scales a matrix expression lazily.
+template <typename E>
+ScaledExpression<E> operator*(typename E::value_type scalar,
+                              const MatrixExpression<E> &expr) {
+  return ScaledExpression<E>(expr.Self(), scalar);
+}
+
+}  // namespace S21
+
+#endif  // S21_EXPRESSION_HPP_
@@ -0,0 +1,358 @@
+#ifndef S21_FIXED_MATRIX_HPP_
+#define S21_FIXED_MATRIX_HPP_
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_simd.hpp"
+
+namespace S21 {
+
+/// @brief A matrix whose dimensions are fixed at compile time.
+/// @note Elements live in a std::array inside the object, so creating,
+/// copying and destroying one never touches the heap, and every operation
+/// can be evaluated in constant expressions. Loops have compile-time trip
+/// counts; the product is expanded into one sum of products per element.
+/// @note Determinant() and InverseMatrix() use closed forms up to 4x4 and
+/// fall back to the LU factorization of S21Matrix above that.
+/// @tparam T The type of the matrix elements; must be arithmetic.
+/// @tparam Rows Number of rows.
+/// @tparam Cols Number of columns.
+template <typename T, std::size_t Rows, std::size_t Cols>
+class S21FixedMatrix {
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+  static_assert(Rows > 0 && Cols > 0, "Matrix dimensions must be > 0");
+
+ public:
+  using value_type = T;
+
+  /// @brief Creates a matrix of zeros.
+  constexpr S21FixedMatrix() : data_{} {}
+
+  /// @brief Creates a matrix from its elements in row-major order.
+  /// @throw std::length_error if the list does not hold Rows * Cols values.
+  constexpr S21FixedMatrix(std::initializer_list<T> values) : data_{} {
+    if (values.size() != Rows * Cols)
+      throw std::length_error("Initializer size does not match dimensions");
+    std::size_t index = 0;
+    for (T value : values) data_[index++] = value;
+  }
+
+  /// @brief Copies a dynamic matrix of the same shape.
+  /// @throw std::runtime_error if the dimensions differ.
+  explicit S21FixedMatrix(const S21Matrix<T> &matrix) : data_{} {
+    if (matrix.GetRows() != Rows || matrix.GetCols() != Cols)
+      throw std::runtime_error("Matrices dimensions are not equal");
+    for (std::size_t i = 0; i < Rows; i++)
+      for (std::size_t j = 0; j < Cols; j++)
+        data_[i * Cols + j] = matrix.Coeff(i, j);
+  }
+
+  /// @brief Creates the identity matrix.
+  static constexpr S21FixedMatrix Identity() {
+    static_assert(Rows == Cols, "Identity matrix must be square");
+    S21FixedMatrix result;
+    for (std::size_t i = 0; i < Rows; i++) result.data_[i * Cols + i] = T(1);
+    return result;
+  }
+
+  /// @brief Copies the matrix into a dynamically sized one.
+  S21Matrix<T> ToMatrix() const {
+    S21Matrix<T> result(Rows, Cols);
+    for (std::size_t i = 0; i < Rows; i++)
+      for (std::size_t j = 0; j < Cols; j++) result(i, j) = Coeff(i, j);
+    return result;
+  }
+
+  static constexpr std::size_t GetRows() { return Rows; }
+  static constexpr std::size_t GetCols() { return Cols; }
+
+  constexpr T *Data() { return data_.data(); }
+  constexpr const T *Data() const { return data_.data(); }
+
+  /// @brief Accesses an element.
+  /// @throw std::out_of_range if the indices are out of range.
+  constexpr T &operator()(std::size_t row, std::size_t col) {
+    if (row >= Rows || col >= Cols)
+      throw std::out_of_range("Row or column index out of range");
+    return data_[row * Cols + col];
+  }
+
+  constexpr const T &operator()(std::size_t row, std::size_t col) const {
+    if (row >= Rows || col >= Cols)
+      throw std::out_of_range("Row or column index out of range");
+    return data_[row * Cols + col];
+  }
+
+  /// @brief Reads an element without bounds checking.
+  constexpr T Coeff(std::size_t row, std::size_t col) const {
+    return data_[row * Cols + col];
+  }
+
+  /// @brief Compares with the same tolerance as S21Matrix::EqMatrix().
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const {
+    for (std::size_t i = 0; i < Rows * Cols; i++) {
+      if (!simd::detail::scalar::Close(data_[i], other.data_[i],
+                                       static_cast<T>(EPSILON)))
+        return false;
+    }
+    return true;
+  }
+
+  constexpr void SumMatrix(const S21FixedMatrix &other) {
+    for (std::size_t i = 0; i < Rows * Cols; i++) data_[i] += other.data_[i];
+  }
+
+  constexpr void SubMatrix(const S21FixedMatrix &other) {
+    for (std::size_t i = 0; i < Rows * Cols; i++) data_[i] -= other.data_[i];
+  }
+
+  constexpr void MulNumber(T num) {
+    for (std::size_t i = 0; i < Rows * Cols; i++) data_[i] *= num;
+  }
+
+  /// @brief Multiplies by a square matrix, keeping the shape.
+  constexpr void MulMatrix(const S21FixedMatrix<T, Cols, Cols> &other) {
+    *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<T, Cols, Rows> Transpose() const {
+    S21FixedMatrix<T, Cols, Rows> result;
+    for (std::size_t i = 0; i < Rows; i++)
+      for (std::size_t j = 0; j < Cols; j++)
+        result.Data()[j * Rows + i] = data_[i * Cols + j];
+    return result;
+  }
+
+  /// @brief Calculates the determinant.
+  /// @note Closed form up to 4x4: cofactor expansion along the first row for
+  /// 3x3, and for 4x4 the Laplace expansion over the 2x2 minors of the top
+  /// and bottom row pairs.
+  constexpr T Determinant() const;
+
+  /// @brief Calculates the inverse.
+  /// @note Closed form up to 4x4: the adjugate divided by the determinant.
+  /// The matrix counts as singular when elimination with partial pivoting
+  /// meets a pivot below EPSILON in magnitude, as in
+  /// S21Matrix::InverseMatrix().
+  /// @throw std::runtime_error if the matrix is not invertible.
+  constexpr S21FixedMatrix InverseMatrix() const;
+
+  constexpr bool operator==(const S21FixedMatrix &other) const {
+    return EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &other) {
+    SumMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &other) {
+    SubMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix &operator*=(T num) {
+    MulNumber(num);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix &operator*=(
+      const S21FixedMatrix<T, Cols, Cols> &other) {
+    MulMatrix(other);
+    return *this;
+  }
+
+ private:
+  std::array<T, Rows * Cols> data_;
+};
+
+namespace detail {
+
+/// @brief Element (I, J) of a * b as a single expanded sum of products.
+template <std::size_t I, std::size_t J, typename T, std::size_t M,
+          std::size_t K, std::size_t N, std::size_t... P>
+constexpr T FixedDot(const S21FixedMatrix<T, M, K> &a,
+                     const S21FixedMatrix<T, K, N> &b,
+                     std::index_sequence<P...>) {
+  return ((a.Coeff(I, P) * b.Coeff(P, J)) + ...);
+}
+
+template <typename T, std::size_t M, std::size_t K, std::size_t N,
+          std::size_t... Index>
+constexpr S21FixedMatrix<T, M, N> FixedProduct(
+    const S21FixedMatrix<T, M, K> &a, const S21FixedMatrix<T, K, N> &b,
+    std::index_sequence<Index...>) {
+  S21FixedMatrix<T, M, N> result;
+  ((result.Data()[Index] =
+        FixedDot<Index / N, Index % N>(a, b, std::make_index_sequence<K>())),
+   ...);
+  return result;
+}
+
+/// @brief Checks whether Gaussian elimination with partial pivoting meets
+/// a pivot below EPSILON in magnitude, the test of the LU path.
+template <typename T, std::size_t N>
+constexpr bool FixedSingular(std::array<T, N * N> m) {
+  for (std::size_t k = 0; k < N; k++) {
+    std::size_t pivot = k;
+    T largest = m[k * N + k] < T(0) ? -m[k * N + k] : m[k * N + k];
+    for (std::size_t i = k + 1; i < N; i++) {
+      const T value = m[i * N + k] < T(0) ? -m[i * N + k] : m[i * N + k];
+      if (value > largest) {
+        pivot = i;
+        largest = value;
+      }
+    }
+    if (largest < EPSILON) return true;
+    for (std::size_t j = k; j < N; j++) {
+      const T temp = m[k * N + j];
+      m[k * N + j] = m[pivot * N + j];
+      m[pivot * N + j] = temp;
+    }
+    for (std::size_t i = k + 1; i < N; i++) {
+      const T multiplier = m[i * N + k] / m[k * N + k];
+      for (std::size_t j = k + 1; j < N; j++)
+        m[i * N + j] -= multiplier * m[k * N + j];
+    }
+  }
+  return false;
+}
+
+}  // namespace detail
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+constexpr T S21FixedMatrix<T, Rows, Cols>::Determinant() const {
+  static_assert(Rows == Cols, "Determinant requires a square matrix");
+  const auto &m = data_;
+  if constexpr (Rows == 1) {
+    return m[0];
+  } else if constexpr (Rows == 2) {
+    return m[0] * m[3] - m[1] * m[2];
+  } else if constexpr (Rows == 3) {
+    return m[0] * (m[4] * m[8] - m[5] * m[7]) -
+           m[1] * (m[3] * m[8] - m[5] * m[6]) +
+           m[2] * (m[3] * m[7] - m[4] * m[6]);
+  } else if constexpr (Rows == 4) {
+    const T s0 = m[0] * m[5] - m[4] * m[1], s1 = m[0] * m[6] - m[4] * m[2];
+    const T s2 = m[0] * m[7] - m[4] * m[3], s3 = m[1] * m[6] - m[5] * m[2];
+    const T s4 = m[1] * m[7] - m[5] * m[3], s5 = m[2] * m[7] - m[6] * m[3];
+    const T c5 = m[10] * m[15] - m[14] * m[11];
+    const T c4 = m[9] * m[15] - m[13] * m[11];
+    const T c3 = m[9] * m[14] - m[13] * m[10];
+    const T c2 = m[8] * m[15] - m[12] * m[11];
+    const T c1 = m[8] * m[14] - m[12] * m[10];
+    const T c0 = m[8] * m[13] - m[12] * m[9];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  } else {
+    return ToMatrix().Determinant();
+  }
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+constexpr S21FixedMatrix<T, Rows, Cols>
+S21FixedMatrix<T, Rows, Cols>::InverseMatrix() const {
+  static_assert(Rows == Cols, "Inverse requires a square matrix");
+  static_assert(std::is_floating_point_v<T>,
+                "Inverse requires a floating-point type");
+  if constexpr (Rows <= 4) {
+    if (detail::FixedSingular<T, Rows>(data_))
+      throw std::runtime_error("Matrix is not invertible");
+    const T det = Determinant();
+    const T inv = T(1) / det;
+    const auto &m = data_;
+    S21FixedMatrix result;
+    T *r = result.Data();
+    if constexpr (Rows == 1) {
+      r[0] = inv;
+    } else if constexpr (Rows == 2) {
+      r[0] = m[3] * inv;
+      r[1] = -m[1] * inv;
+      r[2] = -m[2] * inv;
+      r[3] = m[0] * inv;
+    } else if constexpr (Rows == 3) {
+      r[0] = (m[4] * m[8] - m[5] * m[7]) * inv;
+      r[1] = (m[2] * m[7] - m[1] * m[8]) * inv;
+      r[2] = (m[1] * m[5] - m[2] * m[4]) * inv;
+      r[3] = (m[5] * m[6] - m[3] * m[8]) * inv;
+      r[4] = (m[0] * m[8] - m[2] * m[6]) * inv;
+      r[5] = (m[2] * m[3] - m[0] * m[5]) * inv;
+      r[6] = (m[3] * m[7] - m[4] * m[6]) * inv;
+      r[7] = (m[1] * m[6] - m[0] * m[7]) * inv;
+      r[8] = (m[0] * m[4] - m[1] * m[3]) * inv;
+    } else {
+      const T s0 = m[0] * m[5] - m[4] * m[1], s1 = m[0] * m[6] - m[4] * m[2];
+      const T s2 = m[0] * m[7] - m[4] * m[3], s3 = m[1] * m[6] - m[5] * m[2];
+      const T s4 = m[1] * m[7] - m[5] * m[3], s5 = m[2] * m[7] - m[6] * m[3];
+      const T c5 = m[10] * m[15] - m[14] * m[11];
+      const T c4 = m[9] * m[15] - m[13] * m[11];
+      const T c3 = m[9] * m[14] - m[13] * m[10];
+      const T c2 = m[8] * m[15] - m[12] * m[11];
+      const T c1 = m[8] * m[14] - m[12] * m[10];
+      const T c0 = m[8] * m[13] - m[12] * m[9];
+      r[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * inv;
+      r[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * inv;
+      r[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * inv;
+      r[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * inv;
+      r[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * inv;
+      r[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * inv;
+      r[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * inv;
+      r[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * inv;
+      r[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * inv;
+      r[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * inv;
+      r[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * inv;
+      r[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * inv;
+      r[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * inv;
+      r[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * inv;
+      r[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * inv;
+      r[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * inv;
+    }
+    return result;
+  } else {
+    return S21FixedMatrix(ToMatrix().InverseMatrix());
+  }
+}
+
+/// @brief Multiplies two fixed-size matrices with compatible shapes.
+template <typename T, std::size_t M, std::size_t K, std::size_t N>
+constexpr S21FixedMatrix<T, M, N> operator*(const S21FixedMatrix<T, M, K> &a,
+                                            const S21FixedMatrix<T, K, N> &b) {
+  return detail::FixedProduct(a, b, std::make_index_sequence<M * N>());
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator+(
+    S21FixedMatrix<T, Rows, Cols> lhs,
+    const S21FixedMatrix<T, Rows, Cols> &rhs) {
+  return lhs += rhs;
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator-(
+    S21FixedMatrix<T, Rows, Cols> lhs,
+    const S21FixedMatrix<T, Rows, Cols> &rhs) {
+  return lhs -= rhs;
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator*(
+    S21FixedMatrix<T, Rows, Cols> matrix,
+    typename S21FixedMatrix<T, Rows, Cols>::value_type num) {
+  return matrix *= num;
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+constexpr S21FixedMatrix<T, Rows, Cols> operator*(
+    typename S21FixedMatrix<T, Rows, Cols>::value_type num,
+    S21FixedMatrix<T, Rows, Cols> matrix) {
+  return matrix *= num;
+}
+
+}  // namespace S21
+
+#endif  // S21_FIXED_MATRIX_HPP_
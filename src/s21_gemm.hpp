@@ -0,0 +1,294 @@
+#ifndef S21_GEMM_HPP_
+#define S21_GEMM_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#include "s21_thread_pool.hpp"
+
+/// @file
+/// @brief Packed, cache-blocked general matrix multiply used by S21Matrix.
+/// @note The blocking follows the usual GotoBLAS/BLIS scheme: B is packed
+/// into KC x NC panels that stay in L3, A into MC x KC blocks that stay in
+/// L2, and a MR x NR register tile of C is accumulated by the micro-kernel
+/// while streaming KC columns of A and rows of B from L1.
+/// @note Every tile size can be overridden at build time, e.g.
+/// `-DS21_GEMM_KC=384 -DS21_GEMM_NR=12`.
+
+#ifndef S21_GEMM_MR
+#define S21_GEMM_MR 4
+#endif
+
+#ifndef S21_GEMM_NR
+#define S21_GEMM_NR 0  // 0 selects two 256-bit vectors worth of T
+#endif
+
+#ifndef S21_GEMM_KC
+#define S21_GEMM_KC 256
+#endif
+
+#ifndef S21_GEMM_MC
+#define S21_GEMM_MC 96
+#endif
+
+#ifndef S21_GEMM_NC
+#define S21_GEMM_NC 4096
+#endif
+
+#ifndef S21_GEMM_SMALL
+#define S21_GEMM_SMALL 32768  // m * n * k below which packing does not pay
+#endif
+
+#ifndef S21_GEMM_PARALLEL
+#define S21_GEMM_PARALLEL 2097152  // m * n * k below which one thread is used
+#endif
+
+namespace S21 {
+namespace detail {
+
+/// @brief Tile sizes of the blocked GEMM for element type T.
+template <typename T>
+struct GemmBlocking {
+  static constexpr std::size_t kMr = S21_GEMM_MR;
+  static constexpr std::size_t kNr =
+      S21_GEMM_NR ? S21_GEMM_NR
+                  : std::max<std::size_t>(
+                        4, std::min<std::size_t>(16, 64 / sizeof(T)));
+  static constexpr std::size_t kKc = S21_GEMM_KC;
+  // MC and NC are rounded so that only the last block has partial panels.
+  static constexpr std::size_t kMc = (S21_GEMM_MC + kMr - 1) / kMr * kMr;
+  static constexpr std::size_t kNc = (S21_GEMM_NC + kNr - 1) / kNr * kNr;
+
+  static_assert(kMr > 0 && kKc > 0 && kMc > 0 && kNc > 0,
+                "GEMM tile sizes must be positive");
+};
+
+/// @brief Growable, cache-line aligned scratch buffer.
+/// @note One instance per thread holds the packed panels, so repeated
+/// multiplications do not allocate once the buffer has grown large enough.
+template <typename T>
+class AlignedBuffer {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  AlignedBuffer() = default;
+  AlignedBuffer(const AlignedBuffer &) = delete;
+  AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+  ~AlignedBuffer() { Release(); }
+
+  T *Reserve(std::size_t count) {
+    if (count > capacity_) {
+      Release();
+      data_ = static_cast<T *>(
+          ::operator new(count * sizeof(T), std::align_val_t{kAlignment}));
+      capacity_ = count;
+    }
+    return data_;
+  }
+
+ private:
+  void Release() noexcept {
+    if (data_) ::operator delete(data_, std::align_val_t{kAlignment});
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  T *data_ = nullptr;
+  std::size_t capacity_ = 0;
+};
+
+/// @brief Straightforward row-major multiply, C = alpha * A * B + beta * C.
+/// @note Loop order i-k-j keeps every inner access unit-stride. Used for
+/// small products where packing costs more than it saves, and as the
+/// reference the blocked kernel is checked and benchmarked against.
+template <typename T>
+void GemmReference(std::size_t m, std::size_t n, std::size_t k, T alpha,
+                   const T *a, std::size_t lda, const T *b, std::size_t ldb,
+                   T beta, T *c, std::size_t ldc) {
+  for (std::size_t i = 0; i < m; i++) {
+    T *c_row = c + i * ldc;
+    if (beta == T(0))
+      std::fill_n(c_row, n, T(0));
+    else if (beta != T(1))
+      for (std::size_t j = 0; j < n; j++) c_row[j] *= beta;
+    for (std::size_t p = 0; p < k; p++) {
+      const T a_ip = alpha * a[i * lda + p];
+      const T *b_row = b + p * ldb;
+      for (std::size_t j = 0; j < n; j++) c_row[j] += a_ip * b_row[j];
+    }
+  }
+}
+
+/// @brief Packs an mc x kc block of A into MR-row panels.
+/// @note Inside a panel the MR values of one column are adjacent, so the
+/// micro-kernel reads A with unit stride. Rows past mc are zero-filled.
+template <typename T>
+void PackA(std::size_t mc, std::size_t kc, const T *a, std::size_t lda,
+           T *packed) {
+  constexpr std::size_t kMr = GemmBlocking<T>::kMr;
+  for (std::size_t ir = 0; ir < mc; ir += kMr) {
+    const std::size_t mr = std::min(kMr, mc - ir);
+    for (std::size_t p = 0; p < kc; p++) {
+      for (std::size_t i = 0; i < mr; i++)
+        packed[i] = a[(ir + i) * lda + p];
+      for (std::size_t i = mr; i < kMr; i++) packed[i] = T(0);
+      packed += kMr;
+    }
+  }
+}
+
+/// @brief Packs a kc x nc block of B into NR-column panels.
+/// @note Inside a panel the NR values of one row are adjacent. Columns past
+/// nc are zero-filled.
+template <typename T>
+void PackB(std::size_t kc, std::size_t nc, const T *b, std::size_t ldb,
+           T *packed) {
+  constexpr std::size_t kNr = GemmBlocking<T>::kNr;
+  for (std::size_t jr = 0; jr < nc; jr += kNr) {
+    const std::size_t nr = std::min(kNr, nc - jr);
+    for (std::size_t p = 0; p < kc; p++) {
+      const T *b_row = b + p * ldb + jr;
+      for (std::size_t j = 0; j < nr; j++) packed[j] = b_row[j];
+      for (std::size_t j = nr; j < kNr; j++) packed[j] = T(0);
+      packed += kNr;
+    }
+  }
+}
+
+/// @brief Register-tile kernel: C[mr x nr] = alpha * Ap * Bp + beta * C.
+/// @note The accumulator is a fixed MR x NR array with compile-time bounds,
+/// which the compiler keeps in vector registers; only the valid mr x nr
+/// corner is written back.
+template <typename T>
+void GemmMicroKernel(std::size_t kc, const T *a_panel, const T *b_panel,
+                     T alpha, T beta, T *c, std::size_t ldc, std::size_t mr,
+                     std::size_t nr) {
+  constexpr std::size_t kMr = GemmBlocking<T>::kMr;
+  constexpr std::size_t kNr = GemmBlocking<T>::kNr;
+  T acc[kMr][kNr] = {};
+  for (std::size_t p = 0; p < kc; p++) {
+    for (std::size_t i = 0; i < kMr; i++) {
+      const T a_ip = a_panel[i];
+      for (std::size_t j = 0; j < kNr; j++) acc[i][j] += a_ip * b_panel[j];
+    }
+    a_panel += kMr;
+    b_panel += kNr;
+  }
+  for (std::size_t i = 0; i < mr; i++) {
+    T *c_row = c + i * ldc;
+    if (beta == T(0)) {
+      for (std::size_t j = 0; j < nr; j++) c_row[j] = alpha * acc[i][j];
+    } else {
+      for (std::size_t j = 0; j < nr; j++)
+        c_row[j] = alpha * acc[i][j] + beta * c_row[j];
+    }
+  }
+}
+
+/// @brief Blocked row-major multiply, C = alpha * A * B + beta * C.
+/// @note A is m x k with leading dimension lda, B is k x n with ldb and C is
+/// m x n with ldc. C must not overlap A or B. When beta is zero C is not
+/// read, so it may hold uninitialized values.
+template <typename T>
+void GemmBlocked(std::size_t m, std::size_t n, std::size_t k, T alpha,
+                 const T *a, std::size_t lda, const T *b, std::size_t ldb,
+                 T beta, T *c, std::size_t ldc) {
+  using Blocking = GemmBlocking<T>;
+  thread_local AlignedBuffer<T> a_buffer;
+  thread_local AlignedBuffer<T> b_buffer;
+  T *a_packed = a_buffer.Reserve(Blocking::kMc * Blocking::kKc);
+  T *b_packed = b_buffer.Reserve(
+      Blocking::kKc * std::min(Blocking::kNc,
+                               (n + Blocking::kNr - 1) / Blocking::kNr *
+                                   Blocking::kNr));
+
+  for (std::size_t jc = 0; jc < n; jc += Blocking::kNc) {
+    const std::size_t nc = std::min(Blocking::kNc, n - jc);
+    for (std::size_t pc = 0; pc < k; pc += Blocking::kKc) {
+      const std::size_t kc = std::min(Blocking::kKc, k - pc);
+      const T beta_block = pc == 0 ? beta : T(1);
+      PackB(kc, nc, b + pc * ldb + jc, ldb, b_packed);
+      for (std::size_t ic = 0; ic < m; ic += Blocking::kMc) {
+        const std::size_t mc = std::min(Blocking::kMc, m - ic);
+        PackA(mc, kc, a + ic * lda + pc, lda, a_packed);
+        for (std::size_t jr = 0; jr < nc; jr += Blocking::kNr) {
+          const std::size_t nr = std::min(Blocking::kNr, nc - jr);
+          for (std::size_t ir = 0; ir < mc; ir += Blocking::kMr) {
+            const std::size_t mr = std::min(Blocking::kMr, mc - ir);
+            GemmMicroKernel(kc, a_packed + ir * kc, b_packed + jr * kc, alpha,
+                            beta_block, c + (ic + ir) * ldc + jc + jr, ldc, mr,
+                            nr);
+          }
+        }
+      }
+    }
+  }
+}
+
+/// @brief Blocked multiply with C split into 2D tiles run on the pool.
+/// @note Tiles are whole multiples of the register tile, and there are
+/// about four per thread so that work stealing can even out the load. Each
+/// tile is an independent GemmBlocked() call using its thread's own packing
+/// buffers.
+template <typename T>
+void GemmParallel(ThreadPool &pool, std::size_t m, std::size_t n,
+                  std::size_t k, T alpha, const T *a, std::size_t lda,
+                  const T *b, std::size_t ldb, T beta, T *c, std::size_t ldc) {
+  using Blocking = GemmBlocking<T>;
+  const std::size_t wanted = 4 * pool.GetThreadCount();
+  std::size_t tile_m = (m + Blocking::kMr - 1) / Blocking::kMr * Blocking::kMr;
+  std::size_t tile_n = (n + Blocking::kNr - 1) / Blocking::kNr * Blocking::kNr;
+  auto tiles = [&] {
+    return ((m + tile_m - 1) / tile_m) * ((n + tile_n - 1) / tile_n);
+  };
+  while (tiles() < wanted) {
+    const bool split_m = tile_m >= tile_n && tile_m >= 8 * Blocking::kMr;
+    const bool split_n = !split_m && tile_n >= 8 * Blocking::kNr;
+    if (split_m)
+      tile_m = (tile_m / 2 + Blocking::kMr - 1) / Blocking::kMr * Blocking::kMr;
+    else if (split_n)
+      tile_n = (tile_n / 2 + Blocking::kNr - 1) / Blocking::kNr * Blocking::kNr;
+    else
+      break;
+  }
+
+  const std::size_t tiles_n = (n + tile_n - 1) / tile_n;
+  pool.ParallelFor(tiles(), [&](std::size_t tile) {
+    const std::size_t i0 = tile / tiles_n * tile_m;
+    const std::size_t j0 = tile % tiles_n * tile_n;
+    GemmBlocked(std::min(tile_m, m - i0), std::min(tile_n, n - j0), k, alpha,
+                a + i0 * lda, lda, b + j0, ldb, beta, c + i0 * ldc + j0, ldc);
+  });
+}
+
+/// @brief Row-major multiply, C = alpha * A * B + beta * C.
+/// @note Dispatches to the reference loop for small products, to the
+/// packed, blocked kernel for medium ones and to its tiled multithreaded
+/// form on ThreadPool::Instance() for large ones. Operand requirements are
+/// those of GemmBlocked().
+template <typename T>
+void Gemm(std::size_t m, std::size_t n, std::size_t k, T alpha, const T *a,
+          std::size_t lda, const T *b, std::size_t ldb, T beta, T *c,
+          std::size_t ldc) {
+  if (m == 0 || n == 0) return;
+  if (k == 0 || alpha == T(0)) {
+    GemmReference<T>(m, n, 0, alpha, a, lda, b, ldb, beta, c, ldc);
+  } else if (m * n * k < S21_GEMM_SMALL) {
+    GemmReference(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+  } else if (m * n * k < S21_GEMM_PARALLEL ||
+             ThreadPool::IsSerialContext()) {
+    GemmBlocked(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+  } else {
+    ThreadPool &pool = ThreadPool::Instance();
+    if (pool.GetThreadCount() == 1)
+      GemmBlocked(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    else
+      GemmParallel(pool, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+  }
+}
+
+}  // namespace detail
+}  // namespace S21
+
+#endif  // S21_GEMM_HPP_
@@ -0,0 +1,295 @@
+#ifndef S21_INSTRUMENTATION_HPP_
+#define S21_INSTRUMENTATION_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+/// @file
+/// @brief Opt-in accounting of the time and memory S21Matrix operations use.
+/// @note Compiled in only when S21_INSTRUMENTATION is defined, e.g. with
+/// `make test S21_INSTRUMENTATION=true`; otherwise the recording hooks
+/// expand to nothing and the functions below report zeros. The macro must
+/// be the same in every translation unit of a program.
+/// @note Each public call of an instrumented operation counts once, for its
+/// wall time, a nominal flop count and the matrix buffers it allocates.
+/// Operations it calls internally are part of it: InverseMatrix() is not
+/// also counted as a copy. Buffers allocated outside any operation, such as
+/// a matrix constructed with dimensions, are counted under kConstruct.
+/// @note Counters are shared by all threads. Buffers allocated on the
+/// threads of ThreadPool count under kConstruct.
+
+namespace S21 {
+
+/// @brief The operations that are accounted separately.
+enum class Operation : std::uint8_t {
+  kConstruct,          ///< Matrices constructed with dimensions
+  kCopy,               ///< Copy construction and copy assignment
+  kEvaluate,           ///< Assignment and construction from an expression
+  kEqMatrix,           ///< EqMatrix() and operator==
+  kSumMatrix,          ///< SumMatrix() and += of a matrix
+  kSubMatrix,          ///< SubMatrix() and -= of a matrix
+  kMulNumber,          ///< MulNumber() and *= of a scalar
+  kMulMatrix,          ///< MulMatrix() and *= of a matrix
+  kProduct,            ///< The product `a * b` into a new matrix
+  kMulMatrixStrassen,  ///< MulMatrixStrassen()
+  kGemv,               ///< Gemv() and the product of a matrix and a vector
+  kGemvT,              ///< GemvT()
+  kGemm,               ///< Gemm() into a view
+  kSolve,              ///< Solve() and LU::Solve()
+  kTriangularSolve,    ///< TriangularSolve()
+  kTranspose,          ///< Transpose()
+  kTransposeInPlace,   ///< TransposeInPlace()
+  kCalcComplements,    ///< CalcComplements()
+  kDeterminant,        ///< Determinant()
+  kInverseMatrix,      ///< InverseMatrix()
+  kInvertMatrix,       ///< InvertMatrix()
+  kSetRows,            ///< SetRows()
+  kSetCols,            ///< SetCols()
+  kGetMinor,           ///< GetMinor()
+  kCount               ///< Number of operations, not an operation
+};
+
+/// @brief Number of accounted operations.
+inline constexpr std::size_t kOperationCount =
+    static_cast<std::size_t>(Operation::kCount);
+
+/// @brief Whether this build records anything.
+#ifdef S21_INSTRUMENTATION
+inline constexpr bool kInstrumentationEnabled = true;
+#else
+inline constexpr bool kInstrumentationEnabled = false;
+#endif
+
+/// @brief Totals of one operation, or the figures of a single call.
+struct OperationStats {
+  std::uint64_t calls = 0;
+  std::uint64_t nanoseconds = 0;  ///< Wall time
+  std::uint64_t flops = 0;        ///< Nominal floating-point operations
+  std::uint64_t bytes_allocated = 0;
+  /// @brief Matrix buffers allocated: the results and scratch copies.
+  /// @note `a * b` allocates one more than `a *= b` would with the result
+  /// assigned back to `a`, which is where these counts point.
+  std::uint64_t temporaries = 0;
+};
+
+/// @brief Totals of every operation since the start or the last reset.
+struct InstrumentationSnapshot {
+  std::array<OperationStats, kOperationCount> operations{};
+
+  const OperationStats &operator[](Operation op) const {
+    return operations[static_cast<std::size_t>(op)];
+  }
+
+  /// @brief Sums the totals of all operations.
+  OperationStats Total() const;
+};
+
+/// @brief Called after every instrumented call with the figures of that
+/// call alone, on the thread that made it.
+/// @note It runs while an exception may be propagating and must not throw.
+using InstrumentationCallback =
+    std::function<void(Operation, const OperationStats &)>;
+
+/// @brief Gets the name of an operation, e.g. "MulMatrix".
+const char *OperationName(Operation op);
+
+/// @brief Reads the current totals.
+/// @note Counters are read one by one while other threads may be updating
+/// them, so a snapshot taken during concurrent work is not atomic as a
+/// whole.
+InstrumentationSnapshot GetInstrumentationSnapshot();
+
+/// @brief Sets every total back to zero.
+void ResetInstrumentation();
+
+/// @brief Installs the callback, or removes it when `callback` is empty.
+/// @note Calls in progress on other threads may still invoke the previous
+/// callback.
+void SetInstrumentationCallback(InstrumentationCallback callback);
+
+namespace detail {
+
+struct AtomicStats {
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+  std::atomic<std::uint64_t> flops{0};
+  std::atomic<std::uint64_t> bytes_allocated{0};
+  std::atomic<std::uint64_t> temporaries{0};
+};
+
+inline std::array<AtomicStats, kOperationCount> &InstrumentationTotals() {
+  static std::array<AtomicStats, kOperationCount> totals;
+  return totals;
+}
+
+inline std::shared_ptr<const InstrumentationCallback> &
+InstrumentationCallbackSlot() {
+  static std::shared_ptr<const InstrumentationCallback> callback;
+  return callback;
+}
+
+// Spares calls the lock behind std::atomic_load of the slot while no
+// callback is installed.
+inline std::atomic<bool> &InstrumentationCallbackInstalled() {
+  static std::atomic<bool> installed{false};
+  return installed;
+}
+
+/// @brief Accounts one call of an operation for the lifetime of the object.
+/// @note Only the outermost scope on a thread records; nested ones, and the
+/// allocations made under them, belong to it.
+class OperationScope {
+ public:
+  OperationScope(Operation op, std::uint64_t flops) noexcept {
+    if (Current()) return;
+    op_ = op;
+    stats_.calls = 1;
+    stats_.flops = flops;
+    Current() = this;
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  OperationScope(const OperationScope &) = delete;
+  OperationScope &operator=(const OperationScope &) = delete;
+
+  ~OperationScope() {
+    if (Current() != this) return;
+    Current() = nullptr;
+    stats_.nanoseconds = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_)
+            .count());
+    Record(op_, stats_);
+  }
+
+  /// @brief Accounts a matrix buffer of `bytes` to the active scope, or to
+  /// `fallback` when there is none.
+  static void Allocation(std::size_t bytes, Operation fallback) noexcept {
+    if (OperationScope *scope = Current()) {
+      scope->stats_.bytes_allocated += bytes;
+      scope->stats_.temporaries++;
+      return;
+    }
+    // A construction is a call of its own; the fallback of a copy is
+    // followed by the scope of the copy itself.
+    AtomicStats &totals = Totals(fallback);
+    if (fallback == Operation::kConstruct)
+      totals.calls.fetch_add(1, std::memory_order_relaxed);
+    totals.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    totals.temporaries.fetch_add(1, std::memory_order_relaxed);
+  }
+
+ private:
+  static OperationScope *&Current() noexcept {
+    thread_local OperationScope *current = nullptr;
+    return current;
+  }
+
+  static AtomicStats &Totals(Operation op) noexcept {
+    return InstrumentationTotals()[static_cast<std::size_t>(op)];
+  }
+
+  static void Record(Operation op, const OperationStats &stats) {
+    AtomicStats &totals = Totals(op);
+    totals.calls.fetch_add(stats.calls, std::memory_order_relaxed);
+    totals.nanoseconds.fetch_add(stats.nanoseconds, std::memory_order_relaxed);
+    totals.flops.fetch_add(stats.flops, std::memory_order_relaxed);
+    totals.bytes_allocated.fetch_add(stats.bytes_allocated,
+                                     std::memory_order_relaxed);
+    totals.temporaries.fetch_add(stats.temporaries, std::memory_order_relaxed);
+    if (!InstrumentationCallbackInstalled().load(std::memory_order_acquire))
+      return;
+    const std::shared_ptr<const InstrumentationCallback> callback =
+        std::atomic_load(&InstrumentationCallbackSlot());
+    if (callback) (*callback)(op, stats);
+  }
+
+  Operation op_ = Operation::kCount;
+  OperationStats stats_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace detail
+
+inline OperationStats InstrumentationSnapshot::Total() const {
+  OperationStats total;
+  for (const OperationStats &stats : operations) {
+    total.calls += stats.calls;
+    total.nanoseconds += stats.nanoseconds;
+    total.flops += stats.flops;
+    total.bytes_allocated += stats.bytes_allocated;
+    total.temporaries += stats.temporaries;
+  }
+  return total;
+}
+
+inline const char *OperationName(Operation op) {
+  static constexpr const char *kNames[kOperationCount] = {
+      "Construct", "Copy", "Evaluate", "EqMatrix", "SumMatrix", "SubMatrix",
+      "MulNumber", "MulMatrix", "Product", "MulMatrixStrassen", "Gemv", "GemvT",
+      "Gemm", "Solve", "TriangularSolve", "Transpose", "TransposeInPlace",
+      "CalcComplements", "Determinant", "InverseMatrix", "InvertMatrix",
+      "SetRows", "SetCols", "GetMinor"};
+  const std::size_t index = static_cast<std::size_t>(op);
+  return index < kOperationCount ? kNames[index] : "Unknown";
+}
+
+inline InstrumentationSnapshot GetInstrumentationSnapshot() {
+  InstrumentationSnapshot snapshot;
+  for (std::size_t i = 0; i < kOperationCount; i++) {
+    const detail::AtomicStats &totals = detail::InstrumentationTotals()[i];
+    OperationStats &stats = snapshot.operations[i];
+    stats.calls = totals.calls.load(std::memory_order_relaxed);
+    stats.nanoseconds = totals.nanoseconds.load(std::memory_order_relaxed);
+    stats.flops = totals.flops.load(std::memory_order_relaxed);
+    stats.bytes_allocated =
+        totals.bytes_allocated.load(std::memory_order_relaxed);
+    stats.temporaries = totals.temporaries.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+inline void ResetInstrumentation() {
+  for (detail::AtomicStats &totals : detail::InstrumentationTotals()) {
+    totals.calls.store(0, std::memory_order_relaxed);
+    totals.nanoseconds.store(0, std::memory_order_relaxed);
+    totals.flops.store(0, std::memory_order_relaxed);
+    totals.bytes_allocated.store(0, std::memory_order_relaxed);
+    totals.temporaries.store(0, std::memory_order_relaxed);
+  }
+}
+
+inline void SetInstrumentationCallback(InstrumentationCallback callback) {
+  std::shared_ptr<const InstrumentationCallback> slot;
+  if (callback)
+    slot = std::make_shared<const InstrumentationCallback>(std::move(callback));
+  const bool installed = static_cast<bool>(slot);
+  std::atomic_store(&detail::InstrumentationCallbackSlot(), std::move(slot));
+  detail::InstrumentationCallbackInstalled().store(installed,
+                                                   std::memory_order_release);
+}
+
+}  // namespace S21
+
+/// @brief Accounts the rest of the enclosing block as one call of `op`, an
+/// enumerator of Operation, with a nominal count of `flops`.
+/// @note S21_INSTRUMENT_ALLOCATION accounts a matrix buffer of `bytes` to
+/// the active call, or to the Operation `fallback` outside of any.
+#ifdef S21_INSTRUMENTATION
+#define S21_INSTRUMENT(op, flops)                             \
+  const ::S21::detail::OperationScope s21_operation_scope_( \
+      ::S21::Operation::op, static_cast<std::uint64_t>(flops))
+#define S21_INSTRUMENT_ALLOCATION(bytes, fallback) \
+  ::S21::detail::OperationScope::Allocation((bytes), (fallback))
+#else
+#define S21_INSTRUMENT(op, flops) static_cast<void>(0)
+#define S21_INSTRUMENT_ALLOCATION(bytes, fallback) static_cast<void>(0)
+#endif
+
+#endif  // S21_INSTRUMENTATION_HPP_
@@ -0,0 +1,399 @@
+#ifndef S21_IO_HPP_
+#define S21_IO_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.hpp"
+
+/// @file
+/// @brief Binary matrix files and memory-mapped loading.
+/// @note A file is a 64-byte MatrixFileHeader followed by the payload at
+/// `offset`, a multiple of 64 so that a mapped payload has the alignment
+/// of an S21Matrix buffer. The payload holds rows * stride elements in the
+/// byte order of the writer, row after row. Every header field is stored in
+/// the same byte order, which the reader recognizes from `byte_order`.
+
+namespace S21 {
+
+/// @brief Element type codes stored in a matrix file.
+enum class ElementType : std::uint8_t {
+  kInt8 = 1,
+  kUInt8,
+  kInt16,
+  kUInt16,
+  kInt32,
+  kUInt32,
+  kInt64,
+  kUInt64,
+  kFloat32,
+  kFloat64
+};
+
+/// @brief Header at the start of every matrix file.
+struct MatrixFileHeader {
+  static constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+  static constexpr std::uint16_t kVersion = 1;
+  static constexpr std::uint32_t kByteOrder = 0x01020304;
+  static constexpr std::uint32_t kChecksumFlag = 1;  // `checksum` is valid
+
+  char magic[8];
+  std::uint32_t byte_order;  // kByteOrder as written by the writer
+  std::uint16_t version;
+  std::uint8_t element_type;  // An ElementType
+  std::uint8_t element_size;  // In bytes
+  std::uint32_t flags;
+  std::uint32_t reserved;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint64_t stride;    // Elements between consecutive rows, >= cols
+  std::uint64_t offset;    // Start of the payload in bytes
+  std::uint64_t checksum;  // FNV-1a of the payload bytes as stored
+};
+
+static_assert(sizeof(MatrixFileHeader) == 64, "Unexpected header padding");
+
+/// @brief Writes a matrix to a binary file, replacing its contents.
+/// @param checksum Whether to store a checksum of the payload, which
+/// LoadMatrix() verifies.
+/// @throw std::runtime_error if the file cannot be written.
+template <typename T>
+void SaveMatrix(const S21Matrix<T> &matrix, const std::string &path,
+                bool checksum = true);
+
+/// @brief Reads a matrix written by SaveMatrix().
+/// @note Files written on a machine with the other byte order are
+/// converted while loading.
+/// @param resource Memory resource the matrix is allocated from.
+/// @throw std::runtime_error if the file cannot be read, is not a matrix
+/// file, has another element type than T or fails the checksum.
+template <typename T = double>
+S21Matrix<T> LoadMatrix(const std::string &path,
+                        std::pmr::memory_resource *resource =
+                            std::pmr::get_default_resource());
+
+/// @brief How S21MappedMatrix maps its file.
+/// @note kReadOnly shares the pages of the file with every process that
+/// maps it. kCopyOnWrite allows writes, which copy the touched pages and
+/// never reach the file.
+enum class MapMode { kReadOnly, kCopyOnWrite };
+
+namespace detail {
+
+template <typename T>
+constexpr ElementType ElementTypeOf() {
+  static_assert(!std::is_same_v<T, bool> && !std::is_same_v<T, long double>,
+                "No matrix file element type for T");
+  if constexpr (std::is_floating_point_v<T>) {
+    return sizeof(T) == 4 ? ElementType::kFloat32 : ElementType::kFloat64;
+  } else {
+    constexpr int kLog = sizeof(T) == 1 ? 0
+                         : sizeof(T) == 2 ? 1
+                         : sizeof(T) == 4 ? 2
+                                          : 3;
+    return static_cast<ElementType>(1 + 2 * kLog + !std::is_signed_v<T>);
+  }
+}
+
+template <typename U>
+void ByteSwap(U &value) {
+  unsigned char bytes[sizeof(U)];
+  std::memcpy(bytes, &value, sizeof(U));
+  std::reverse(bytes, bytes + sizeof(U));
+  std::memcpy(&value, bytes, sizeof(U));
+}
+
+inline void ByteSwap(MatrixFileHeader &header) {
+  ByteSwap(header.byte_order);
+  ByteSwap(header.version);
+  ByteSwap(header.flags);
+  ByteSwap(header.reserved);
+  ByteSwap(header.rows);
+  ByteSwap(header.cols);
+  ByteSwap(header.stride);
+  ByteSwap(header.offset);
+  ByteSwap(header.checksum);
+}
+
+/// @brief Continues a 64-bit FNV-1a hash over `size` bytes.
+inline std::uint64_t Fnv1a(const void *data, std::size_t size,
+                           std::uint64_t hash = 14695981039346656037ull) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < size; i++)
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  return hash;
+}
+
+/// @brief Validates a header read from a file and converts it to the
+/// native byte order.
+/// @param swapped Set when the file has the other byte order.
+/// @param file_size Size of the file, which must hold the payload.
+template <typename T>
+void CheckHeader(MatrixFileHeader &header, std::uint64_t file_size,
+                 bool &swapped) {
+  if (std::memcmp(header.magic, MatrixFileHeader::kMagic, 8) != 0)
+    throw std::runtime_error("Not a matrix file");
+  swapped = header.byte_order != MatrixFileHeader::kByteOrder;
+  if (swapped) ByteSwap(header);
+  if (header.byte_order != MatrixFileHeader::kByteOrder)
+    throw std::runtime_error("Not a matrix file");
+  if (header.version != MatrixFileHeader::kVersion)
+    throw std::runtime_error("Unsupported matrix file version");
+  if (header.element_type != static_cast<std::uint8_t>(ElementTypeOf<T>()) ||
+      header.element_size != sizeof(T))
+    throw std::runtime_error("Matrix file has another element type");
+  const std::uint64_t elements = header.rows * header.stride;
+  if (header.stride < header.cols ||
+      (header.stride != 0 && header.rows > UINT64_MAX / header.stride) ||
+      elements > (UINT64_MAX - header.offset) / sizeof(T) ||
+      header.offset < sizeof(MatrixFileHeader) ||
+      header.offset + elements * sizeof(T) > file_size)
+    throw std::runtime_error("Matrix file is truncated or corrupted");
+}
+
+/// @brief Memory resource of a mapped matrix: its only buffer is the
+/// mapping, which deallocation unmaps. Buffers the matrix allocates later,
+/// e.g. when it is resized, come from the upstream resource.
+class MappedResource : public std::pmr::memory_resource {
+ public:
+  MappedResource(void *base, std::size_t length)
+      : base_(base),
+        length_(length),
+        upstream_(std::pmr::get_default_resource()) {}
+  MappedResource(const MappedResource &) = delete;
+  MappedResource &operator=(const MappedResource &) = delete;
+  ~MappedResource() override { Unmap(); }
+
+  void *Base() const { return base_; }
+
+ private:
+  void Unmap() noexcept {
+    if (base_) munmap(base_, length_);
+    base_ = nullptr;
+  }
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    const char *base = static_cast<const char *>(base_);
+    const char *pointer = static_cast<const char *>(p);
+    if (base && pointer >= base && pointer < base + length_)
+      Unmap();
+    else
+      upstream_->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  void *base_;
+  std::size_t length_;
+  std::pmr::memory_resource *upstream_;
+};
+
+}  // namespace detail
+
+/// @brief A matrix whose elements are the pages of a matrix file, mapped
+/// with mmap instead of being read.
+/// @note Opening costs a few system calls whatever the size of the matrix;
+/// pages are read from the file, or found in the page cache, the first
+/// time they are touched. The file must have been written with the native
+/// byte order and the element type T, and its rows must be contiguous.
+/// @note The matrix is an ordinary S21Matrix whose memory resource unmaps
+/// the file when the buffer is released. It must not outlive the
+/// S21MappedMatrix, which owns that resource.
+/// @tparam T The type of the matrix elements.
+template <typename T = double>
+class S21MappedMatrix {
+ public:
+  /// @brief Maps a file written by SaveMatrix().
+  /// @param verify Whether to check the stored checksum, which reads the
+  /// whole payload once.
+  /// @throw std::runtime_error if the file cannot be mapped, is not a
+  /// matrix file, cannot be used in place or fails the checksum.
+  explicit S21MappedMatrix(const std::string &path,
+                           MapMode mode = MapMode::kReadOnly,
+                           bool verify = false);
+
+  S21MappedMatrix(const S21MappedMatrix &) = delete;
+  S21MappedMatrix(S21MappedMatrix &&) = default;
+  S21MappedMatrix &operator=(const S21MappedMatrix &) = delete;
+  S21MappedMatrix &operator=(S21MappedMatrix &&) = delete;
+
+  MapMode GetMode() const { return mode_; }
+
+  /// @brief Gets the mapped matrix.
+  const S21Matrix<T> &Matrix() const { return matrix_; }
+
+  /// @brief Gets the mapped matrix for modification.
+  /// @throw std::runtime_error if the file is mapped read-only.
+  S21Matrix<T> &MutableMatrix();
+
+ private:
+  struct Mapping {
+    std::unique_ptr<detail::MappedResource> resource;
+    MatrixFileHeader header;
+  };
+
+  static Mapping Map(const std::string &path, MapMode mode, bool verify);
+  S21MappedMatrix(Mapping mapping, MapMode mode);
+
+  MapMode mode_;
+  std::unique_ptr<detail::MappedResource> resource_;  // Outlives matrix_
+  S21Matrix<T> matrix_;
+};
+
+template <typename T>
+void SaveMatrix(const S21Matrix<T> &matrix, const std::string &path,
+                bool checksum) {
+  MatrixFileHeader header{};
+  std::memcpy(header.magic, MatrixFileHeader::kMagic, 8);
+  header.byte_order = MatrixFileHeader::kByteOrder;
+  header.version = MatrixFileHeader::kVersion;
+  header.element_type = static_cast<std::uint8_t>(detail::ElementTypeOf<T>());
+  header.element_size = sizeof(T);
+  header.rows = matrix.GetRows();
+  header.cols = matrix.GetCols();
+  header.stride = matrix.GetCols();
+  header.offset = S21Matrix<T>::kAlignment;
+  const std::size_t row_bytes = matrix.GetCols() * sizeof(T);
+  if (checksum) {
+    header.flags |= MatrixFileHeader::kChecksumFlag;
+    header.checksum = detail::Fnv1a(nullptr, 0);
+    for (std::size_t i = 0; i < matrix.GetRows(); i++)
+      header.checksum = detail::Fnv1a(matrix[i].data(), row_bytes,
+                                      header.checksum);
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Cannot open matrix file " + path);
+  const char padding[S21Matrix<T>::kAlignment - sizeof(header)] = {};
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(padding, sizeof(padding));
+  if (matrix.Stride() == matrix.GetCols()) {
+    file.write(reinterpret_cast<const char *>(matrix.Data()),
+               row_bytes * matrix.GetRows());
+  } else {
+    for (std::size_t i = 0; i < matrix.GetRows(); i++)
+      file.write(reinterpret_cast<const char *>(matrix[i].data()), row_bytes);
+  }
+  if (!file.flush())
+    throw std::runtime_error("Cannot write matrix file " + path);
+}
+
+template <typename T>
+S21Matrix<T> LoadMatrix(const std::string &path,
+                        std::pmr::memory_resource *resource) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("Cannot open matrix file " + path);
+  const std::uint64_t file_size = static_cast<std::uint64_t>(file.tellg());
+  MatrixFileHeader header{};
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    throw std::runtime_error("Not a matrix file");
+  bool swapped = false;
+  detail::CheckHeader<T>(header, file_size, swapped);
+
+  S21Matrix<T> matrix(header.rows, header.cols, resource);
+  const std::size_t row_bytes = header.cols * sizeof(T);
+  const std::size_t skip = (header.stride - header.cols) * sizeof(T);
+  std::uint64_t checksum = detail::Fnv1a(nullptr, 0);
+  file.seekg(static_cast<std::streamoff>(header.offset));
+  for (std::size_t i = 0; i < header.rows; i++) {
+    char *row = reinterpret_cast<char *>(matrix[i].data());
+    file.read(row, row_bytes);
+    checksum = detail::Fnv1a(row, row_bytes, checksum);
+    for (std::size_t s = 0; s < skip; s++) {
+      const char byte = static_cast<char>(file.get());
+      checksum = detail::Fnv1a(&byte, 1, checksum);
+    }
+  }
+  if (!file) throw std::runtime_error("Matrix file is truncated or corrupted");
+  if ((header.flags & MatrixFileHeader::kChecksumFlag) &&
+      checksum != header.checksum)
+    throw std::runtime_error("Matrix file checksum mismatch");
+  if (swapped)
+    for (std::size_t i = 0; i < header.rows; i++)
+      for (T &value : matrix[i]) detail::ByteSwap(value);
+  return matrix;
+}
+
+template <typename T>
+typename S21MappedMatrix<T>::Mapping S21MappedMatrix<T>::Map(
+    const std::string &path, MapMode mode, bool verify) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Cannot open matrix file " + path);
+  struct stat status;
+  void *base = MAP_FAILED;
+  std::size_t length = 0;
+  if (fstat(fd, &status) == 0 && status.st_size > 0) {
+    length = static_cast<std::size_t>(status.st_size);
+    base = mode == MapMode::kReadOnly
+               ? mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0)
+               : mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      fd, 0);
+  }
+  close(fd);  // The mapping keeps the file open
+  if (base == MAP_FAILED)
+    throw std::runtime_error("Cannot map matrix file " + path);
+  Mapping mapping{std::make_unique<detail::MappedResource>(base, length), {}};
+
+  if (length < sizeof(MatrixFileHeader))
+    throw std::runtime_error("Not a matrix file");
+  MatrixFileHeader &header = mapping.header;
+  std::memcpy(&header, base, sizeof(header));
+  bool swapped = false;
+  detail::CheckHeader<T>(header, length, swapped);
+  if (swapped)
+    throw std::runtime_error("Mapped matrix file has another byte order");
+  if (header.stride != header.cols ||
+      header.offset % S21Matrix<T>::kAlignment != 0)
+    throw std::runtime_error("Mapped matrix file has padded rows");
+  if (verify && (header.flags & MatrixFileHeader::kChecksumFlag) &&
+      detail::Fnv1a(static_cast<const char *>(base) + header.offset,
+                    header.rows * header.cols * sizeof(T)) != header.checksum)
+    throw std::runtime_error("Matrix file checksum mismatch");
+  return mapping;
+}
+
+template <typename T>
+S21MappedMatrix<T>::S21MappedMatrix(const std::string &path, MapMode mode,
+                                    bool verify)
+    : S21MappedMatrix(Map(path, mode, verify), mode) {}
+
+template <typename T>
+S21MappedMatrix<T>::S21MappedMatrix(Mapping mapping, MapMode mode)
+    : mode_(mode),
+      resource_(std::move(mapping.resource)),
+      matrix_(mapping.header.rows, mapping.header.cols,
+              reinterpret_cast<T *>(static_cast<char *>(resource_->Base()) +
+                                    mapping.header.offset),
+              resource_.get()) {}
+
+template <typename T>
+S21Matrix<T> &S21MappedMatrix<T>::MutableMatrix() {
+  if (mode_ == MapMode::kReadOnly)
+    throw std::runtime_error("Matrix is mapped read-only");
+  return matrix_;
+}
+
+}  // namespace S21
+
+#endif  // S21_IO_HPP_
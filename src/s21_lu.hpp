@@ -0,0 +1,452 @@
+#ifndef S21_LU_HPP_
+#define S21_LU_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_triangular.hpp"
+#include "s21_vector.hpp"
+
+#ifndef S21_LU_BLOCK
+#define S21_LU_BLOCK 64  // Panel width of the blocked factorization
+#endif
+
+namespace S21 {
+
+/// @brief LU factorization with partial pivoting, P * A = L * U.
+/// @note The factors are computed once, in place, by a blocked
+/// right-looking algorithm: each panel of S21_LU_BLOCK columns is factored
+/// with row pivoting, the matching block row of U is obtained by a
+/// triangular solve and the trailing submatrix is updated with one GEMM.
+/// The object can then be reused for the determinant, for solving systems
+/// and for the inverse without repeating the elimination.
+/// @note A pivot whose magnitude is below EPSILON marks the matrix as
+/// singular, which is the same criterion S21Matrix used before.
+/// @note The factors, and the results of Solve() and Inverse(), use the
+/// memory resource of the matrix the object was constructed from.
+/// @tparam T The floating-point type of the matrix elements.
+template <typename T = double>
+class LU {
+  static_assert(std::is_floating_point_v<T>,
+                "LU factorization requires a floating-point type");
+
+ public:
+  /// @brief Factorizes a copy of the provided square matrix.
+  /// @param matrix The matrix to factorize.
+  explicit LU(const S21Matrix<T> &matrix);
+
+  /// @brief Factorizes the provided square matrix in its own storage.
+  /// @param matrix The matrix to factorize; its buffer is taken over.
+  explicit LU(S21Matrix<T> &&matrix);
+
+  /// @brief Factorizes the value of a matrix expression, such as a block or
+  /// a minor view.
+  /// @note The expression is evaluated once, straight into the storage of
+  /// the factors, which use the default memory resource.
+  /// @param expr The square expression to factorize.
+  template <typename E>
+  explicit LU(const MatrixExpression<E> &expr);
+
+  /// @brief Gets the order of the factorized matrix.
+  std::size_t GetSize() const;
+
+  /// @brief Checks whether a pivot below EPSILON was encountered.
+  bool IsSingular() const;
+
+  /// @brief Gets the packed factors.
+  /// @return A matrix holding U on and above the diagonal and the
+  /// multipliers of the unit lower triangular L below it.
+  const S21Matrix<T> &GetFactors() const;
+
+  /// @brief Gets the row permutation.
+  /// @return A vector p such that row i of P * A is row p[i] of A.
+  const std::vector<std::size_t> &GetPermutation() const;
+
+  /// @brief Calculates the determinant from the diagonal of U.
+  /// @note The product is accumulated in long double.
+  /// @return The determinant, or zero for a singular matrix.
+  T Determinant() const;
+
+  /// @brief Solves A * X = B.
+  /// @note Forward and back substitution by TriangularSolve(), with the
+  /// right-hand sides split across ThreadPool::Instance() when there are
+  /// many of them.
+  /// @param rhs The right-hand sides B, one per column.
+  /// @return The solution X with the same shape as B.
+  /// @throw std::runtime_error if B does not have one row per row of A or
+  /// the matrix is singular.
+  S21Matrix<T> Solve(S21MatrixView<const T> rhs) const;
+
+  /// @brief Solves A * X = B into storage owned by the caller.
+  /// @note Does not allocate, so the same factorization can be applied to a
+  /// stream of right-hand sides.
+  /// @param x The solution, with the shape of B; must not overlap B.
+  /// @throw std::runtime_error if the shapes do not match, X overlaps B or
+  /// the matrix is singular.
+  void Solve(S21MatrixView<const T> rhs, S21MatrixView<T> x) const;
+
+  /// @brief Solves A * x = b for a single right-hand side.
+  /// @throw std::runtime_error as Solve() for matrices.
+  S21Vector<T> Solve(const S21Vector<T> &rhs) const;
+
+  /// @brief Solves A * x = b into a vector owned by the caller.
+  /// @param x The solution; must not be `rhs`.
+  /// @throw std::runtime_error as Solve() for matrices.
+  void Solve(const S21Vector<T> &rhs, S21Vector<T> &x) const;
+
+  /// @brief Calculates the inverse of the factorized matrix.
+  /// @note Solves against the identity in O(n^3); for large matrices the
+  /// columns are split into blocks that are solved in parallel.
+  /// @return A new matrix X such that A * X = I.
+  S21Matrix<T> Inverse() const;
+
+ private:
+  void Factorize();
+  void FactorizePanel(std::size_t k0, std::size_t kb);
+  void CheckSolvable() const;
+  void Substitute(T *x, std::size_t ldx, std::size_t cols) const;
+
+  S21Matrix<T> lu_;
+  std::vector<std::size_t> permutation_;
+  bool negative_ = false;  // Odd number of row interchanges
+  bool singular_ = false;
+};
+
+template <typename T>
+LU<T>::LU(const S21Matrix<T> &matrix)
+    : LU(S21Matrix<T>(matrix, matrix.GetResource())) {}
+
+template <typename T>
+LU<T>::LU(S21Matrix<T> &&matrix) : lu_(std::move(matrix)) {
+  if (lu_.GetRows() != lu_.GetCols())
+    throw std::runtime_error("Matrix must be square to be factorized");
+  permutation_.resize(lu_.GetRows());
+  std::iota(permutation_.begin(), permutation_.end(), std::size_t{0});
+  Factorize();
+}
+
+template <typename T>
+template <typename E>
+LU<T>::LU(const MatrixExpression<E> &expr) : LU(S21Matrix<T>(expr)) {}
+
+template <typename T>
+std::size_t LU<T>::GetSize() const {
+  return lu_.GetRows();
+}
+
+template <typename T>
+bool LU<T>::IsSingular() const {
+  return singular_;
+}
+
+template <typename T>
+const S21Matrix<T> &LU<T>::GetFactors() const {
+  return lu_;
+}
+
+template <typename T>
+const std::vector<std::size_t> &LU<T>::GetPermutation() const {
+  return permutation_;
+}
+
+template <typename T>
+void LU<T>::FactorizePanel(std::size_t k0, std::size_t kb) {
+  const std::size_t n = lu_.GetRows();
+  const std::size_t ld = lu_.Stride();
+  T *a = lu_.Data();
+  for (std::size_t j = k0; j < k0 + kb; j++) {
+    std::size_t pivot = j;
+    for (std::size_t i = j + 1; i < n; i++)
+      if (std::abs(a[i * ld + j]) > std::abs(a[pivot * ld + j])) pivot = i;
+    if (std::abs(a[pivot * ld + j]) < EPSILON) {
+      singular_ = true;
+      continue;
+    }
+    if (pivot != j) {
+      lu_.SwapRows(pivot, j);
+      std::swap(permutation_[pivot], permutation_[j]);
+      negative_ = !negative_;
+    }
+
+    const T *pivot_row = a + j * ld;
+    for (std::size_t i = j + 1; i < n; i++) {
+      T *row = a + i * ld;
+      const T multiplier = row[j] /= pivot_row[j];
+      for (std::size_t c = j + 1; c < k0 + kb; c++)
+        row[c] -= multiplier * pivot_row[c];
+    }
+  }
+}
+
+template <typename T>
+void LU<T>::Factorize() {
+  const std::size_t n = lu_.GetRows();
+  const std::size_t ld = lu_.Stride();
+  T *a = lu_.Data();
+  for (std::size_t k0 = 0; k0 < n; k0 += S21_LU_BLOCK) {
+    const std::size_t kb = std::min<std::size_t>(S21_LU_BLOCK, n - k0);
+    const std::size_t k1 = k0 + kb;
+    FactorizePanel(k0, kb);
+    if (k1 == n) break;
+
+    // U12 = L11^-1 * A12
+    detail::TriangularSolveBlocked(Triangle::kLower, Diagonal::kUnit, kb,
+                                   n - k1, a + k0 * ld + k0, ld,
+                                   a + k0 * ld + k1, ld);
+
+    // A22 -= L21 * U12
+    detail::Gemm(n - k1, n - k1, kb, T(-1), a + k1 * ld + k0, ld,
+                 a + k0 * ld + k1, ld, T(1), a + k1 * ld + k1, ld);
+  }
+}
+
+template <typename T>
+T LU<T>::Determinant() const {
+  if (singular_) return T(0);
+  long double l_result = negative_ ? -1.0L : 1.0L;
+  for (std::size_t i = 0; i < GetSize(); i++)
+    l_result *= lu_.Data()[i * lu_.Stride() + i];
+
+  if (std::abs(l_result) > std::numeric_limits<double>::max())
+    throw std::overflow_error("Value exceeds DBL_MAX");
+  return (T)l_result;
+}
+
+template <typename T>
+void LU<T>::CheckSolvable() const {
+  if (singular_) throw std::runtime_error("Matrix is not invertible");
+}
+
+template <typename T>
+void LU<T>::Substitute(T *x, std::size_t ldx, std::size_t cols) const {
+  const std::size_t n = GetSize();
+  detail::ForEachColumnBlock<T>(
+      n, cols, [&](std::size_t first, std::size_t count) {
+        // L * Y = P * B, then U * X = Y.
+        detail::TriangularSolveBlocked(Triangle::kLower, Diagonal::kUnit, n,
+                                       count, lu_.Data(), lu_.Stride(),
+                                       x + first, ldx);
+        detail::TriangularSolveBlocked(Triangle::kUpper, Diagonal::kNonUnit,
+                                       n, count, lu_.Data(), lu_.Stride(),
+                                       x + first, ldx);
+      });
+}
+
+template <typename T>
+void LU<T>::Solve(S21MatrixView<const T> rhs, S21MatrixView<T> x) const {
+  const std::size_t n = GetSize();
+  const std::size_t m = rhs.GetCols();
+  if (rhs.GetRows() != n || x.GetRows() != n || x.GetCols() != m)
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for solving the system");
+  if (detail::Overlap<T>(rhs, x))
+    throw std::runtime_error("Solve cannot write over its input");
+  CheckSolvable();
+  S21_INSTRUMENT(kSolve, 2 * n * n * m);
+
+  for (std::size_t i = 0; i < n; i++)
+    std::copy_n(rhs.Data() + permutation_[i] * rhs.Stride(), m,
+                x.Data() + i * x.Stride());
+  Substitute(x.Data(), x.Stride(), m);
+}
+
+template <typename T>
+S21Matrix<T> LU<T>::Solve(S21MatrixView<const T> rhs) const {
+  S21_INSTRUMENT(kSolve, 2 * GetSize() * GetSize() * rhs.GetCols());
+  S21Matrix<T> x(GetSize(), rhs.GetCols(), lu_.GetResource());
+  Solve(rhs, x);
+  return x;
+}
+
+template <typename T>
+void LU<T>::Solve(const S21Vector<T> &rhs, S21Vector<T> &x) const {
+  if (&rhs == &x) throw std::runtime_error("Solve cannot write over its input");
+  Solve(S21MatrixView<const T>(rhs.Data(), rhs.GetSize(), 1, 1),
+        S21MatrixView<T>(x.Data(), x.GetSize(), 1, 1));
+}
+
+template <typename T>
+S21Vector<T> LU<T>::Solve(const S21Vector<T> &rhs) const {
+  S21_INSTRUMENT(kSolve, 2 * GetSize() * GetSize());
+  S21Vector<T> x(GetSize(), lu_.GetResource());
+  Solve(rhs, x);
+  return x;
+}
+
+template <typename T>
+S21Matrix<T> LU<T>::Inverse() const {
+  CheckSolvable();
+  const std::size_t n = GetSize();
+  S21Matrix<T> x(n, n, lu_.GetResource());
+  for (std::size_t i = 0; i < n; i++) x(i, permutation_[i]) = T(1);
+  Substitute(x.Data(), x.Stride(), n);
+  return x;
+}
+
+/// @brief Solves A * X = B without forming the inverse of A.
+/// @note Factorizes a scratch copy of A with LU and applies it to every
+/// column of B, in 2/3 n^3 + 2 n^2 m operations. Build an LU object and call
+/// Solve(const LU<T> &, ...) to reuse the factorization for other B.
+/// @param a The square matrix of the system, or an expression.
+/// @param b The right-hand sides, one per column, or an expression.
+/// @return The solution X, allocated from the memory resource of A when A
+/// is a matrix.
+/// @throw std::runtime_error if the shapes do not match or A is singular.
+template <typename L, typename R>
+S21Matrix<typename L::value_type> Solve(const MatrixExpression<L> &a,
+                                        const MatrixExpression<R> &b) {
+  using T = typename L::value_type;
+  static_assert(std::is_same_v<T, typename R::value_type>,
+                "Operands must have the same element type");
+  const std::size_t n = a.Self().GetRows(), m = b.Self().GetCols();
+  S21_INSTRUMENT(kSolve, 2 * n * n * n / 3 + 2 * n * n * m);
+  const LU<T> lu(S21Matrix<T>(a.Self(), ScratchResource()));
+  const auto &rhs = detail::Materialize(b.Self());
+  S21Matrix<T> x(n, m, detail::ResultResource(a.Self()));
+  lu.Solve(rhs, x);
+  return x;
+}
+
+/// @brief Solves A * x = b for a single right-hand side.
+/// @throw std::runtime_error if the sizes do not match or A is singular.
+template <typename E, typename T>
+S21Vector<T> Solve(const MatrixExpression<E> &a, const S21Vector<T> &b) {
+  const std::size_t n = a.Self().GetRows();
+  S21_INSTRUMENT(kSolve, 2 * n * n * n / 3 + 2 * n * n);
+  const LU<T> lu(S21Matrix<T>(a.Self(), ScratchResource()));
+  S21Vector<T> x(n, detail::ResultResource(a.Self()));
+  lu.Solve(b, x);
+  return x;
+}
+
+/// @brief Solves A * X = B with an existing factorization of A.
+/// @throw std::runtime_error as LU::Solve().
+template <typename T, typename R>
+S21Matrix<T> Solve(const LU<T> &lu, const MatrixExpression<R> &b) {
+  return lu.Solve(detail::Materialize(b.Self()));
+}
+
+/// @brief Solves A * x = b with an existing factorization of A.
+/// @throw std::runtime_error as LU::Solve().
+template <typename T>
+S21Vector<T> Solve(const LU<T> &lu, const S21Vector<T> &b) {
+  return lu.Solve(b);
+}
+
+namespace detail {
+
+/// @brief Calculates the matrix of cofactors from an LU factorization with
+/// complete pivoting, P * A * Q = L * U.
+/// @note This is the rank-aware path used for matrices that partial
+/// pivoting reports as singular. Complete pivoting moves every negligible
+/// pivot to the end of the diagonal of U, so the numerical rank r is the
+/// number of pivots above EPSILON and, since adj(A) = det(P) det(Q) *
+/// Q * adj(U) * L^-1 * P:
+///   - r = n: adj(U) L^-1 = det(U) * (L * U)^-1;
+///   - r = n - 1: adj(U) = det(U11) * x * e_n^T with x = [-U11^-1 u; 1],
+///     so adj(A) is the rank-one product of Q * x and e_n^T * L^-1 * P;
+///   - r < n - 1: every minor of order n - 1 vanishes and adj(A) = 0.
+/// All three cases cost O(n^3).
+/// @param a The square matrix, overwritten by its factors.
+/// @param resource Memory resource the result is allocated from.
+/// @return The matrix of cofactors, that is adj(A)^T.
+template <typename T>
+S21Matrix<T> CofactorsCompletePivoting(S21Matrix<T> a,
+                                       std::pmr::memory_resource *resource) {
+  const std::size_t n = a.GetRows();
+  const std::size_t ld = a.Stride();
+  T *d = a.Data();
+  std::vector<std::size_t> row_perm(n), col_perm(n);
+  std::iota(row_perm.begin(), row_perm.end(), std::size_t{0});
+  std::iota(col_perm.begin(), col_perm.end(), std::size_t{0});
+  bool negative = false;
+  std::size_t rank = 0;
+  for (; rank < n; rank++) {
+    const std::size_t k = rank;
+    std::size_t pivot_row = k, pivot_col = k;
+    for (std::size_t i = k; i < n; i++)
+      for (std::size_t j = k; j < n; j++)
+        if (std::abs(d[i * ld + j]) > std::abs(d[pivot_row * ld + pivot_col])) {
+          pivot_row = i;
+          pivot_col = j;
+        }
+    if (std::abs(d[pivot_row * ld + pivot_col]) < EPSILON) break;
+    if (pivot_row != k) {
+      a.SwapRows(pivot_row, k);
+      std::swap(row_perm[pivot_row], row_perm[k]);
+      negative = !negative;
+    }
+    if (pivot_col != k) {
+      for (std::size_t i = 0; i < n; i++)
+        std::swap(d[i * ld + pivot_col], d[i * ld + k]);
+      std::swap(col_perm[pivot_col], col_perm[k]);
+      negative = !negative;
+    }
+    const T *u_row = d + k * ld;
+    for (std::size_t i = k + 1; i < n; i++) {
+      T *row = d + i * ld;
+      const T multiplier = row[k] /= u_row[k];
+      for (std::size_t j = k + 1; j < n; j++) row[j] -= multiplier * u_row[j];
+    }
+  }
+
+  S21Matrix<T> result(n, n, resource);
+  if (rank + 1 < n) return result;
+
+  // det(U11), where U11 excludes the last pivot when it is negligible.
+  long double det = negative ? -1.0L : 1.0L;
+  for (std::size_t i = 0; i + 1 < n; i++) det *= d[i * ld + i];
+
+  if (rank == n) {
+    det *= d[(n - 1) * ld + n - 1];
+    // Y = det(U) * (L * U)^-1, then adj(A)[cp[j]][rp[i]] = Y[j][i].
+    S21Matrix<T> y(n, n, ScratchResource());
+    for (std::size_t i = 0; i < n; i++) y(i, i) = static_cast<T>(det);
+    for (std::size_t i = 1; i < n; i++)
+      for (std::size_t p = 0; p < i; p++)
+        for (std::size_t c = 0; c < n; c++) y(i, c) -= d[i * ld + p] * y(p, c);
+    for (std::size_t i = n; i-- > 0;) {
+      for (std::size_t p = i + 1; p < n; p++)
+        for (std::size_t c = 0; c < n; c++) y(i, c) -= d[i * ld + p] * y(p, c);
+      for (std::size_t c = 0; c < n; c++) y(i, c) /= d[i * ld + i];
+    }
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t j = 0; j < n; j++)
+        result(row_perm[i], col_perm[j]) = y(j, i);
+    return result;
+  }
+
+  // x = [-U11^-1 * u; 1] by back substitution.
+  std::vector<T> x(n);
+  x[n - 1] = T(1);
+  for (std::size_t i = n - 1; i-- > 0;) {
+    T sum = d[i * ld + n - 1];
+    for (std::size_t p = i + 1; p + 1 < n; p++) sum += d[i * ld + p] * x[p];
+    x[i] = -sum / d[i * ld + i];
+  }
+  // w with L^T * w = e_n, i.e. the last row of L^-1.
+  std::vector<T> w(n);
+  w[n - 1] = T(1);
+  for (std::size_t i = n - 1; i-- > 0;) {
+    T sum = T(0);
+    for (std::size_t p = i + 1; p < n; p++) sum += d[p * ld + i] * w[p];
+    w[i] = -sum;
+  }
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      result(row_perm[i], col_perm[j]) = static_cast<T>(det * x[j] * w[i]);
+  return result;
+}
+
+}  // namespace detail
+
+}  // namespace S21
+
+#endif  // S21_LU_HPP_
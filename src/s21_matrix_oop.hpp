@@ -1,27 +1,103 @@
 #ifndef S21_MATRIX_OOP_HPP_
 #define S21_MATRIX_OOP_HPP_
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <random>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+#include "s21_expression.hpp"
+#include "s21_gemm.hpp"
+#include "s21_instrumentation.hpp"
+#include "s21_memory.hpp"
+#include "s21_simd.hpp"
+#include "s21_transpose.hpp"
+#include "s21_view.hpp"
+
+#ifndef S21_INVERSE_PARALLEL
+#define S21_INVERSE_PARALLEL 256  // Order from which InverseMatrix uses LU
+#endif
+
 static constexpr double EPSILON = 1e-6;
 
 namespace S21 {
 
+template <typename T>
+class LU;
+
+template <typename T>
+class S21MappedMatrix;
+
+struct CompareOptions;
+
 /// @brief A class representing a matrix with dynamic memory allocation.
 /// @tparam T The type of the matrix elements.
 /// @note T must be an arithmetic type.
 template <typename T = double>
-class S21Matrix {
+class S21Matrix : public MatrixExpression<S21Matrix<T>> {
   static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
-  using matrix_t = std::vector<std::vector<T>>;
+
+ public:
+  using value_type = T;
+
+  /// @brief Alignment in bytes of the first element of every matrix buffer.
+  /// @note Matches a cache line, which is also wide enough for any SIMD load.
+  static constexpr std::size_t kAlignment = 64;
+
+  /// @brief Lightweight non-owning view of a single matrix row.
+  /// @note Returned by `operator[]` so that `matrix[i][j]` keeps working on
+  /// top of the contiguous storage. The view is invalidated by any operation
+  /// that reallocates the matrix.
+  /// @tparam U `T` for mutable rows, `const T` for read-only rows.
+  template <typename U>
+  class RowView {
+   public:
+    RowView(U *data, std::size_t size) : data_(data), size_(size) {}
+
+    U &operator[](std::size_t col) const { return data_[col]; }
+    U *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    U *begin() const { return data_; }
+    U *end() const { return data_ + size_; }
+
+   private:
+    U *data_;
+    std::size_t size_;
+  };
 
  private:
   std::size_t rows_ = 0;
-  std::size_t cols_ = 0;  // Rows and columns
-  matrix_t matrix_;       // Pointer to the memory where the matrix is allocated
+  std::size_t cols_ = 0;    // Rows and columns
+  std::size_t stride_ = 0;  // Distance in elements between consecutive rows
+  T *data_ = nullptr;       // Contiguous row-major buffer of rows_ * stride_
+  std::pmr::memory_resource *resource_;  // Where data_ comes from
+
+  static std::size_t BufferBytes(std::size_t count);
+  static T *Allocate(std::size_t rows, std::size_t cols,
+                     std::pmr::memory_resource *resource, Operation purpose);
+  void Release() noexcept;
+
+  // Allocates the buffer, accounted to `purpose` outside of an operation.
+  S21Matrix(std::size_t rows, std::size_t cols,
+            std::pmr::memory_resource *resource, Operation purpose);
+
+  template <typename E>
+  void Evaluate(const E &expr);
+
+  template <typename U>
+  friend class S21MappedMatrix;
+
+  // Takes over `data`, rows * cols elements that `resource` releases.
+  S21Matrix(std::size_t rows, std::size_t cols, T *data,
+            std::pmr::memory_resource *resource) noexcept;
 
  public:
   /// @brief Default constructor.
@@ -31,21 +107,72 @@ class S21Matrix {
   /// @brief Constructor with specified dimensions.
   /// @param rows Number of rows.
   /// @param cols Number of columns.
-  S21Matrix(std::size_t rows, std::size_t cols);
+  /// @param resource Memory resource the buffer is allocated from; it must
+  /// outlive the matrix.
+  S21Matrix(std::size_t rows, std::size_t cols,
+            std::pmr::memory_resource *resource =
+                std::pmr::get_default_resource());
 
   /// @brief Copy constructor.
+  /// @note Like std::pmr containers, the copy uses the default memory
+  /// resource rather than the one of `other`.
   /// @param other The S21Matrix object to be copied.
   S21Matrix(const S21Matrix &other);
 
+  /// @brief Copies a matrix into the provided memory resource.
+  /// @param other The S21Matrix object to be copied.
+  /// @param resource Memory resource the copy is allocated from.
+  S21Matrix(const S21Matrix &other, std::pmr::memory_resource *resource);
+
+  /// @brief Converts a matrix of another element type, e.g. float to double.
+  /// @note Each element is converted with static_cast, so narrowing rounds
+  /// to nearest and values beyond the range of T become infinite.
+  /// @param other The matrix to be converted.
+  /// @param resource Memory resource the result is allocated from.
+  template <typename U, typename = std::enable_if_t<!std::is_same_v<U, T>>>
+  explicit S21Matrix(const S21Matrix<U> &other,
+                     std::pmr::memory_resource *resource =
+                         std::pmr::get_default_resource());
+
   /// @brief Move constructor.
+  /// @note The buffer is taken over together with its memory resource.
   /// @param other The S21Matrix object to be moved.
   S21Matrix(S21Matrix &&other) noexcept;
 
+  /// @brief Evaluates a matrix expression into a new matrix.
+  /// @note The whole expression is computed in a single pass over the new
+  /// buffer, without intermediate matrices.
+  /// @param expr The expression to evaluate, e.g. `a + b * 2.0 - c`.
+  /// @param resource Memory resource the result is allocated from.
+  template <typename E, typename = std::enable_if_t<
+                            std::is_same_v<typename E::value_type, T>>>
+  S21Matrix(const MatrixExpression<E> &expr,
+            std::pmr::memory_resource *resource =
+                std::pmr::get_default_resource());
+
   /// @brief Destructor.
   ~S21Matrix();
 
-  std::vector<T> &operator[](std::size_t row);
-  const std::vector<T> &operator[](std::size_t row) const;
+  RowView<T> operator[](std::size_t row);
+  RowView<const T> operator[](std::size_t row) const;
+
+  /// @brief Gets the raw row-major storage of the matrix.
+  /// @note Element (i, j) lives at `Data()[i * Stride() + j]`.
+  /// @return Pointer to the first element, aligned to `kAlignment` bytes, or
+  /// nullptr for an empty matrix.
+  T *Data() noexcept;
+  const T *Data() const noexcept;
+
+  /// @brief Gets the memory resource the buffer is allocated from.
+  /// @note Matrices returned by const operations such as Transpose(),
+  /// GetMinor() or InverseMatrix(), and copies assigned into this matrix,
+  /// use the same resource.
+  std::pmr::memory_resource *GetResource() const noexcept;
+
+  /// @brief Gets the leading dimension of the storage.
+  /// @return The distance in elements between the starts of two consecutive
+  /// rows. Never less than GetCols().
+  std::size_t Stride() const noexcept;
 
   /// @brief Prints the contents of the matrix to the console.
   /// @note Used to display the current state of the matrix by printing its
@@ -63,8 +190,16 @@ class S21Matrix {
   /// @brief Checks if two S21Matrix objects are equal.
   /// @note Compares the dimensions and elements of two S21Matrix objects to
   /// determine if they are equal.
+  /// @note Elements are considered equal when they differ by at most EPSILON.
+  /// @note Large matrices are compared on several threads, see Compare().
   bool EqMatrix(const S21Matrix &other) const;
 
+  /// @brief Checks if two S21Matrix objects are equal within a relative,
+  /// absolute or ULP tolerance.
+  /// @param options The comparison mode and its tolerance.
+  /// @see Compare() in s21_compare.hpp, which also accepts views.
+  bool EqMatrix(const S21Matrix &other, const CompareOptions &options) const;
+
   /// @brief Adds the elements of the provided S21Matrix object to the current
   /// S21Matrix object.
   /// @note Performs an element-wise addition of the elements of the provided
@@ -92,6 +227,9 @@ class S21Matrix {
   /// @note The number of columns in the current S21Matrix object must be equal
   /// to the number of rows in the provided S21Matrix object for the operation
   /// to succeed.
+  /// @note Large products run through the packed, cache-blocked kernel from
+  /// s21_gemm.hpp, split into tiles across ThreadPool::Instance() once they
+  /// are big enough to pay for it.
   void MulMatrix(const S21Matrix &other);
 
   /// @brief Transposes the current S21Matrix object.
@@ -99,9 +237,25 @@ class S21Matrix {
   /// S21Matrix object.
   /// @note The transpose of a matrix is obtained by interchanging the rows and
   /// columns of the matrix.
+  /// @note Works for any shape. The copy is cache-oblivious and split across
+  /// ThreadPool::Instance() for large matrices.
   /// @return A new S21Matrix object that is the transpose of the current
   /// S21Matrix object.
-  S21Matrix Transpose();
+  S21Matrix Transpose() const &;
+
+  /// @brief Transposes a temporary S21Matrix object.
+  /// @note Square matrices are transposed in place and their buffer is
+  /// reused, so `std::move(m).Transpose()` does not allocate. Rectangular
+  /// ones are copied, which is faster than following permutation cycles.
+  /// @return The transpose of the matrix.
+  S21Matrix Transpose() &&;
+
+  /// @brief Replaces the current S21Matrix object by its transpose without
+  /// allocating a new buffer.
+  /// @note Square matrices swap mirrored tiles. Rectangular ones follow the
+  /// cycles of the transposition permutation, which needs one bit of scratch
+  /// per element but scatters accesses across the whole buffer.
+  void TransposeInPlace();
 
   /// @brief Calculates the matrix of cofactors (complements) of the current
   /// S21Matrix object.
@@ -111,6 +265,11 @@ class S21Matrix {
   /// formed by deleting the row and column containing that element, multiplied
   /// by (-1)^(i+j), where i is the row index and j is the column index of the
   /// element.
+  /// @note Computed in O(n^3) from a single factorization: as det(A) * A^-T
+  /// for invertible matrices, and through a rank-aware complete-pivoting LU
+  /// for singular ones, where the result has rank one or is zero.
+  /// @note Integer matrices are processed as long double and the cofactors
+  /// rounded to the nearest integer.
   /// @return A new S21Matrix object that is the matrix of cofactors
   /// (complements) of the current S21Matrix object.
   S21Matrix CalcComplements();
@@ -121,6 +280,10 @@ class S21Matrix {
   /// and is calculated based on the values of the matrix elements.
   /// @note The determinant can be used to determine various properties of the
   /// matrix, such as whether it is invertible.
+  /// @note Computed from an LU factorization with partial pivoting; build an
+  /// LU object directly to reuse the factorization for solves or the inverse.
+  /// @note Integer matrices are factored as long double and the determinant
+  /// rounded to the nearest integer.
   /// @return The determinant of the current S21Matrix object.
   T Determinant();
 
@@ -131,46 +294,25 @@ class S21Matrix {
   /// the original matrix, results in the identity matrix.
   /// @note The inverse of a matrix only exists if the determinant of the matrix
   /// is non-zero.
+  /// @note Runs in O(n^3): matrices below order S21_INVERSE_PARALLEL are
+  /// inverted by InvertMatrix() on a copy, larger ones through an LU
+  /// factorization whose solves against the identity are spread over
+  /// ThreadPool::Instance().
+  /// @note Integer matrices are inverted as long double and the result
+  /// rounded to the nearest integer.
   /// @return A new S21Matrix object that is the inverse of the current
-  /// S21Matrix object, or an empty matrix if the current matrix is not
-  /// invertible.
+  /// S21Matrix object.
+  /// @throw std::runtime_error if the current matrix is not invertible.
   S21Matrix InverseMatrix();
 
-  /// @brief Adds two S21Matrix objects together.
-  /// @note Adds the elements of the current S21Matrix object to the elements of
-  /// the provided S21Matrix object, and returns a new S21Matrix object that is
-  /// the result of the addition.
-  /// @param other The S21Matrix object to add to the current object.
-  /// @return A new S21Matrix object that is the result of adding the current
-  /// object to the provided object.
-  S21Matrix operator+(const S21Matrix &other);
-
-  /// @brief Subtracts two S21Matrix objects.
-  /// @note Subtracts the elements of the provided S21Matrix object from the
-  /// elements of the current S21Matrix object, and returns a new S21Matrix
-  /// object that is the result of the subtraction.
-  /// @param other The S21Matrix object to subtract from the current object.
-  /// @return A new S21Matrix object that is the result of subtracting the
-  /// provided object from the current object.
-  S21Matrix operator-(const S21Matrix &other);
-
-  /// @brief Multiplies the current S21Matrix object by a scalar value.
-  /// @note Multiplies each element of the current S21Matrix object by the
-  /// provided scalar value, and returns a new S21Matrix object that is the
-  /// result of the multiplication.
-  /// @param num The scalar value to multiply the matrix by.
-  /// @return A new S21Matrix object that is the result of multiplying the
-  /// current object by the provided scalar value.
-  S21Matrix operator*(const T num);
-
-  /// @brief Multiplies two S21Matrix objects.
-  /// @note Multiplies the elements of the current S21Matrix object by the
-  /// elements of the provided S21Matrix object, and returns a new S21Matrix
-  /// object that is the result of the multiplication.
-  /// @param other The S21Matrix object to multiply with the current object.
-  /// @return A new S21Matrix object that is the result of multiplying the
-  /// current object by the provided object.
-  S21Matrix operator*(const S21Matrix &other);
+  /// @brief Replaces the current S21Matrix object with its inverse.
+  /// @note Gauss-Jordan elimination with partial pivoting performed in the
+  /// matrix's own buffer, so no other matrix-sized storage is allocated.
+  /// @note If the matrix turns out not to be invertible its contents are left
+  /// partially eliminated.
+  /// @note Integer matrices are replaced by InverseMatrix() instead.
+  /// @throw std::runtime_error if the matrix is not square or not invertible.
+  void InvertMatrix();
 
   /// @brief Compares two S21Matrix objects for equality.
   /// @note Compares the elements of the current S21Matrix object with the
@@ -178,7 +320,7 @@ class S21Matrix {
   /// returns true, otherwise it returns false.
   /// @param other The S21Matrix object to compare with the current object.
   /// @return true if the two S21Matrix objects are equal, false otherwise.
-  bool operator==(const S21Matrix &other);
+  bool operator==(const S21Matrix &other) const;
 
   /// @brief Assignment operator for S21Matrix.
   /// @note Assigns the contents of the provided S21Matrix object to the current
@@ -198,21 +340,34 @@ class S21Matrix {
   /// assignment.
   S21Matrix &operator=(S21Matrix &&other) noexcept;
 
+  /// @brief Assigns the value of a matrix expression to the current object.
+  /// @note Evaluated in one fused pass. The expression may refer to the
+  /// current object itself, e.g. `a = a * 2.0 + b`.
+  /// @param expr The expression to evaluate.
+  /// @return A reference to the current S21Matrix object after the
+  /// assignment.
+  template <typename E>
+  S21Matrix &operator=(const MatrixExpression<E> &expr);
+
   /// @brief Addition assignment operator for S21Matrix.
   /// @note Adds the elements of the provided S21Matrix object to the elements
   /// of the current S21Matrix object, and assigns the result back to the
   /// current object.
-  /// @param other The S21Matrix object to add to the current object.
+  /// @param other The S21Matrix object or expression to add to the current
+  /// object.
   /// @return A reference to the current S21Matrix object after the addition.
-  S21Matrix &operator+=(const S21Matrix &other);
+  template <typename E>
+  S21Matrix &operator+=(const MatrixExpression<E> &other);
 
   /// @brief Subtraction assignment operator for S21Matrix.
   /// @note Subtracts the elements of the provided S21Matrix object from the
   /// elements of the current S21Matrix object, and assigns the result back to
   /// the current object.
-  /// @param other The S21Matrix object to subtract from the current object.
+  /// @param other The S21Matrix object or expression to subtract from the
+  /// current object.
   /// @return A reference to the current S21Matrix object after the subtraction.
-  S21Matrix &operator-=(const S21Matrix &other);
+  template <typename E>
+  S21Matrix &operator-=(const MatrixExpression<E> &other);
 
   /// @brief Multiplication assignment operator for S21Matrix.
   /// @note Multiplies the elements of the current S21Matrix object by the
@@ -238,6 +393,13 @@ class S21Matrix {
   /// @param j The column index of the element to access.
   /// @return A reference to the element at the specified row and column.
   T &operator()(std::size_t row, std::size_t col);
+  const T &operator()(std::size_t row, std::size_t col) const;
+
+  /// @brief Reads an element without bounds checking.
+  /// @note Leaf access used when evaluating matrix expressions.
+  T Coeff(std::size_t row, std::size_t col) const {
+    return data_[row * stride_ + col];
+  }
 
   /// @brief Gets the number of rows in the S21Matrix object.
   /// @return The number of rows in the S21Matrix object.
@@ -256,10 +418,44 @@ class S21Matrix {
   void SetCols(std::size_t cols);
 
   /// @brief Gets the minor matrix of the current S21Matrix object.
+  /// @note Copies the minor; use GetMinorView() when it is only read.
   /// @param row The row index to remove from the current matrix.
   /// @param col The column index to remove from the current matrix.
   /// @return The minor matrix of the current S21Matrix object.
-  S21Matrix GetMinor(std::size_t row, std::size_t col);
+  S21Matrix GetMinor(std::size_t row, std::size_t col) const;
+
+  /// @brief Views the minor matrix without copying it.
+  /// @param row The row index to leave out.
+  /// @param col The column index to leave out.
+  /// @return A read-only view of the other elements.
+  /// @throw std::out_of_range if the index is out of range.
+  S21MinorView<T> GetMinorView(std::size_t row, std::size_t col) const;
+
+  /// @brief Views a rectangular block of the matrix in place.
+  /// @param row The row of the top-left element of the block.
+  /// @param col The column of the top-left element of the block.
+  /// @param rows The number of rows of the block.
+  /// @param cols The number of columns of the block.
+  /// @return A view that reads and writes the elements of this matrix.
+  /// @throw std::out_of_range if the block does not fit in the matrix.
+  S21MatrixView<T> Block(std::size_t row, std::size_t col, std::size_t rows,
+                         std::size_t cols);
+  S21MatrixView<const T> Block(std::size_t row, std::size_t col,
+                               std::size_t rows, std::size_t cols) const;
+
+  /// @brief Views every `row_step`-th row and `col_step`-th column of the
+  /// matrix, starting from element (row, col).
+  /// @note `Strided(0, j, GetRows(), 1, 1, 1)` is column j.
+  /// @param rows The number of rows of the view.
+  /// @param cols The number of columns of the view.
+  /// @throw std::out_of_range if the view does not fit in the matrix.
+  S21StridedView<T> Strided(std::size_t row, std::size_t col, std::size_t rows,
+                            std::size_t cols, std::size_t row_step,
+                            std::size_t col_step);
+  S21StridedView<const T> Strided(std::size_t row, std::size_t col,
+                                  std::size_t rows, std::size_t cols,
+                                  std::size_t row_step,
+                                  std::size_t col_step) const;
 
   /// @brief Swaps the rows at the specified indices in the S21Matrix object.
   /// @param i The index of the first row to swap.
@@ -267,40 +463,242 @@ class S21Matrix {
   void SwapRows(std::size_t i, std::size_t j);
 };
 
+namespace detail {
+
+template <typename T>
+S21Matrix<T> CofactorsCompletePivoting(
+    S21Matrix<T> a,
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+/// @brief Copies an integer matrix into long double, whose 64-bit
+/// significand holds its elements exactly, for the factorizations that only
+/// work in floating point.
+template <typename T>
+S21Matrix<long double> Widen(const S21Matrix<T> &matrix) {
+  S21Matrix<long double> result(matrix.GetRows(), matrix.GetCols(),
+                                ScratchResource());
+  for (std::size_t i = 0; i < matrix.GetRows(); i++)
+    for (std::size_t j = 0; j < matrix.GetCols(); j++)
+      result(i, j) = static_cast<long double>(matrix(i, j));
+  return result;
+}
+
+/// @brief Rounds a long double value to the nearest value of the integer
+/// type T.
+template <typename T>
+T Narrow(long double value) {
+  return static_cast<T>(std::llround(value));
+}
+
+/// @brief Rounds every element of a long double matrix to the nearest value
+/// of the integer type T.
 template <typename T>
-S21Matrix<T>::S21Matrix(std::size_t rows, std::size_t cols)
-    : rows_(rows), cols_(cols), matrix_(rows_, std::vector<T>(cols_)){};
+S21Matrix<T> Narrow(const S21Matrix<long double> &matrix,
+                    std::pmr::memory_resource *resource) {
+  S21Matrix<T> result(matrix.GetRows(), matrix.GetCols(), resource);
+  for (std::size_t i = 0; i < matrix.GetRows(); i++)
+    for (std::size_t j = 0; j < matrix.GetCols(); j++)
+      result(i, j) = Narrow<T>(matrix(i, j));
+  return result;
+}
+
+/// @brief Gives a matrix operand of an eager operation: matrices are used as
+/// they are, other expressions are evaluated into a scratch temporary.
+template <typename T>
+const S21Matrix<T> &Materialize(const S21Matrix<T> &matrix) {
+  return matrix;
+}
+
+template <typename T>
+S21MatrixView<const T> Materialize(const S21MatrixView<T> &view) {
+  return view;
+}
+
+template <typename E>
+S21Matrix<typename E::value_type> Materialize(const MatrixExpression<E> &expr) {
+  return S21Matrix<typename E::value_type>(expr, ScratchResource());
+}
+
+/// @brief Memory resource for the result of an eager operation: the one of
+/// its left operand when that is a matrix, the default one otherwise.
+template <typename T>
+std::pmr::memory_resource *ResultResource(const S21Matrix<T> &matrix) {
+  return matrix.GetResource();
+}
+
+template <typename E>
+std::pmr::memory_resource *ResultResource(const MatrixExpression<E> &) {
+  return std::pmr::get_default_resource();
+}
+
+}  // namespace detail
+
+// Buffers are whole cache lines, which also keeps pool resources that
+// bucket by size from handing out blocks with a weaker alignment.
+template <typename T>
+std::size_t S21Matrix<T>::BufferBytes(std::size_t count) {
+  return (count * sizeof(T) + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+template <typename T>
+T *S21Matrix<T>::Allocate(std::size_t rows, std::size_t cols,
+                          std::pmr::memory_resource *resource,
+                          [[maybe_unused]] Operation purpose) {
+  constexpr std::size_t kMaxElements =
+      static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max()) /
+      sizeof(T);
+  if (cols != 0 && rows > kMaxElements / cols)
+    throw std::length_error("Matrix dimensions are too large");
+  std::size_t count = rows * cols;
+  if (count == 0) return nullptr;
+  T *data =
+      static_cast<T *>(resource->allocate(BufferBytes(count), kAlignment));
+  std::uninitialized_value_construct_n(data, count);
+  S21_INSTRUMENT_ALLOCATION(BufferBytes(count), purpose);
+  return data;
+}
+
+template <typename T>
+void S21Matrix<T>::Release() noexcept {
+  if (data_)
+    resource_->deallocate(data_, BufferBytes(rows_ * stride_), kAlignment);
+  data_ = nullptr;
+}
+
+template <typename T>
+S21Matrix<T>::S21Matrix(std::size_t rows, std::size_t cols,
+                        std::pmr::memory_resource *resource, Operation purpose)
+    : rows_(rows),
+      cols_(cols),
+      stride_(cols),
+      data_(Allocate(rows, cols, resource, purpose)),
+      resource_(resource) {}
+
+template <typename T>
+S21Matrix<T>::S21Matrix(std::size_t rows, std::size_t cols,
+                        std::pmr::memory_resource *resource)
+    : S21Matrix(rows, cols, resource, Operation::kConstruct) {}
+
+template <typename T>
+S21Matrix<T>::S21Matrix(std::size_t rows, std::size_t cols, T *data,
+                        std::pmr::memory_resource *resource) noexcept
+    : rows_(rows),
+      cols_(cols),
+      stride_(cols),
+      data_(data),
+      resource_(resource) {}
 
 template <typename T>
 S21Matrix<T>::S21Matrix() : S21Matrix(2, 2){};
 
 template <typename T>
 S21Matrix<T>::S21Matrix(const S21Matrix<T> &other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {}
+    : S21Matrix(other, std::pmr::get_default_resource()) {}
+
+template <typename T>
+S21Matrix<T>::S21Matrix(const S21Matrix<T> &other,
+                        std::pmr::memory_resource *resource)
+    : S21Matrix(other.rows_, other.cols_, resource, Operation::kCopy) {
+  S21_INSTRUMENT(kCopy, 0);
+  for (std::size_t i = 0; i < rows_; i++)
+    std::copy_n(other.data_ + i * other.stride_, cols_, data_ + i * stride_);
+}
+
+template <typename T>
+template <typename U, typename>
+S21Matrix<T>::S21Matrix(const S21Matrix<U> &other,
+                        std::pmr::memory_resource *resource)
+    : S21Matrix(other.GetRows(), other.GetCols(), resource, Operation::kCopy) {
+  S21_INSTRUMENT(kCopy, 0);
+  for (std::size_t i = 0; i < rows_; i++) {
+    const U *src = other.Data() + i * other.Stride();
+    std::transform(src, src + cols_, data_ + i * stride_,
+                   [](U value) { return static_cast<T>(value); });
+  }
+}
+
+template <typename T>
+template <typename E, typename>
+S21Matrix<T>::S21Matrix(const MatrixExpression<E> &expr,
+                        std::pmr::memory_resource *resource)
+    : S21Matrix(expr.Self().GetRows(), expr.Self().GetCols(), resource,
+                Operation::kEvaluate) {
+  Evaluate(expr.Self());
+}
+
+template <typename T>
+template <typename E>
+void S21Matrix<T>::Evaluate(const E &expr) {
+  S21_INSTRUMENT(kEvaluate, 0);
+  if constexpr (std::is_same_v<E, S21MatrixView<T>> ||
+                std::is_same_v<E, S21MatrixView<const T>>) {
+    for (std::size_t i = 0; i < rows_; i++) {
+      const T *src = expr.Data() + i * expr.Stride();
+      T *dst = data_ + i * stride_;
+      if (src != dst) std::copy_n(src, cols_, dst);
+    }
+    return;
+  } else if constexpr (std::is_same_v<E, S21MinorView<T>>) {
+    return expr.CopyTo(data_, stride_);  // Two block copies per row
+  }
+  for (std::size_t i = 0; i < rows_; i++) {
+    T *dst = data_ + i * stride_;
+    for (std::size_t j = 0; j < cols_; j++) dst[j] = expr.Coeff(i, j);
+  }
+}
 
 template <typename T>
 S21Matrix<T>::S21Matrix(S21Matrix<T> &&other) noexcept
     : rows_(other.rows_),
       cols_(other.cols_),
-      matrix_(std::move(other.matrix_)) {}
+      stride_(other.stride_),
+      data_(other.data_),
+      resource_(other.resource_) {
+  other.rows_ = other.cols_ = other.stride_ = 0;
+  other.data_ = nullptr;
+}
 
 template <typename T>
-S21Matrix<T>::~S21Matrix() = default;
+S21Matrix<T>::~S21Matrix() {
+  Release();
+}
+
+template <typename T>
+typename S21Matrix<T>::template RowView<T> S21Matrix<T>::operator[](
+    std::size_t row) {
+  return RowView<T>(data_ + row * stride_, cols_);
+}
+
+template <typename T>
+typename S21Matrix<T>::template RowView<const T> S21Matrix<T>::operator[](
+    std::size_t row) const {
+  return RowView<const T>(data_ + row * stride_, cols_);
+}
+
+template <typename T>
+T *S21Matrix<T>::Data() noexcept {
+  return data_;
+}
+
+template <typename T>
+const T *S21Matrix<T>::Data() const noexcept {
+  return data_;
+}
 
 template <typename T>
-std::vector<T> &S21Matrix<T>::operator[](std::size_t row) {
-  return matrix_[row];
+std::pmr::memory_resource *S21Matrix<T>::GetResource() const noexcept {
+  return resource_;
 }
 
 template <typename T>
-const std::vector<T> &S21Matrix<T>::operator[](std::size_t row) const {
-  return matrix_[row];
+std::size_t S21Matrix<T>::Stride() const noexcept {
+  return stride_;
 }
 
 template <typename T>
 void S21Matrix<T>::PrintMatrix() const {
-  for (const auto &row : matrix_) {
-    for (const auto &value : row) {
+  for (std::size_t i = 0; i < rows_; i++) {
+    for (const auto &value : (*this)[i]) {
       std::cout << value << " ";
     }
     std::cout << '\n';
@@ -312,8 +710,8 @@ void S21Matrix<T>::RandomizeMatrix() {
   static std::random_device rd;
   static std::mt19937 gen(rd());
   std::uniform_real_distribution<T> dis(__DBL_MIN__, __DBL_MAX__);
-  for (auto &row : matrix_) {
-    for (auto &element : row) {
+  for (std::size_t i = 0; i < rows_; i++) {
+    for (auto &element : (*this)[i]) {
       element = dis(gen);
     }
   }
@@ -321,190 +719,308 @@ void S21Matrix<T>::RandomizeMatrix() {
 
 template <typename T>
 bool S21Matrix<T>::EqMatrix(const S21Matrix<T> &other) const {
-  return matrix_ == other.matrix_;
+  return Compare(*this, other);  // Absolute, EPSILON, 0 for integer types
+}
+
+template <typename T>
+bool S21Matrix<T>::EqMatrix(const S21Matrix<T> &other,
+                            const CompareOptions &options) const {
+  return Compare(*this, other, options);
 }
 
 template <typename T>
 void S21Matrix<T>::SumMatrix(const S21Matrix<T> &other) {
+  S21_INSTRUMENT(kSumMatrix, rows_ * cols_);
   if (rows_ != other.rows_ || cols_ != other.cols_)
     throw std::runtime_error("Matrices dimensions are not equal");
 
-  for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < cols_; j++) {
-      matrix_[i][j] += other.matrix_[i][j];
-    }
-  }
+  if (stride_ == cols_ && other.stride_ == cols_)
+    return simd::Add(data_, other.data_, rows_ * cols_);
+  for (std::size_t i = 0; i < rows_; i++)
+    simd::Add(data_ + i * stride_, other.data_ + i * other.stride_, cols_);
 }
 
 template <typename T>
 void S21Matrix<T>::SubMatrix(const S21Matrix<T> &other) {
+  S21_INSTRUMENT(kSubMatrix, rows_ * cols_);
   if (rows_ != other.rows_ || cols_ != other.cols_)
     throw std::runtime_error("Matrices dimensions are not equal");
 
-  for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < cols_; j++) {
-      matrix_[i][j] -= other.matrix_[i][j];
-    }
-  }
+  if (stride_ == cols_ && other.stride_ == cols_)
+    return simd::Sub(data_, other.data_, rows_ * cols_);
+  for (std::size_t i = 0; i < rows_; i++)
+    simd::Sub(data_ + i * stride_, other.data_ + i * other.stride_, cols_);
 }
 
 template <typename T>
 void S21Matrix<T>::MulNumber(const T num) {
-  for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < cols_; j++) {
-      matrix_[i][j] *= num;
-    }
-  }
+  S21_INSTRUMENT(kMulNumber, rows_ * cols_);
+  if (stride_ == cols_) return simd::Scale(data_, num, rows_ * cols_);
+  for (std::size_t i = 0; i < rows_; i++)
+    simd::Scale(data_ + i * stride_, num, cols_);
 }
 
 template <typename T>
 void S21Matrix<T>::MulMatrix(const S21Matrix<T> &other) {
+  S21_INSTRUMENT(kMulMatrix, 2 * rows_ * cols_ * other.cols_);
   if (cols_ != other.rows_)
     throw std::runtime_error(
         "Matrix dimensions are incompatible for multiplication");
-  S21Matrix<T> result(rows_, other.cols_);
-  for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < other.cols_; j++) {
-      T sum = 0;
-      for (std::size_t k = 0; k < cols_; k++)
-        sum += matrix_[i][k] * other.matrix_[k][j];
-      result.matrix_[i][j] = sum;
-    }
-  }
+  S21Matrix<T> result(rows_, other.cols_, resource_);
+  detail::Gemm(rows_, other.cols_, cols_, T(1), data_, stride_, other.data_,
+               other.stride_, T(0), result.data_, result.stride_);
   *this = std::move(result);
 }
 
 template <typename T>
-S21Matrix<T> S21Matrix<T>::Transpose() {
-  if (rows_ != cols_)
-    throw std::runtime_error("Matrix must be square to be transposed");
-  S21Matrix<T> result(cols_, rows_);
-  for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < cols_; j++) {
-      result.matrix_[j][i] = matrix_[i][j];
-    }
+S21Matrix<T> S21Matrix<T>::Transpose() const & {
+  S21_INSTRUMENT(kTranspose, 0);
+  S21Matrix<T> result(cols_, rows_, resource_);
+  detail::TransposeCopy(rows_, cols_, data_, stride_, result.data_,
+                        result.stride_);
+  return result;
+}
+
+template <typename T>
+S21Matrix<T> S21Matrix<T>::Transpose() && {
+  S21_INSTRUMENT(kTranspose, 0);
+  if (rows_ != cols_) {
+    const S21Matrix &self = *this;
+    return self.Transpose();
   }
+  TransposeInPlace();
+  return std::move(*this);
+}
 
-  return result;
+template <typename T>
+void S21Matrix<T>::TransposeInPlace() {
+  S21_INSTRUMENT(kTransposeInPlace, 0);
+  if (rows_ == cols_) {
+    detail::TransposeSquareInPlace(rows_, data_, stride_);
+  } else {
+    detail::TransposeCyclesInPlace(rows_, cols_, data_);
+    std::swap(rows_, cols_);
+    stride_ = cols_;
+  }
 }
 
 template <typename T>
 S21Matrix<T> S21Matrix<T>::CalcComplements() {
+  S21_INSTRUMENT(kCalcComplements, 8 * rows_ * rows_ * rows_ / 3);
   if (rows_ != cols_ || rows_ < 2)
     throw std::runtime_error("Matrix must be square and have at least 2 rows");
 
-  S21Matrix<T> result(rows_, cols_);
-
-  for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < cols_; j++) {
-      S21Matrix<T> minor = GetMinor(i, j);
-      T minor_det = minor.Determinant();
-      result.matrix_[i][j] = pow(-1, i + j) * minor_det;
+  if constexpr (std::is_integral_v<T>) {
+    return detail::Narrow<T>(detail::Widen(*this).CalcComplements(),
+                             resource_);
+  } else {
+    // The factors and the inverse are scratch; only the result is kept.
+    LU<T> lu(S21Matrix<T>(*this, ScratchResource()));
+    if (lu.IsSingular())
+      return detail::CofactorsCompletePivoting(
+          S21Matrix<T>(*this, ScratchResource()), resource_);
+
+    // C = det(A) * A^-T
+    const T det = lu.Determinant();
+    const S21Matrix<T> inverse = lu.Inverse();
+    S21Matrix<T> result(rows_, cols_, resource_);
+    for (std::size_t i = 0; i < rows_; i++) {
+      for (std::size_t j = 0; j < cols_; j++) {
+        result.data_[i * result.stride_ + j] =
+            det * inverse.data_[j * inverse.stride_ + i];
+      }
     }
-  }
 
-  return result;
+    return result;
+  }
 }
 
 template <typename T>
 T S21Matrix<T>::Determinant() {
+  S21_INSTRUMENT(kDeterminant, 2 * rows_ * rows_ * rows_ / 3);
   if (rows_ != cols_)
     throw std::runtime_error("Matrices dimensions are not equal");
 
-  long double l_result = 1.0;
-  S21Matrix<T> temp(*this);
-
-  std::size_t n = temp.rows_;
-  for (std::size_t i = 0; i < n; ++i) {
-    if (std::abs(temp.matrix_[i][i]) < EPSILON) {
-      std::size_t j = i + 1;
-      while (j < n && std::abs(temp.matrix_[j][i]) < EPSILON) ++j;
-      if (j < n) {
-        temp.SwapRows(i, j);
-        l_result *= -1;
-      } else {
-        l_result = 0;
-        break;
-      }
-    }
-    T diag_elem = temp.matrix_[i][i];
-    if (std::abs(diag_elem) > EPSILON) {
-      l_result *= diag_elem;
-      for (std::size_t k = 0; k < n; ++k) {
-        temp.matrix_[i][k] /= diag_elem;
-      }
-      for (std::size_t j = 0; j < n; ++j) {
-        if (j != i) {
-          long double multiplier = temp.matrix_[j][i];
-          for (std::size_t k = 0; k < n; ++k) {
-            temp.matrix_[j][k] -= (T)(multiplier * temp.matrix_[i][k]);
-          }
-        }
-      }
-    }
-  }
-
-  if (std::abs(l_result) > std::numeric_limits<double>::max())
-    throw std::overflow_error("Value exceeds DBL_MAX");
+  if constexpr (std::is_integral_v<T>)
+    return detail::Narrow<T>(detail::Widen(*this).Determinant());
   else
-    return (T)l_result;
+    return LU<T>(S21Matrix<T>(*this, ScratchResource())).Determinant();
 }
 
 template <typename T>
 S21Matrix<T> S21Matrix<T>::InverseMatrix() {
-  T det = Determinant();
-  if (det == 0) throw std::runtime_error("Matrix is not invertible");
-
-  S21Matrix<T> result{rows_, cols_};
-  if (rows_ == 1)
-    result.matrix_[0][0] = 1.0 / matrix_[0][0];
-  else {
-    result = CalcComplements().Transpose();
-    result.MulNumber(1.0 / det);
+  S21_INSTRUMENT(kInverseMatrix, 2 * rows_ * rows_ * rows_);
+  if (rows_ != cols_)
+    throw std::runtime_error("Matrix must be square to be inverted");
+
+  if constexpr (std::is_integral_v<T>) {
+    return detail::Narrow<T>(detail::Widen(*this).InverseMatrix(), resource_);
+  } else {
+    if (rows_ >= S21_INVERSE_PARALLEL) {
+      LU<T> lu(*this);
+      if (lu.IsSingular())
+        throw std::runtime_error("Matrix is not invertible");
+      return lu.Inverse();
+    }
+    S21Matrix<T> result(*this, resource_);
+    result.InvertMatrix();
+    return result;
   }
-  return result;
 }
 
 template <typename T>
-S21Matrix<T> S21Matrix<T>::operator+(const S21Matrix<T> &other) {
-  S21Matrix<T> result(*this);
-  result.SumMatrix(other);
+void S21Matrix<T>::InvertMatrix() {
+  S21_INSTRUMENT(kInvertMatrix, 2 * rows_ * rows_ * rows_);
+  if (rows_ != cols_)
+    throw std::runtime_error("Matrix must be square to be inverted");
+  if constexpr (std::is_integral_v<T>) {
+    *this = InverseMatrix();
+    return;
+  }
+
+  const std::size_t n = rows_;
+  std::vector<std::size_t> swaps(n);
+  for (std::size_t k = 0; k < n; k++) {
+    std::size_t pivot = k;
+    for (std::size_t i = k + 1; i < n; i++)
+      if (std::abs(data_[i * stride_ + k]) >
+          std::abs(data_[pivot * stride_ + k]))
+        pivot = i;
+    if (std::abs(data_[pivot * stride_ + k]) < EPSILON)
+      throw std::runtime_error("Matrix is not invertible");
+    SwapRows(k, pivot);
+    swaps[k] = pivot;
+
+    // The pivot column of the identity is built in place of column k.
+    T *pivot_row = data_ + k * stride_;
+    const T inv_pivot = T(1) / pivot_row[k];
+    pivot_row[k] = T(1);
+    for (std::size_t j = 0; j < n; j++) pivot_row[j] *= inv_pivot;
+    for (std::size_t i = 0; i < n; i++) {
+      if (i == k) continue;
+      T *row = data_ + i * stride_;
+      const T factor = row[k];
+      row[k] = T(0);
+      for (std::size_t j = 0; j < n; j++) row[j] -= factor * pivot_row[j];
+    }
+  }
+  // Row interchanges of A are column interchanges of its inverse.
+  for (std::size_t k = n; k-- > 0;) {
+    if (swaps[k] == k) continue;
+    for (std::size_t i = 0; i < n; i++)
+      std::swap(data_[i * stride_ + k], data_[i * stride_ + swaps[k]]);
+  }
+}
+
+/// @brief Multiplies two matrices.
+/// @note Evaluated eagerly into a new matrix by the blocked GEMM. Matrices
+/// and block views are read in place; other expressions, strided and minor
+/// views included, are materialized first.
+/// @param lhs The left factor with as many columns as `rhs` has rows.
+/// @param rhs The right factor.
+/// @return A new S21Matrix object holding the product.
+template <typename L, typename R>
+S21Matrix<typename L::value_type> operator*(const MatrixExpression<L> &lhs,
+                                            const MatrixExpression<R> &rhs) {
+  using T = typename L::value_type;
+  static_assert(std::is_same_v<T, typename R::value_type>,
+                "Operands must have the same element type");
+  S21_INSTRUMENT(kProduct, 2 * lhs.Self().GetRows() * lhs.Self().GetCols() *
+                               rhs.Self().GetCols());
+  const auto &a = detail::Materialize(lhs.Self());
+  const auto &b = detail::Materialize(rhs.Self());
+  if (a.GetCols() != b.GetRows())
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  S21Matrix<T> result(a.GetRows(), b.GetCols(),
+                      detail::ResultResource(lhs.Self()));
+  detail::Gemm(a.GetRows(), b.GetCols(), a.GetCols(), T(1), a.Data(),
+               a.Stride(), b.Data(), b.Stride(), T(0), result.Data(),
+               result.Stride());
   return result;
 }
 
+/// @brief Adds an expression to a temporary matrix, reusing its buffer.
+/// @note Chosen for operands such as `std::move(a)` or the result of a
+/// function or of a matrix product, e.g. `a * b + c`: the sum is written
+/// over the temporary, so no new matrix is allocated.
+/// @return The temporary, holding the sum.
+template <typename T, typename E>
+S21Matrix<T> operator+(S21Matrix<T> &&lhs, const MatrixExpression<E> &rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+/// @brief Adds a temporary matrix to an expression, reusing its buffer.
+/// @return The temporary, holding the sum.
+template <typename T, typename E>
+S21Matrix<T> operator+(const MatrixExpression<E> &lhs, S21Matrix<T> &&rhs) {
+  rhs += lhs;
+  return std::move(rhs);
+}
+
+/// @brief Adds two temporary matrices, reusing the buffer of the first.
+/// @return The first temporary, holding the sum.
 template <typename T>
-S21Matrix<T> S21Matrix<T>::operator-(const S21Matrix<T> &other) {
-  S21Matrix<T> result(*this);
-  result.SubMatrix(other);
-  return result;
+S21Matrix<T> operator+(S21Matrix<T> &&lhs, S21Matrix<T> &&rhs) {
+  lhs += rhs;
+  return std::move(lhs);
 }
 
+/// @brief Subtracts an expression from a temporary matrix, reusing its
+/// buffer.
+/// @return The temporary, holding the difference.
+template <typename T, typename E>
+S21Matrix<T> operator-(S21Matrix<T> &&lhs, const MatrixExpression<E> &rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+/// @brief Subtracts a temporary matrix from an expression, reusing the
+/// buffer of the temporary.
+/// @return The temporary, holding the difference.
+template <typename T, typename E>
+S21Matrix<T> operator-(const MatrixExpression<E> &lhs, S21Matrix<T> &&rhs) {
+  rhs = lhs.Self() - rhs;
+  return std::move(rhs);
+}
+
+/// @brief Subtracts two temporary matrices, reusing the buffer of the first.
+/// @return The first temporary, holding the difference.
 template <typename T>
-S21Matrix<T> S21Matrix<T>::operator*(const T num) {
-  S21Matrix<T> result(*this);
-  result.MulNumber(num);
-  return result;
+S21Matrix<T> operator-(S21Matrix<T> &&lhs, S21Matrix<T> &&rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
 }
 
+/// @brief Scales a temporary matrix in place.
+/// @return The temporary, holding the scaled values.
 template <typename T>
-S21Matrix<T> S21Matrix<T>::operator*(const S21Matrix<T> &other) {
-  S21Matrix<T> result(*this);
-  result.MulMatrix(other);
-  return result;
+S21Matrix<T> operator*(S21Matrix<T> &&matrix,
+                       typename S21Matrix<T>::value_type num) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
 }
 
+/// @brief Scales a temporary matrix in place.
+/// @return The temporary, holding the scaled values.
 template <typename T>
-bool S21Matrix<T>::operator==(const S21Matrix<T> &other) {
+S21Matrix<T> operator*(typename S21Matrix<T>::value_type num,
+                       S21Matrix<T> &&matrix) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+template <typename T>
+bool S21Matrix<T>::operator==(const S21Matrix<T> &other) const {
   return EqMatrix(other);
 }
 
 template <typename T>
 S21Matrix<T> &S21Matrix<T>::operator=(const S21Matrix<T> &other) {
   if (&other != this) {
-    rows_ = other.rows_;
-    cols_ = other.cols_;
-    matrix_t tmp = other.matrix_;
-    std::swap(matrix_, tmp);
+    S21Matrix<T> tmp(other, resource_);
+    *this = std::move(tmp);
   }
   return *this;
 }
@@ -514,20 +1030,44 @@ S21Matrix<T> &S21Matrix<T>::operator=(S21Matrix<T> &&other) noexcept {
   if (this != &other) {
     std::swap(rows_, other.rows_);
     std::swap(cols_, other.cols_);
-    std::swap(matrix_, other.matrix_);
+    std::swap(stride_, other.stride_);
+    std::swap(data_, other.data_);
+    std::swap(resource_, other.resource_);
   }
   return *this;
 }
 
 template <typename T>
-S21Matrix<T> &S21Matrix<T>::operator+=(const S21Matrix<T> &other) {
-  SumMatrix(other);
+template <typename E>
+S21Matrix<T> &S21Matrix<T>::operator=(const MatrixExpression<E> &expr) {
+  const E &e = expr.Self();
+  if (e.GetRows() == rows_ && e.GetCols() == cols_) {
+    // Element (i, j) is read before it is written, so aliasing is harmless.
+    Evaluate(e);
+  } else {
+    S21Matrix<T> result(e, resource_);
+    *this = std::move(result);
+  }
   return *this;
 }
 
 template <typename T>
-S21Matrix<T> &S21Matrix<T>::operator-=(const S21Matrix<T> &other) {
-  SubMatrix(other);
+template <typename E>
+S21Matrix<T> &S21Matrix<T>::operator+=(const MatrixExpression<E> &other) {
+  if constexpr (std::is_same_v<E, S21Matrix<T>>)
+    SumMatrix(other.Self());  // Vectorized kernel
+  else
+    Evaluate(*this + other.Self());
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21Matrix<T> &S21Matrix<T>::operator-=(const MatrixExpression<E> &other) {
+  if constexpr (std::is_same_v<E, S21Matrix<T>>)
+    SubMatrix(other.Self());  // Vectorized kernel
+  else
+    Evaluate(*this - other.Self());
   return *this;
 }
 
@@ -554,24 +1094,23 @@ size_t S21Matrix<T>::GetCols() const {
 
 template <typename T>
 void S21Matrix<T>::SetRows(std::size_t rows) {
+  S21_INSTRUMENT(kSetRows, 0);
   if (rows == 0) throw std::out_of_range("Number of rows must be > 0");
-  S21Matrix<T> tmp(rows, cols_);
-  for (std::size_t i = 0; i < rows; i++) {
-    for (std::size_t j = 0; j < cols_; j++) {
-      tmp.matrix_[i][j] = (i < rows_) ? matrix_[i][j] : 0;
-    }
+  S21Matrix<T> tmp(rows, cols_, resource_);
+  for (std::size_t i = 0; i < std::min(rows, rows_); i++) {
+    std::copy_n(data_ + i * stride_, cols_, tmp.data_ + i * tmp.stride_);
   }
   *this = std::move(tmp);
 }
 
 template <typename T>
 void S21Matrix<T>::SetCols(std::size_t cols) {
+  S21_INSTRUMENT(kSetCols, 0);
   if (cols == 0) throw std::out_of_range("Number of columns must be > 0");
-  S21Matrix<T> tmp(rows_, cols);
+  S21Matrix<T> tmp(rows_, cols, resource_);
   for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < cols; j++) {
-      tmp.matrix_[i][j] = (j < cols_) ? matrix_[i][j] : 0;
-    }
+    std::copy_n(data_ + i * stride_, std::min(cols, cols_),
+                tmp.data_ + i * tmp.stride_);
   }
   *this = std::move(tmp);
 }
@@ -581,35 +1120,91 @@ T &S21Matrix<T>::operator()(std::size_t i, std::size_t j) {
   if (i >= rows_ || j >= cols_) {
     throw std::out_of_range("Row or column index out of range");
   }
-  return matrix_[i][j];
+  return data_[i * stride_ + j];
+}
+
+template <typename T>
+const T &S21Matrix<T>::operator()(std::size_t i, std::size_t j) const {
+  if (i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Row or column index out of range");
+  }
+  return data_[i * stride_ + j];
 }
 
 template <typename T>
 void S21Matrix<T>::SwapRows(std::size_t i, std::size_t j) {
-  std::swap(matrix_[i], matrix_[j]);
+  if (i == j) return;
+  std::swap_ranges(data_ + i * stride_, data_ + i * stride_ + cols_,
+                   data_ + j * stride_);
 }
 
 template <typename T>
-S21Matrix<T> S21Matrix<T>::GetMinor(std::size_t row, std::size_t col) {
-  if (row >= rows_ || col >= cols_) {
-    throw std::out_of_range("Row or column index out of range");
-  }
+S21Matrix<T> S21Matrix<T>::GetMinor(std::size_t row, std::size_t col) const {
+  S21_INSTRUMENT(kGetMinor, 0);
+  const S21MinorView<T> minor = GetMinorView(row, col);
+  S21Matrix<T> result(rows_ - 1, cols_ - 1, resource_);
+  minor.CopyTo(result.data_, result.stride_);
+  return result;
+}
 
-  S21Matrix<T> result(rows_ - 1, cols_ - 1);
+template <typename T>
+S21MinorView<T> S21Matrix<T>::GetMinorView(std::size_t row,
+                                           std::size_t col) const {
+  return S21MinorView<T>(*this, row, col);
+}
 
-  for (std::size_t i = 0, k = 0; i < rows_; ++i) {
-    if (i == row) {
-      continue;
-    }
-    for (std::size_t j = 0, l = 0; j < cols_; ++j) {
-      if (j == col) continue;
-      result.matrix_[k][l++] = matrix_[i][j];
-    }
-    ++k;
-  }
-  return result;
+template <typename T>
+S21MatrixView<T> S21Matrix<T>::Block(std::size_t row, std::size_t col,
+                                     std::size_t rows, std::size_t cols) {
+  return S21MatrixView<T>(*this).Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21MatrixView<const T> S21Matrix<T>::Block(std::size_t row, std::size_t col,
+                                           std::size_t rows,
+                                           std::size_t cols) const {
+  return S21MatrixView<const T>(*this).Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21StridedView<T> S21Matrix<T>::Strided(std::size_t row, std::size_t col,
+                                        std::size_t rows, std::size_t cols,
+                                        std::size_t row_step,
+                                        std::size_t col_step) {
+  if (!detail::FitsExtent(row, rows, row_step, rows_) ||
+      !detail::FitsExtent(col, cols, col_step, cols_))
+    throw std::out_of_range("Strided view is out of range");
+  return S21StridedView<T>(data_ + row * stride_ + col, rows, cols,
+                           row_step * stride_, col_step);
+}
+
+template <typename T>
+S21StridedView<const T> S21Matrix<T>::Strided(std::size_t row,
+                                              std::size_t col,
+                                              std::size_t rows,
+                                              std::size_t cols,
+                                              std::size_t row_step,
+                                              std::size_t col_step) const {
+  if (!detail::FitsExtent(row, rows, row_step, rows_) ||
+      !detail::FitsExtent(col, cols, col_step, cols_))
+    throw std::out_of_range("Strided view is out of range");
+  return S21StridedView<const T>(data_ + row * stride_ + col, rows, cols,
+                                 row_step * stride_, col_step);
 }
 
 }  // namespace S21
 
+#include "s21_batch.hpp"
+#include "s21_compare.hpp"
+#include "s21_fixed_matrix.hpp"
+#include "s21_io.hpp"
+#include "s21_lu.hpp"
+#include "s21_mixed_precision.hpp"
+#include "s21_out_of_core.hpp"
+#include "s21_sparse.hpp"
+#include "s21_strassen.hpp"
+#include "s21_symmetric.hpp"
+#include "s21_triangular.hpp"
+#include "s21_vector.hpp"
+
 #endif  // S21_MATRIX_OOP_HPP_
@@ -0,0 +1,54 @@
+#ifndef S21_MEMORY_HPP_
+#define S21_MEMORY_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+
+/// @file
+/// @brief Memory resources used for matrix storage.
+/// @note Every S21Matrix allocates its buffer from a
+/// std::pmr::memory_resource chosen at construction, so callers can give a
+/// request its own arena, e.g. a std::pmr::monotonic_buffer_resource, and
+/// drop every matrix of that request at once. Temporaries that never leave
+/// a library call (the copy factorized by Determinant(), the operands of a
+/// product that are expressions, ...) come from a per-thread scratch pool
+/// instead of the global heap.
+
+#ifndef S21_SCRATCH_POOL_BLOCK
+#define S21_SCRATCH_POOL_BLOCK 1048576  // Largest buffer the scratch pool keeps
+#endif
+
+namespace S21 {
+
+/// @brief Gets the calling thread's scratch resource.
+/// @note An unsynchronized pool that keeps freed buffers of up to
+/// S21_SCRATCH_POOL_BLOCK bytes for reuse; larger ones go straight to the
+/// global heap. Memory from it must be freed on the same thread.
+std::pmr::memory_resource *ScratchResource();
+
+/// @brief Returns the memory cached by the calling thread's scratch resource
+/// to the global heap.
+/// @note Only valid while no matrix allocated from the scratch resource is
+/// alive on this thread, which is always the case between library calls.
+void ReleaseScratch();
+
+namespace detail {
+
+inline std::pmr::unsynchronized_pool_resource &ScratchPool() {
+  thread_local std::pmr::unsynchronized_pool_resource pool(
+      std::pmr::pool_options{0, S21_SCRATCH_POOL_BLOCK},
+      std::pmr::new_delete_resource());
+  return pool;
+}
+
+}  // namespace detail
+
+inline std::pmr::memory_resource *ScratchResource() {
+  return &detail::ScratchPool();
+}
+
+inline void ReleaseScratch() { detail::ScratchPool().release(); }
+
+}  // namespace S21
+
+#endif  // S21_MEMORY_HPP_
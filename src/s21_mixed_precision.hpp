@@ -0,0 +1,223 @@
+#ifndef S21_MIXED_PRECISION_HPP_
+#define S21_MIXED_PRECISION_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "s21_lu.hpp"
+#include "s21_matrix_oop.hpp"
+#include "s21_vector.hpp"
+
+#ifndef S21_REFINEMENT_ITERATIONS
+#define S21_REFINEMENT_ITERATIONS 30  // Refinement steps before the fallback
+#endif
+
+/// @file
+/// @brief Linear systems solved in a lower precision and refined to full
+/// precision.
+/// @note SolveMixedPrecision() factorizes A in float, which moves half the
+/// bytes and fits twice as many elements in a SIMD register, and recovers
+/// double accuracy by iterative refinement as LAPACK's dsgesv does: the
+/// residual R = B - A * X is computed in double, the correction is solved
+/// with the float factors, and X is updated in double until the residual
+/// is at the rounding level of A * X. When that does not happen, because A
+/// is too ill-conditioned for float or out of its range, the system is
+/// solved again entirely in double.
+
+namespace S21 {
+
+/// @brief Settings of SolveMixedPrecision().
+struct RefinementOptions {
+  /// @brief Refinement steps before falling back to a full-precision
+  /// solve; 0 selects S21_REFINEMENT_ITERATIONS.
+  std::size_t max_iterations = 0;
+};
+
+/// @brief Result of SolveMixedPrecision().
+/// @tparam T The full-precision element type.
+template <typename T>
+struct RefinementResult {
+  S21Matrix<T> solution;
+  /// @brief Refinement steps taken after the first low-precision solve.
+  std::size_t iterations = 0;
+  /// @brief Whether refinement failed and the system was solved in T.
+  bool fell_back = false;
+};
+
+namespace detail {
+
+/// @brief The element type that factorizations in mixed precision use.
+template <typename T>
+struct LowerPrecision;
+
+template <>
+struct LowerPrecision<double> {
+  using type = float;
+};
+
+template <>
+struct LowerPrecision<long double> {
+  using type = double;
+};
+
+/// @brief Converts a rows x cols block between element types.
+template <typename From, typename To>
+void ConvertBlock(std::size_t rows, std::size_t cols, const From *src,
+                  std::size_t lds, To *dst, std::size_t ldd) {
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      dst[i * ldd + j] = static_cast<To>(src[i * lds + j]);
+}
+
+/// @brief Calculates the largest absolute row sum, or infinity if an
+/// element is not finite.
+template <typename T>
+T InfinityNorm(std::size_t rows, std::size_t cols, const T *a,
+               std::size_t lda) {
+  T result = T(0);
+  for (std::size_t i = 0; i < rows; i++) {
+    T sum = T(0);
+    for (std::size_t j = 0; j < cols; j++) sum += std::abs(a[i * lda + j]);
+    if (!std::isfinite(sum)) return std::numeric_limits<T>::infinity();
+    result = std::max(result, sum);
+  }
+  return result;
+}
+
+/// @brief Checks that every column of R is below `threshold` times the
+/// largest element of the same column of X, with all elements finite.
+template <typename T>
+bool ResidualConverged(const S21Matrix<T> &r, const S21Matrix<T> &x,
+                       T threshold) {
+  const std::size_t n = r.GetRows(), m = r.GetCols();
+  std::vector<T> r_max(m, T(0)), x_max(m, T(0));
+  for (std::size_t i = 0; i < n; i++) {
+    const T *r_row = r.Data() + i * r.Stride();
+    const T *x_row = x.Data() + i * x.Stride();
+    for (std::size_t j = 0; j < m; j++) {
+      if (!std::isfinite(r_row[j]) || !std::isfinite(x_row[j])) return false;
+      r_max[j] = std::max(r_max[j], std::abs(r_row[j]));
+      x_max[j] = std::max(x_max[j], std::abs(x_row[j]));
+    }
+  }
+  for (std::size_t j = 0; j < m; j++)
+    if (!(r_max[j] <= x_max[j] * threshold)) return false;
+  return true;
+}
+
+/// @brief Solves A * X = B with the low-precision factors `lu` of A and
+/// refines X in T.
+/// @return Whether the residual converged within `max_iterations` steps,
+/// which are counted in `iterations`.
+template <typename T, typename Low>
+bool Refine(const LU<Low> &lu, S21MatrixView<const T> a,
+            S21MatrixView<const T> b, T threshold, std::size_t max_iterations,
+            S21Matrix<T> &x, std::size_t &iterations) {
+  const std::size_t n = b.GetRows(), m = b.GetCols();
+  S21Matrix<Low> low_rhs(n, m, ScratchResource());
+  S21Matrix<Low> low_x(n, m, ScratchResource());
+  S21Matrix<T> r(n, m, ScratchResource());
+  if (InfinityNorm(n, m, b.Data(), b.Stride()) >
+      std::numeric_limits<Low>::max())
+    return false;
+  ConvertBlock(n, m, b.Data(), b.Stride(), low_rhs.Data(), low_rhs.Stride());
+  lu.Solve(low_rhs, low_x);
+  ConvertBlock(n, m, low_x.Data(), low_x.Stride(), x.Data(), x.Stride());
+
+  for (iterations = 0;; iterations++) {
+    // R = B - A * X in full precision.
+    for (std::size_t i = 0; i < n; i++)
+      std::copy_n(b.Data() + i * b.Stride(), m, r.Data() + i * r.Stride());
+    if (m == 1) {
+      GemvParallelFor(n, n * n, 1, [&](std::size_t first, std::size_t last) {
+        GemvRows(first, last, n, T(-1), a.Data(), a.Stride(), x.Data(), T(1),
+                 r.Data());
+      });
+    } else {
+      Gemm(n, m, n, T(-1), a.Data(), a.Stride(), x.Data(), x.Stride(), T(1),
+           r.Data(), r.Stride());
+    }
+    if (ResidualConverged(r, x, threshold)) return true;
+    if (iterations == max_iterations ||
+        InfinityNorm(n, m, r.Data(), r.Stride()) >
+            std::numeric_limits<Low>::max())
+      return false;
+    // X += A^-1 * R with the low-precision factors.
+    ConvertBlock(n, m, r.Data(), r.Stride(), low_rhs.Data(),
+                 low_rhs.Stride());
+    lu.Solve(low_rhs, low_x);
+    for (std::size_t i = 0; i < n; i++) {
+      const Low *d_row = low_x.Data() + i * low_x.Stride();
+      T *x_row = x.Data() + i * x.Stride();
+      for (std::size_t j = 0; j < m; j++) x_row[j] += static_cast<T>(d_row[j]);
+    }
+  }
+}
+
+}  // namespace detail
+
+/// @brief Solves A * X = B by a low-precision LU factorization and
+/// iterative refinement, falling back to a full-precision solve.
+/// @note Each column of X is accepted once the largest element of its
+/// residual is at most sqrt(n) * eps * ||A||inf times its largest element,
+/// the test of LAPACK's dsgesv. A that is singular in the low precision,
+/// or A and B with elements beyond its range, go straight to the fallback.
+/// @note It pays off when the factorization dominates: a few right-hand
+/// sides of a large, reasonably conditioned system. Each refinement step
+/// costs a full-precision GEMM and a low-precision solve.
+/// @param a The square matrix of the system, or an expression of double or
+/// long double elements.
+/// @param b The right-hand sides, one per column, or an expression.
+/// @param options Limit on the refinement steps.
+/// @return The solution, allocated from the memory resource of A when A is
+/// a matrix, the number of refinement steps and whether it fell back.
+/// @throw std::runtime_error if the shapes do not match, or A is singular
+/// in full precision.
+template <typename L, typename R>
+RefinementResult<typename L::value_type> SolveMixedPrecision(
+    const MatrixExpression<L> &a, const MatrixExpression<R> &b,
+    const RefinementOptions &options = RefinementOptions()) {
+  using T = typename L::value_type;
+  using Low = typename detail::LowerPrecision<T>::type;
+  static_assert(std::is_same_v<T, typename R::value_type>,
+                "Operands must have the same element type");
+  const auto &ma = detail::Materialize(a.Self());
+  const auto &mb = detail::Materialize(b.Self());
+  const std::size_t n = ma.GetRows(), m = mb.GetCols();
+  if (ma.GetCols() != n || mb.GetRows() != n)
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for solving the system");
+  S21_INSTRUMENT(kSolve, 2 * n * n * n / 3 + 2 * n * n * m);
+  const std::size_t max_iterations = options.max_iterations
+                                         ? options.max_iterations
+                                         : S21_REFINEMENT_ITERATIONS;
+
+  RefinementResult<T> result{
+      S21Matrix<T>(n, m, detail::ResultResource(a.Self()))};
+  const T a_norm = detail::InfinityNorm(n, n, ma.Data(), ma.Stride());
+  if (a_norm <= std::numeric_limits<Low>::max()) {
+    S21Matrix<Low> low(n, n, ScratchResource());
+    detail::ConvertBlock(n, n, ma.Data(), ma.Stride(), low.Data(),
+                         low.Stride());
+    const LU<Low> lu(std::move(low));
+    const T threshold =
+        a_norm * std::numeric_limits<T>::epsilon() * std::sqrt(T(n));
+    if (!lu.IsSingular() &&
+        detail::Refine<T>(lu, ma, mb, threshold, max_iterations,
+                          result.solution, result.iterations))
+      return result;
+  }
+  result.fell_back = true;
+  const LU<T> lu(S21Matrix<T>(ma, ScratchResource()));
+  lu.Solve(mb, result.solution);
+  return result;
+}
+
+}  // namespace S21
+
+#endif  // S21_MIXED_PRECISION_HPP_
@@ -0,0 +1,298 @@
+#ifndef S21_OUT_OF_CORE_HPP_
+#define S21_OUT_OF_CORE_HPP_
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "s21_io.hpp"
+#include "s21_matrix_oop.hpp"
+
+/// @file
+/// @brief Multiplication of matrix files that do not fit in memory.
+/// @note The operands and the result are files in the format of
+/// SaveMatrix(). They are processed in square tiles: a background thread
+/// reads the tiles of the next step while the current ones are multiplied
+/// by the in-memory GEMM kernel, and writes finished result tiles while the
+/// next ones are computed.
+
+namespace S21 {
+
+/// @brief Settings of MulMatrixFiles().
+struct OutOfCoreOptions {
+  /// @brief Bytes of tile buffers the multiply may hold at once.
+  std::size_t memory_budget = std::size_t(512) << 20;
+
+  /// @brief Side of the square tiles; 0 derives it from memory_budget.
+  std::size_t tile = 0;
+};
+
+/// @brief Multiplies two matrix files, writing C = A * B to a new file.
+/// @note Memory use is six tiles, two of each of A, B and C, whatever the
+/// size of the matrices; every tile of A and of B is read once per tile
+/// column of C and tile row of C respectively. The result is written
+/// without a checksum, as its tiles are not produced in file order.
+/// @param a_path File of A, with the native byte order.
+/// @param b_path File of B, with as many rows as A has columns.
+/// @param c_path File to create or replace with C.
+/// @throw std::runtime_error if a file cannot be read or written, is not a
+/// matrix file of element type T, the dimensions are incompatible or the
+/// budget cannot hold six tiles.
+template <typename T = double>
+void MulMatrixFiles(const std::string &a_path, const std::string &b_path,
+                    const std::string &c_path,
+                    const OutOfCoreOptions &options = OutOfCoreOptions());
+
+namespace detail {
+
+/// @brief A thread that runs submitted jobs one after the other.
+class IoThread {
+ public:
+  IoThread() : thread_([this] { Run(); }) {}
+  IoThread(const IoThread &) = delete;
+  IoThread &operator=(const IoThread &) = delete;
+
+  /// @brief Finishes the queued jobs and joins the thread.
+  ~IoThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    ready_.notify_one();
+    thread_.join();
+  }
+
+  /// @return A future that is ready, or holds the exception thrown, once
+  /// `job` has run.
+  std::future<void> Submit(std::function<void()> job) {
+    std::packaged_task<void()> task(std::move(job));
+    std::future<void> done = task.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+    return done;
+  }
+
+ private:
+  void Run() {
+    for (;;) {
+      std::packaged_task<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+        if (jobs_.empty()) return;
+        task = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::packaged_task<void()>> jobs_;
+  bool stop_ = false;
+  std::thread thread_;  // Last, so that it starts after the other members
+};
+
+/// @brief A matrix file accessed tile by tile with pread and pwrite.
+template <typename T>
+class TileFile {
+ public:
+  /// @brief Opens an existing matrix file for reading.
+  explicit TileFile(const std::string &path)
+      : fd_(open(path.c_str(), O_RDONLY)) {
+    if (fd_ < 0) throw std::runtime_error("Cannot open matrix file " + path);
+    struct stat status;
+    if (fstat(fd_, &status) != 0 ||
+        pread(fd_, &header_, sizeof(header_), 0) !=
+            static_cast<ssize_t>(sizeof(header_))) {
+      close(fd_);
+      throw std::runtime_error("Not a matrix file");
+    }
+    try {
+      bool swapped = false;
+      CheckHeader<T>(header_, static_cast<std::uint64_t>(status.st_size),
+                     swapped);
+      if (swapped)
+        throw std::runtime_error(
+            "Out-of-core operands must have the native byte order");
+    } catch (...) {
+      close(fd_);
+      throw;
+    }
+  }
+
+  /// @brief Creates a zero-filled rows x cols matrix file.
+  TileFile(const std::string &path, std::size_t rows, std::size_t cols)
+      : fd_(open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)), header_{} {
+    if (fd_ < 0) throw std::runtime_error("Cannot open matrix file " + path);
+    std::memcpy(header_.magic, MatrixFileHeader::kMagic, 8);
+    header_.byte_order = MatrixFileHeader::kByteOrder;
+    header_.version = MatrixFileHeader::kVersion;
+    header_.element_type = static_cast<std::uint8_t>(ElementTypeOf<T>());
+    header_.element_size = sizeof(T);
+    header_.rows = rows;
+    header_.cols = cols;
+    header_.stride = cols;
+    header_.offset = S21Matrix<T>::kAlignment;
+    // ftruncate leaves a sparse file that reads as zeros
+    if (pwrite(fd_, &header_, sizeof(header_), 0) !=
+            static_cast<ssize_t>(sizeof(header_)) ||
+        ftruncate(fd_, static_cast<off_t>(header_.offset +
+                                          rows * cols * sizeof(T))) != 0) {
+      close(fd_);
+      throw std::runtime_error("Cannot write matrix file " + path);
+    }
+  }
+
+  TileFile(const TileFile &) = delete;
+  TileFile &operator=(const TileFile &) = delete;
+  ~TileFile() { close(fd_); }
+
+  std::size_t GetRows() const { return header_.rows; }
+  std::size_t GetCols() const { return header_.cols; }
+
+  /// @brief Reads the rows x cols block at (row, col) into `dst`.
+  /// @param ld Distance in elements between rows of `dst`.
+  void ReadTile(std::size_t row, std::size_t col, std::size_t rows,
+                std::size_t cols, T *dst, std::size_t ld) const {
+    for (std::size_t i = 0; i < rows; i++)
+      Transfer(false, dst + i * ld, cols * sizeof(T), Offset(row + i, col));
+  }
+
+  /// @brief Writes the rows x cols block at (row, col) from `src`.
+  void WriteTile(std::size_t row, std::size_t col, std::size_t rows,
+                 std::size_t cols, const T *src, std::size_t ld) const {
+    for (std::size_t i = 0; i < rows; i++)
+      Transfer(true, const_cast<T *>(src + i * ld), cols * sizeof(T),
+               Offset(row + i, col));
+  }
+
+ private:
+  off_t Offset(std::size_t row, std::size_t col) const {
+    return static_cast<off_t>(header_.offset +
+                              (row * header_.stride + col) * sizeof(T));
+  }
+
+  void Transfer(bool write, void *data, std::size_t size,
+                off_t offset) const {
+    char *bytes = static_cast<char *>(data);
+    while (size > 0) {
+      const ssize_t done = write ? pwrite(fd_, bytes, size, offset)
+                                 : pread(fd_, bytes, size, offset);
+      if (done < 0 && errno == EINTR) continue;
+      if (done <= 0)
+        throw std::runtime_error(write ? "Cannot write matrix file"
+                                       : "Matrix file is truncated");
+      bytes += done;
+      size -= static_cast<std::size_t>(done);
+      offset += done;
+    }
+  }
+
+  int fd_;
+  MatrixFileHeader header_;
+};
+
+}  // namespace detail
+
+template <typename T>
+void MulMatrixFiles(const std::string &a_path, const std::string &b_path,
+                    const std::string &c_path,
+                    const OutOfCoreOptions &options) {
+  detail::TileFile<T> a(a_path), b(b_path);
+  if (a.GetCols() != b.GetRows())
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  const std::size_t m = a.GetRows(), k = a.GetCols(), n = b.GetCols();
+  std::size_t tile = options.tile;
+  if (tile == 0) {
+    tile = static_cast<std::size_t>(
+        std::sqrt(static_cast<double>(options.memory_budget) /
+                  (6 * sizeof(T))));
+    if (tile > 64) tile -= tile % 64;  // Whole GEMM blocks
+  }
+  if (tile == 0 || 6 * tile * tile * sizeof(T) > options.memory_budget)
+    throw std::runtime_error("Memory budget is too small for six tiles");
+  const std::size_t tm = std::min(tile, m), tk = std::min(tile, k);
+  const std::size_t tn = std::min(tile, n);
+  detail::AlignedBuffer<T> buffers[6];
+  T *const a_tiles[2] = {buffers[0].Reserve(tm * tk),
+                         buffers[1].Reserve(tm * tk)};
+  T *const b_tiles[2] = {buffers[2].Reserve(tk * tn),
+                         buffers[3].Reserve(tk * tn)};
+  T *const c_tiles[2] = {buffers[4].Reserve(tm * tn),
+                         buffers[5].Reserve(tm * tn)};
+  detail::TileFile<T> c(c_path, m, n);
+
+  // Step s multiplies A(i, p) by B(p, j), p varying fastest.
+  const std::size_t row_tiles = (m + tile - 1) / tile;
+  const std::size_t col_tiles = (n + tile - 1) / tile;
+  const std::size_t depth_tiles = (k + tile - 1) / tile;
+  const std::size_t steps = row_tiles * col_tiles * depth_tiles;
+  struct Step {
+    std::size_t i, j, p, rows, cols, depth;
+  };
+  auto step_at = [&](std::size_t s) {
+    Step step;
+    step.p = s % depth_tiles * tile;
+    step.j = s / depth_tiles % col_tiles * tile;
+    step.i = s / depth_tiles / col_tiles * tile;
+    step.rows = std::min(tile, m - step.i);
+    step.cols = std::min(tile, n - step.j);
+    step.depth = std::min(tile, k - step.p);
+    return step;
+  };
+
+  std::future<void> loads[2], writes[2];
+  detail::IoThread io;  // Joined before the buffers and files go away
+  auto load = [&](std::size_t s) {
+    const Step step = step_at(s);
+    T *a_tile = a_tiles[s % 2];
+    T *b_tile = b_tiles[s % 2];
+    loads[s % 2] = io.Submit([&a, &b, step, a_tile, b_tile] {
+      a.ReadTile(step.i, step.p, step.rows, step.depth, a_tile, step.depth);
+      b.ReadTile(step.p, step.j, step.depth, step.cols, b_tile, step.cols);
+    });
+  };
+  if (steps > 0) load(0);
+  for (std::size_t s = 0; s < steps; s++) {
+    const Step step = step_at(s);
+    loads[s % 2].get();
+    if (s + 1 < steps) load(s + 1);
+    const std::size_t slot = s / depth_tiles % 2;
+    T *c_tile = c_tiles[slot];
+    if (step.p == 0 && writes[slot].valid()) writes[slot].get();
+    detail::Gemm(step.rows, step.cols, step.depth, T(1), a_tiles[s % 2],
+                 step.depth, b_tiles[s % 2], step.cols,
+                 step.p == 0 ? T(0) : T(1), c_tile, step.cols);
+    if (step.p + step.depth == k) {
+      writes[slot] = io.Submit([&c, step, c_tile] {
+        c.WriteTile(step.i, step.j, step.rows, step.cols, c_tile, step.cols);
+      });
+    }
+  }
+  for (std::future<void> &write : writes)
+    if (write.valid()) write.get();
+}
+
+}  // namespace S21
+
+#endif  // S21_OUT_OF_CORE_HPP_
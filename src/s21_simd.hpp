@@ -0,0 +1,539 @@
+#ifndef S21_SIMD_HPP_
+#define S21_SIMD_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+/// @file
+/// @brief Vectorized element-wise kernels with runtime instruction set
+/// dispatch, used by SumMatrix, SubMatrix, MulNumber and EqMatrix, by the
+/// comparisons of s21_compare.hpp and by the matrix-vector products.
+/// @note On x86-64 the kernels are compiled for SSE2, AVX2 and AVX-512 in
+/// the same binary and the widest one the CPU supports is picked on first
+/// use, so no `-march` flag is needed. Other targets use the portable
+/// scalar loops.
+/// @note The choice can be overridden with the `S21_FORCE_ISA` environment
+/// variable (`scalar`, `sse2`, `avx2` or `avx512`) or with simd::ForceIsa().
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_SIMD_X86 1
+#else
+#define S21_SIMD_X86 0
+#endif
+
+/// Element types that have vectorized kernels; others use scalar loops.
+#define S21_SIMD_FOR_EACH_TYPE(X)                            \
+  X(signed char) X(unsigned char) X(short) X(unsigned short) \
+  X(int) X(unsigned) X(long) X(unsigned long) X(long long)   \
+  X(unsigned long long) X(float) X(double)
+
+namespace S21 {
+namespace simd {
+
+/// @brief Instruction sets the element-wise kernels are compiled for,
+/// from the narrowest to the widest.
+enum class Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+/// @brief Gets the widest instruction set supported by the running CPU.
+Isa DetectIsa();
+
+/// @brief Gets the instruction set the kernels currently dispatch to.
+Isa GetIsa();
+
+/// @brief Makes the kernels dispatch to `isa`, e.g. to test each path.
+/// @throw std::runtime_error if the CPU does not support `isa`.
+void ForceIsa(Isa isa);
+
+/// @brief Drops a ForceIsa() override and returns to the default choice.
+void ResetIsa();
+
+/// @brief Gets the lower-case name of `isa`, as accepted by `S21_FORCE_ISA`.
+const char *IsaName(Isa isa);
+
+/// @brief Adds `count` elements of `src` to `dst`.
+template <typename T>
+void Add(T *dst, const T *src, std::size_t count);
+
+/// @brief Subtracts `count` elements of `src` from `dst`.
+template <typename T>
+void Sub(T *dst, const T *src, std::size_t count);
+
+/// @brief Multiplies `count` elements of `dst` by `scalar`.
+template <typename T>
+void Scale(T *dst, T scalar, std::size_t count);
+
+/// @brief Adds `alpha` times `count` elements of `src` to `dst`.
+template <typename T>
+void Axpy(T *dst, T alpha, const T *src, std::size_t count);
+
+/// @brief Computes the dot product of `count` elements of `lhs` and `rhs`.
+/// @note Accumulates in several independent partial sums, so the result of
+/// a floating-point type can differ in the last bits from a plain loop and
+/// between instruction sets.
+template <typename T>
+T Dot(const T *lhs, const T *rhs, std::size_t count);
+
+/// @brief Checks that `|lhs[i] - rhs[i]| <= tolerance` for `count` elements.
+/// @note Stops at the first block that contains a mismatch. NaN never
+/// compares equal. Integer differences are taken without overflow, and a
+/// negative integer tolerance counts as 0.
+template <typename T>
+bool Equal(const T *lhs, const T *rhs, std::size_t count, T tolerance);
+
+/// @brief Checks that `|lhs[i] - rhs[i]| <= tolerance * max(|lhs[i]|,
+/// |rhs[i]|)` for `count` elements of a floating-point type.
+/// @note Equal infinities match, while an infinity never matches a finite
+/// value. Stops at the first block that contains a mismatch. NaN never
+/// compares equal.
+template <typename T>
+bool EqualRelative(const T *lhs, const T *rhs, std::size_t count,
+                   T tolerance);
+
+/// @brief Checks that `lhs[i]` and `rhs[i]` are at most `max_ulps`
+/// representable values apart for `count` elements of a floating-point
+/// type.
+/// @note +0 and -0 match, and so do equal infinities. Stops at the first
+/// block that contains a mismatch. NaN never compares equal.
+template <typename T>
+bool EqualUlp(const T *lhs, const T *rhs, std::size_t count,
+              std::uint64_t max_ulps);
+
+/// @brief Counts the representable values between two floating-point
+/// numbers.
+/// @note Exact for float and double, which are compared through their bit
+/// patterns; estimated from the spacing at the larger magnitude for other
+/// types. The maximum value is returned if either is NaN.
+template <typename T>
+std::uint64_t UlpDistance(T lhs, T rhs);
+
+namespace detail {
+
+/// @brief Signed integer with the size of a float or a double, whose bit
+/// patterns UlpDistance() orders.
+template <typename T>
+struct UlpInt {};
+
+template <>
+struct UlpInt<float> {
+  using type = std::int32_t;
+};
+
+template <>
+struct UlpInt<double> {
+  using type = std::int64_t;
+};
+
+template <typename T>
+struct Vectorizable : std::false_type {};
+
+#define S21_SIMD_VECTORIZABLE(T) \
+  template <>                    \
+  struct Vectorizable<T> : std::true_type {};
+S21_SIMD_FOR_EACH_TYPE(S21_SIMD_VECTORIZABLE)
+#undef S21_SIMD_VECTORIZABLE
+
+/// @brief Parses an instruction set name such as the value of
+/// `S21_FORCE_ISA`.
+/// @return false when the text does not name one.
+inline bool ParseIsa(const char *text, Isa &isa) {
+  if (text == nullptr) return false;
+  for (Isa candidate : {Isa::kScalar, Isa::kSse2, Isa::kAvx2, Isa::kAvx512}) {
+    if (std::strcmp(text, IsaName(candidate)) == 0) {
+      isa = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// @brief Instruction set used when none is forced: `S21_FORCE_ISA` if it
+/// names one the CPU supports, the detected one otherwise.
+inline Isa DefaultIsa() {
+  Isa isa = DetectIsa();
+  Isa requested;
+  if (ParseIsa(std::getenv("S21_FORCE_ISA"), requested) && requested <= isa)
+    isa = requested;
+  return isa;
+}
+
+inline std::atomic<Isa> &ActiveIsa() {
+  static std::atomic<Isa> isa(DefaultIsa());
+  return isa;
+}
+
+namespace scalar {
+
+template <typename T>
+void Add(T *dst, const T *src, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) dst[i] += src[i];
+}
+
+template <typename T>
+void Sub(T *dst, const T *src, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) dst[i] -= src[i];
+}
+
+template <typename T>
+void Scale(T *dst, T scalar, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) dst[i] *= scalar;
+}
+
+template <typename T>
+void Axpy(T *dst, T alpha, const T *src, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) dst[i] += alpha * src[i];
+}
+
+template <typename T>
+T Dot(const T *lhs, const T *rhs, std::size_t count) {
+  T sum = T(0);
+  for (std::size_t i = 0; i < count; i++) sum += lhs[i] * rhs[i];
+  return sum;
+}
+
+/// @brief Calculates |lhs - rhs| of an integer type in its unsigned
+/// counterpart, where it cannot overflow.
+template <typename T>
+constexpr std::make_unsigned_t<T> AbsDiff(T lhs, T rhs) {
+  using U = std::make_unsigned_t<T>;
+  return lhs > rhs ? U(U(lhs) - U(rhs)) : U(U(rhs) - U(lhs));
+}
+
+/// @brief Checks that `|lhs - rhs| <= tolerance`, the test of Equal() for
+/// one element.
+template <typename T>
+constexpr bool Close(T lhs, T rhs, T tolerance) {
+  if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return AbsDiff(lhs, rhs) <= (tolerance > T(0) ? U(tolerance) : U(0));
+  } else {
+    const T diff = lhs > rhs ? lhs - rhs : rhs - lhs;
+    return diff <= tolerance;  // NaN compares false
+  }
+}
+
+template <typename T>
+bool Equal(const T *lhs, const T *rhs, std::size_t count, T tolerance) {
+  for (std::size_t i = 0; i < count; i++)
+    if (!Close(lhs[i], rhs[i], tolerance)) return false;
+  return true;
+}
+
+template <typename T>
+bool EqualRelative(const T *lhs, const T *rhs, std::size_t count,
+                   T tolerance) {
+  for (std::size_t i = 0; i < count; i++) {
+    if (lhs[i] == rhs[i]) continue;
+    // An infinite scale would accept any difference.
+    if (!std::isfinite(lhs[i]) || !std::isfinite(rhs[i])) return false;
+    const T scale = std::max(std::abs(lhs[i]), std::abs(rhs[i]));
+    if (!(std::abs(lhs[i] - rhs[i]) <= tolerance * scale)) return false;
+  }
+  return true;
+}
+
+template <typename T>
+std::uint64_t UlpDistance(T lhs, T rhs) {
+  constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+  if (lhs != lhs || rhs != rhs) return kMax;
+  if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+    // Bit patterns read as sign and magnitude, mapped to two's complement
+    // so that consecutive values differ by one, across zero too.
+    using I = typename UlpInt<T>::type;
+    using U = std::make_unsigned_t<I>;
+    constexpr I kMin = std::numeric_limits<I>::min();
+    I a, b;
+    std::memcpy(&a, &lhs, sizeof(a));
+    std::memcpy(&b, &rhs, sizeof(b));
+    a = a < 0 ? kMin - a : a;
+    b = b < 0 ? kMin - b : b;
+    return a > b ? U(a) - U(b) : U(b) - U(a);
+  } else {
+    if (lhs == rhs) return 0;
+    const T scale = std::max({std::abs(lhs), std::abs(rhs),
+                              std::numeric_limits<T>::min()});
+    const T ulps =
+        std::abs(lhs - rhs) / (scale * std::numeric_limits<T>::epsilon());
+    return ulps < T(kMax) ? static_cast<std::uint64_t>(std::ceil(ulps))
+                          : kMax;
+  }
+}
+
+template <typename T>
+bool EqualUlp(const T *lhs, const T *rhs, std::size_t count,
+              std::uint64_t max_ulps) {
+  for (std::size_t i = 0; i < count; i++) {
+    if (lhs[i] != lhs[i] || rhs[i] != rhs[i]) return false;
+    if (UlpDistance(lhs[i], rhs[i]) > max_ulps) return false;
+  }
+  return true;
+}
+
+}  // namespace scalar
+}  // namespace detail
+}  // namespace simd
+}  // namespace S21
+
+#if S21_SIMD_X86
+
+#define S21_SIMD_NAMESPACE sse2  // Part of the x86-64 baseline
+#define S21_SIMD_BYTES 16
+#include "s21_simd_kernels.hpp"
+#undef S21_SIMD_NAMESPACE
+#undef S21_SIMD_BYTES
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+#define S21_SIMD_NAMESPACE avx2
+#define S21_SIMD_BYTES 32
+#include "s21_simd_kernels.hpp"
+#undef S21_SIMD_NAMESPACE
+#undef S21_SIMD_BYTES
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+#define S21_SIMD_NAMESPACE avx512
+#define S21_SIMD_BYTES 64
+#include "s21_simd_kernels.hpp"
+#undef S21_SIMD_NAMESPACE
+#undef S21_SIMD_BYTES
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif  // S21_SIMD_X86
+
+namespace S21 {
+namespace simd {
+
+inline Isa DetectIsa() {
+#if S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return Isa::kAvx512;
+  if (__builtin_cpu_supports("avx2")) return Isa::kAvx2;
+  return Isa::kSse2;
+#else
+  return Isa::kScalar;
+#endif
+}
+
+inline Isa GetIsa() {
+  return detail::ActiveIsa().load(std::memory_order_relaxed);
+}
+
+inline void ForceIsa(Isa isa) {
+  if (isa > DetectIsa())
+    throw std::runtime_error("Instruction set is not supported by this CPU");
+  detail::ActiveIsa().store(isa, std::memory_order_relaxed);
+}
+
+inline void ResetIsa() {
+  detail::ActiveIsa().store(detail::DefaultIsa(), std::memory_order_relaxed);
+}
+
+inline const char *IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kSse2:
+      return "sse2";
+    case Isa::kAvx2:
+      return "avx2";
+    case Isa::kAvx512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+template <typename T>
+void Add(T *dst, const T *src, std::size_t count) {
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::Add(dst, src, count);
+      case Isa::kAvx2:
+        return detail::avx2::Add(dst, src, count);
+      case Isa::kSse2:
+        return detail::sse2::Add(dst, src, count);
+#endif
+      default:
+        break;
+    }
+  }
+  detail::scalar::Add(dst, src, count);
+}
+
+template <typename T>
+void Sub(T *dst, const T *src, std::size_t count) {
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::Sub(dst, src, count);
+      case Isa::kAvx2:
+        return detail::avx2::Sub(dst, src, count);
+      case Isa::kSse2:
+        return detail::sse2::Sub(dst, src, count);
+#endif
+      default:
+        break;
+    }
+  }
+  detail::scalar::Sub(dst, src, count);
+}
+
+template <typename T>
+void Scale(T *dst, T scalar, std::size_t count) {
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::Scale(dst, scalar, count);
+      case Isa::kAvx2:
+        return detail::avx2::Scale(dst, scalar, count);
+      case Isa::kSse2:
+        return detail::sse2::Scale(dst, scalar, count);
+#endif
+      default:
+        break;
+    }
+  }
+  detail::scalar::Scale(dst, scalar, count);
+}
+
+template <typename T>
+void Axpy(T *dst, T alpha, const T *src, std::size_t count) {
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::Axpy(dst, alpha, src, count);
+      case Isa::kAvx2:
+        return detail::avx2::Axpy(dst, alpha, src, count);
+      case Isa::kSse2:
+        return detail::sse2::Axpy(dst, alpha, src, count);
+#endif
+      default:
+        break;
+    }
+  }
+  detail::scalar::Axpy(dst, alpha, src, count);
+}
+
+template <typename T>
+T Dot(const T *lhs, const T *rhs, std::size_t count) {
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::Dot(lhs, rhs, count);
+      case Isa::kAvx2:
+        return detail::avx2::Dot(lhs, rhs, count);
+      case Isa::kSse2:
+        return detail::sse2::Dot(lhs, rhs, count);
+#endif
+      default:
+        break;
+    }
+  }
+  return detail::scalar::Dot(lhs, rhs, count);
+}
+
+template <typename T>
+bool Equal(const T *lhs, const T *rhs, std::size_t count, T tolerance) {
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::Equal(lhs, rhs, count, tolerance);
+      case Isa::kAvx2:
+        return detail::avx2::Equal(lhs, rhs, count, tolerance);
+      case Isa::kSse2:
+        return detail::sse2::Equal(lhs, rhs, count, tolerance);
+#endif
+      default:
+        break;
+    }
+  }
+  return detail::scalar::Equal(lhs, rhs, count, tolerance);
+}
+
+template <typename T>
+bool EqualRelative(const T *lhs, const T *rhs, std::size_t count,
+                   T tolerance) {
+  static_assert(std::is_floating_point_v<T>,
+                "Relative comparison requires a floating-point type");
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::EqualRelative(lhs, rhs, count, tolerance);
+      case Isa::kAvx2:
+        return detail::avx2::EqualRelative(lhs, rhs, count, tolerance);
+      case Isa::kSse2:
+        return detail::sse2::EqualRelative(lhs, rhs, count, tolerance);
+#endif
+      default:
+        break;
+    }
+  }
+  return detail::scalar::EqualRelative(lhs, rhs, count, tolerance);
+}
+
+template <typename T>
+bool EqualUlp(const T *lhs, const T *rhs, std::size_t count,
+              std::uint64_t max_ulps) {
+  static_assert(std::is_floating_point_v<T>,
+                "ULP comparison requires a floating-point type");
+  if constexpr (detail::Vectorizable<T>::value) {
+    switch (GetIsa()) {
+#if S21_SIMD_X86
+      case Isa::kAvx512:
+        return detail::avx512::EqualUlp(lhs, rhs, count, max_ulps);
+      case Isa::kAvx2:
+        return detail::avx2::EqualUlp(lhs, rhs, count, max_ulps);
+      case Isa::kSse2:
+        return detail::sse2::EqualUlp(lhs, rhs, count, max_ulps);
+#endif
+      default:
+        break;
+    }
+  }
+  return detail::scalar::EqualUlp(lhs, rhs, count, max_ulps);
+}
+
+template <typename T>
+std::uint64_t UlpDistance(T lhs, T rhs) {
+  static_assert(std::is_floating_point_v<T>,
+                "ULP distance requires a floating-point type");
+  return detail::scalar::UlpDistance(lhs, rhs);
+}
+
+}  // namespace simd
+}  // namespace S21
+
+#endif  // S21_SIMD_HPP_
@@ -0,0 +1,192 @@
+// No include guard: s21_simd.hpp includes this file once per instruction set,
+// each time inside a different target region and with S21_SIMD_NAMESPACE and
+// S21_SIMD_BYTES naming the namespace and the vector width to compile for.
+
+/// @file
+/// @brief Element-wise kernels written once against GCC vector extensions.
+/// @note Each inclusion turns every `Vector<T>::type` operation into the
+/// instructions of the surrounding target region, so the same source yields
+/// the SSE2, AVX2 and AVX-512 kernels. The tail that does not fill a whole
+/// vector is finished with scalar code.
+
+namespace S21 {
+namespace simd {
+namespace detail {
+namespace S21_SIMD_NAMESPACE {
+
+template <typename T>
+struct Vector;
+
+#define S21_SIMD_VECTOR(T)                                            \
+  template <>                                                         \
+  struct Vector<T> {                                                  \
+    typedef T type __attribute__((vector_size(S21_SIMD_BYTES)));      \
+    static constexpr std::size_t kLanes = S21_SIMD_BYTES / sizeof(T); \
+  };
+S21_SIMD_FOR_EACH_TYPE(S21_SIMD_VECTOR)
+#undef S21_SIMD_VECTOR
+
+template <typename T>
+typename Vector<T>::type Load(const T *src) {
+  typename Vector<T>::type value;
+  std::memcpy(&value, src, sizeof(value));  // Unaligned load
+  return value;
+}
+
+template <typename T>
+void Store(T *dst, typename Vector<T>::type value) {
+  std::memcpy(dst, &value, sizeof(value));
+}
+
+template <typename T>
+void Add(T *dst, const T *src, std::size_t count) {
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  std::size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes)
+    Store(dst + i, Load(dst + i) + Load(src + i));
+  for (; i < count; i++) dst[i] += src[i];
+}
+
+template <typename T>
+void Sub(T *dst, const T *src, std::size_t count) {
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  std::size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes)
+    Store(dst + i, Load(dst + i) - Load(src + i));
+  for (; i < count; i++) dst[i] -= src[i];
+}
+
+template <typename T>
+void Scale(T *dst, T scalar, std::size_t count) {
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  std::size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes)
+    Store(dst + i, Load(dst + i) * scalar);
+  for (; i < count; i++) dst[i] *= scalar;
+}
+
+template <typename T>
+void Axpy(T *dst, T alpha, const T *src, std::size_t count) {
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  std::size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes)
+    Store(dst + i, Load(dst + i) + alpha * Load(src + i));
+  for (; i < count; i++) dst[i] += alpha * src[i];
+}
+
+template <typename T>
+T Dot(const T *lhs, const T *rhs, std::size_t count) {
+  using V = typename Vector<T>::type;
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  constexpr std::size_t kUnroll = 4;  // Independent sums hide FMA latency
+  V sums[kUnroll] = {};
+  std::size_t i = 0;
+  for (; i + kUnroll * kLanes <= count; i += kUnroll * kLanes)
+    for (std::size_t u = 0; u < kUnroll; u++)
+      sums[u] += Load(lhs + i + u * kLanes) * Load(rhs + i + u * kLanes);
+  for (; i + kLanes <= count; i += kLanes)
+    sums[0] += Load(lhs + i) * Load(rhs + i);
+  const V total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+  T sum = T(0);
+  for (std::size_t lane = 0; lane < kLanes; lane++) sum += total[lane];
+  for (; i < count; i++) sum += lhs[i] * rhs[i];
+  return sum;
+}
+
+template <typename T>
+bool Equal(const T *lhs, const T *rhs, std::size_t count, T tolerance) {
+  using V = typename Vector<T>::type;
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  constexpr std::size_t kUnroll = 4;  // Vectors compared per early-exit test
+  std::size_t i = 0;
+  for (; i + kUnroll * kLanes <= count; i += kUnroll * kLanes) {
+    auto close = V{} == V{};  // All lanes set
+    for (std::size_t u = 0; u < kUnroll; u++) {
+      const V a = Load(lhs + i + u * kLanes);
+      const V b = Load(rhs + i + u * kLanes);
+      if constexpr (std::is_integral_v<T>) {
+        // Differences in unsigned lanes, where they cannot overflow.
+        using U = std::make_unsigned_t<T>;
+        using VU = typename Vector<U>::type;
+        const U limit = tolerance > T(0) ? U(tolerance) : U(0);
+        if (limit == 0) {
+          close &= a == b;
+        } else {
+          const VU diff = a > b ? (VU)a - (VU)b : (VU)b - (VU)a;
+          close &= diff <= limit;
+        }
+      } else {
+        const V diff = a > b ? a - b : b - a;
+        close &= diff <= tolerance;  // NaN compares false
+      }
+    }
+    for (std::size_t lane = 0; lane < kLanes; lane++)
+      if (!close[lane]) return false;
+  }
+  return scalar::Equal(lhs + i, rhs + i, count - i, tolerance);
+}
+
+template <typename T>
+bool EqualRelative(const T *lhs, const T *rhs, std::size_t count,
+                   T tolerance) {
+  using V = typename Vector<T>::type;
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  constexpr std::size_t kUnroll = 4;  // Vectors compared per early-exit test
+  std::size_t i = 0;
+  for (; i + kUnroll * kLanes <= count; i += kUnroll * kLanes) {
+    auto close = V{} == V{};  // All lanes set
+    for (std::size_t u = 0; u < kUnroll; u++) {
+      const V a = Load(lhs + i + u * kLanes);
+      const V b = Load(rhs + i + u * kLanes);
+      const V diff = a > b ? a - b : b - a;
+      const V abs_a = a < T(0) ? -a : a;
+      const V abs_b = b < T(0) ? -b : b;
+      const V scale = abs_a > abs_b ? abs_a : abs_b;
+      // Unequal lanes also need a finite scale: infinity accepts any
+      // difference. NaN compares false.
+      close &= (a == b) | ((diff <= tolerance * scale) &
+                           (scale <= std::numeric_limits<T>::max()));
+    }
+    for (std::size_t lane = 0; lane < kLanes; lane++)
+      if (!close[lane]) return false;
+  }
+  return scalar::EqualRelative(lhs + i, rhs + i, count - i, tolerance);
+}
+
+template <typename T>
+bool EqualUlp(const T *lhs, const T *rhs, std::size_t count,
+              std::uint64_t max_ulps) {
+  using I = typename UlpInt<T>::type;
+  using U = std::make_unsigned_t<I>;
+  using V = typename Vector<T>::type;
+  using VI = typename Vector<I>::type;
+  using VU = typename Vector<U>::type;
+  constexpr std::size_t kLanes = Vector<T>::kLanes;
+  constexpr std::size_t kUnroll = 4;
+  constexpr I kMin = std::numeric_limits<I>::min();
+  const U limit = static_cast<U>(
+      std::min<std::uint64_t>(max_ulps, std::numeric_limits<U>::max()));
+  std::size_t i = 0;
+  for (; i + kUnroll * kLanes <= count; i += kUnroll * kLanes) {
+    VI close = VI{} == VI{};
+    for (std::size_t u = 0; u < kUnroll; u++) {
+      const V a = Load(lhs + i + u * kLanes);
+      const V b = Load(rhs + i + u * kLanes);
+      // The mapping of scalar::UlpDistance(), one lane at a time. Both
+      // sides of ?: are evaluated, so it subtracts in unsigned lanes.
+      VI ia = (VI)a, ib = (VI)b;
+      ia = ia < 0 ? (VI)(U(kMin) - (VU)ia) : ia;
+      ib = ib < 0 ? (VI)(U(kMin) - (VU)ib) : ib;
+      const VU diff = ia > ib ? (VU)ia - (VU)ib : (VU)ib - (VU)ia;
+      close &= (VI)(diff <= limit) & (VI)(a == a) & (VI)(b == b);
+    }
+    for (std::size_t lane = 0; lane < kLanes; lane++)
+      if (!close[lane]) return false;
+  }
+  return scalar::EqualUlp(lhs + i, rhs + i, count - i, max_ulps);
+}
+
+}  // namespace S21_SIMD_NAMESPACE
+}  // namespace detail
+}  // namespace simd
+}  // namespace S21
@@ -0,0 +1,651 @@
+#ifndef S21_SPARSE_HPP_
+#define S21_SPARSE_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+#ifndef S21_SPARSE_PARALLEL
+#define S21_SPARSE_PARALLEL 131072  // Multiply-adds below which it is serial
+#endif
+
+namespace S21 {
+
+/// @brief Storage order of an S21SparseMatrix.
+/// @note kCsr (compressed sparse row) keeps the nonzeros of each row
+/// together and is the layout for SpMV and for products by rows; kCsc
+/// (compressed sparse column) keeps each column together.
+enum class SparseLayout { kCsr, kCsc };
+
+/// @brief A sparse matrix in compressed row or column form.
+/// @note Only nonzeros are stored: for CSR, the column indices and values
+/// of row i are `Indices()[k]` and `Values()[k]` for k in
+/// [`Offsets()[i]`, `Offsets()[i + 1]`), sorted by column and without
+/// duplicates; CSC is the same with rows and columns exchanged. A matrix
+/// with nnz nonzeros takes (outer + 1 + nnz) indices and nnz values, so a
+/// 1M x 1M matrix with a few nonzeros per row fits in tens of megabytes.
+/// @note The arrays are allocated from the memory resource given at
+/// construction, which results computed from the matrix use as well.
+/// Copies use the default resource, like S21Matrix.
+/// @tparam T The type of the matrix elements.
+template <typename T = double>
+class S21SparseMatrix {
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+ public:
+  using value_type = T;
+
+  /// @brief One entry of a matrix in coordinate (COO) form.
+  struct Triplet {
+    std::size_t row;
+    std::size_t col;
+    T value;
+  };
+
+  /// @brief Creates a rows x cols matrix without nonzeros.
+  /// @param resource Memory resource the arrays are allocated from.
+  S21SparseMatrix(std::size_t rows, std::size_t cols,
+                  SparseLayout layout = SparseLayout::kCsr,
+                  std::pmr::memory_resource *resource =
+                      std::pmr::get_default_resource());
+
+  /// @brief Creates a matrix from coordinate triplets.
+  /// @note Triplets may come in any order; values of triplets with the same
+  /// position are summed. Runs in O(nnz + rows + cols).
+  /// @throw std::out_of_range if a triplet lies outside rows x cols.
+  S21SparseMatrix(std::size_t rows, std::size_t cols,
+                  const std::vector<Triplet> &triplets,
+                  SparseLayout layout = SparseLayout::kCsr,
+                  std::pmr::memory_resource *resource =
+                      std::pmr::get_default_resource());
+
+  /// @brief Creates a matrix from the elements of a dense one whose
+  /// magnitude is above `threshold`.
+  /// @param threshold Elements with |x| <= threshold are dropped; the
+  /// default keeps every element that is not zero.
+  explicit S21SparseMatrix(const S21Matrix<T> &dense, T threshold = T(0),
+                           SparseLayout layout = SparseLayout::kCsr,
+                           std::pmr::memory_resource *resource =
+                               std::pmr::get_default_resource());
+
+  std::size_t GetRows() const { return rows_; }
+  std::size_t GetCols() const { return cols_; }
+  SparseLayout GetLayout() const { return layout_; }
+  std::pmr::memory_resource *GetResource() const {
+    return values_.get_allocator().resource();
+  }
+
+  /// @brief Gets the number of stored entries.
+  std::size_t GetNonZeros() const { return values_.size(); }
+
+  /// @brief Gets the start of every row (CSR) or column (CSC) in Indices()
+  /// and Values(), followed by GetNonZeros().
+  const std::pmr::vector<std::size_t> &Offsets() const { return offsets_; }
+
+  /// @brief Gets the column (CSR) or row (CSC) index of every entry.
+  const std::pmr::vector<std::size_t> &Indices() const { return indices_; }
+
+  /// @brief Gets the value of every entry.
+  const std::pmr::vector<T> &Values() const { return values_; }
+
+  /// @brief Gets element (row, col), zero when it is not stored.
+  /// @note O(log k) for k entries in the row or column.
+  /// @throw std::out_of_range if the position is out of range.
+  T Coeff(std::size_t row, std::size_t col) const;
+
+  /// @brief Converts the matrix to a dense S21Matrix.
+  S21Matrix<T> ToDense() const;
+
+  /// @brief Gets the same matrix stored in `layout`.
+  /// @note A counting sort over the entries, O(nnz + rows + cols).
+  S21SparseMatrix ToLayout(SparseLayout layout) const;
+
+  /// @brief Creates the transposed matrix in the same layout.
+  /// @note O(nnz + rows + cols).
+  S21SparseMatrix Transpose() const;
+
+  /// @brief Multiplies every element by a scalar.
+  void MulNumber(T num);
+
+  /// @brief Adds a sparse matrix to this one.
+  /// @note Entries present in either operand stay stored even when they
+  /// cancel out. `other` is converted first if its layout differs.
+  /// @throw std::runtime_error if the dimensions differ.
+  void SumMatrix(const S21SparseMatrix &other);
+
+  /// @brief Subtracts a sparse matrix from this one.
+  /// @throw std::runtime_error if the dimensions differ.
+  void SubMatrix(const S21SparseMatrix &other);
+
+  /// @brief Multiplies the matrix by a dense vector (SpMV).
+  /// @note Large CSR matrices are split into bands of rows with about the
+  /// same number of entries, one task per band on ThreadPool::Instance().
+  /// For CSC every task accumulates its columns into a private vector and
+  /// the vectors are summed afterwards.
+  /// @param x A vector of GetCols() elements.
+  /// @return A vector of GetRows() elements.
+  /// @throw std::runtime_error if the size of `x` does not match.
+  std::vector<T> MulVector(const std::vector<T> &x) const;
+
+  /// @brief Multiplies the matrix by a dense matrix (SpMM).
+  /// @note Parallel over bands of rows for CSR and over bands of columns of
+  /// `other` for CSC.
+  /// @return A new dense matrix of GetRows() x other.GetCols().
+  /// @throw std::runtime_error if the dimensions are incompatible.
+  S21Matrix<T> MulMatrix(const S21Matrix<T> &other) const;
+
+  /// @brief Multiplies the matrix by a sparse matrix.
+  /// @note Gustavson's algorithm, row by row through a dense accumulator:
+  /// a symbolic pass counts the entries of every result row and a numeric
+  /// pass fills them, both parallel over bands of rows. The result has the
+  /// layout of this matrix; `other` is converted first if its layout
+  /// differs.
+  /// @throw std::runtime_error if the dimensions are incompatible.
+  S21SparseMatrix MulMatrix(const S21SparseMatrix &other) const;
+
+ private:
+  S21SparseMatrix(std::size_t rows, std::size_t cols, SparseLayout layout,
+                  std::pmr::vector<std::size_t> offsets,
+                  std::pmr::vector<std::size_t> indices,
+                  std::pmr::vector<T> values);
+
+  std::size_t Outer() const {
+    return layout_ == SparseLayout::kCsr ? rows_ : cols_;
+  }
+  std::size_t Inner() const {
+    return layout_ == SparseLayout::kCsr ? cols_ : rows_;
+  }
+  S21SparseMatrix Reordered(std::size_t rows, std::size_t cols,
+                            SparseLayout layout) const;
+  void Merge(const S21SparseMatrix &other, bool subtract);
+
+  std::size_t rows_;
+  std::size_t cols_;
+  SparseLayout layout_;
+  std::pmr::vector<std::size_t> offsets_;
+  std::pmr::vector<std::size_t> indices_;
+  std::pmr::vector<T> values_;
+};
+
+namespace detail {
+
+/// @brief Runs `body(first, last)` over bands of [0, outer) holding about
+/// the same number of entries according to `offsets`.
+/// @param work Multiply-adds of the whole loop, which decides whether it
+/// runs in parallel.
+template <typename Body>
+void SparseParallelFor(std::size_t outer, const std::size_t *offsets,
+                       std::size_t work, Body &&body) {
+  ThreadPool &pool = ThreadPool::Instance();
+  if (outer < 2 || work < S21_SPARSE_PARALLEL || pool.GetThreadCount() == 1 ||
+      ThreadPool::IsSerialContext()) {
+    body(std::size_t(0), outer);
+    return;
+  }
+  const std::size_t tasks = std::min(outer, 4 * pool.GetThreadCount());
+  std::vector<std::size_t> bounds(tasks + 1, outer);
+  bounds[0] = 0;
+  const std::size_t total = offsets[outer];
+  for (std::size_t t = 1; t < tasks; t++) {
+    const std::size_t target = total / tasks * t;
+    const std::size_t split = static_cast<std::size_t>(
+        std::upper_bound(offsets, offsets + outer + 1, target) - offsets - 1);
+    bounds[t] = std::max(bounds[t - 1], split);
+  }
+  pool.ParallelFor(tasks, [&](std::size_t t) {
+    if (bounds[t] < bounds[t + 1]) body(bounds[t], bounds[t + 1]);
+  });
+}
+
+}  // namespace detail
+
+template <typename T>
+S21SparseMatrix<T>::S21SparseMatrix(std::size_t rows, std::size_t cols,
+                                    SparseLayout layout,
+                                    std::pmr::memory_resource *resource)
+    : rows_(rows),
+      cols_(cols),
+      layout_(layout),
+      offsets_(Outer() + 1, 0, resource),
+      indices_(resource),
+      values_(resource) {}
+
+template <typename T>
+S21SparseMatrix<T>::S21SparseMatrix(std::size_t rows, std::size_t cols,
+                                    SparseLayout layout,
+                                    std::pmr::vector<std::size_t> offsets,
+                                    std::pmr::vector<std::size_t> indices,
+                                    std::pmr::vector<T> values)
+    : rows_(rows),
+      cols_(cols),
+      layout_(layout),
+      offsets_(std::move(offsets)),
+      indices_(std::move(indices)),
+      values_(std::move(values)) {}
+
+template <typename T>
+S21SparseMatrix<T>::S21SparseMatrix(std::size_t rows, std::size_t cols,
+                                    const std::vector<Triplet> &triplets,
+                                    SparseLayout layout,
+                                    std::pmr::memory_resource *resource)
+    : S21SparseMatrix(rows, cols, layout, resource) {
+  const bool csr = layout == SparseLayout::kCsr;
+  const std::size_t inner = Inner();
+  std::size_t count = triplets.size();
+  for (const Triplet &t : triplets)
+    if (t.row >= rows || t.col >= cols)
+      throw std::out_of_range("Triplet index out of range");
+
+  // Two stable counting sorts, by the inner and then by the outer index,
+  // leave every segment sorted.
+  std::vector<std::size_t> by_inner(inner + 1, 0), order(count);
+  for (const Triplet &t : triplets) by_inner[(csr ? t.col : t.row) + 1]++;
+  for (std::size_t i = 0; i < inner; i++) by_inner[i + 1] += by_inner[i];
+  for (std::size_t k = 0; k < count; k++) {
+    const Triplet &t = triplets[k];
+    order[by_inner[csr ? t.col : t.row]++] = k;
+  }
+  std::vector<std::size_t> cursor(Outer() + 1, 0), sorted(count);
+  for (const Triplet &t : triplets) cursor[(csr ? t.row : t.col) + 1]++;
+  for (std::size_t i = 0; i < Outer(); i++) cursor[i + 1] += cursor[i];
+  for (std::size_t k : order) {
+    const Triplet &t = triplets[k];
+    sorted[cursor[csr ? t.row : t.col]++] = k;
+  }
+
+  indices_.reserve(count);
+  values_.reserve(count);
+  std::size_t k = 0;
+  for (std::size_t outer = 0; outer < Outer(); outer++) {
+    for (; k < cursor[outer]; k++) {
+      const Triplet &t = triplets[sorted[k]];
+      const std::size_t index = csr ? t.col : t.row;
+      if (indices_.size() > offsets_[outer] && indices_.back() == index) {
+        values_.back() += t.value;
+      } else {
+        indices_.push_back(index);
+        values_.push_back(t.value);
+      }
+    }
+    offsets_[outer + 1] = indices_.size();
+  }
+}
+
+template <typename T>
+S21SparseMatrix<T>::S21SparseMatrix(const S21Matrix<T> &dense, T threshold,
+                                    SparseLayout layout,
+                                    std::pmr::memory_resource *resource)
+    : S21SparseMatrix(dense.GetRows(), dense.GetCols(), SparseLayout::kCsr,
+                      resource) {
+  for (std::size_t i = 0; i < rows_; i++) {
+    const T *row = dense.Data() + i * dense.Stride();
+    for (std::size_t j = 0; j < cols_; j++) {
+      const bool negative = std::is_signed_v<T> && row[j] < T(0);
+      if ((negative ? T(-row[j]) : row[j]) > threshold) {
+        indices_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    offsets_[i + 1] = indices_.size();
+  }
+  if (layout != layout_) *this = ToLayout(layout);
+}
+
+template <typename T>
+T S21SparseMatrix<T>::Coeff(std::size_t row, std::size_t col) const {
+  if (row >= rows_ || col >= cols_)
+    throw std::out_of_range("Matrix row or column index out of range");
+  const bool csr = layout_ == SparseLayout::kCsr;
+  const std::size_t outer = csr ? row : col, index = csr ? col : row;
+  const auto first = indices_.begin() + offsets_[outer];
+  const auto last = indices_.begin() + offsets_[outer + 1];
+  const auto found = std::lower_bound(first, last, index);
+  if (found == last || *found != index) return T(0);
+  return values_[found - indices_.begin()];
+}
+
+template <typename T>
+S21Matrix<T> S21SparseMatrix<T>::ToDense() const {
+  S21Matrix<T> result(rows_, cols_, GetResource());
+  const bool csr = layout_ == SparseLayout::kCsr;
+  for (std::size_t outer = 0; outer < Outer(); outer++) {
+    for (std::size_t k = offsets_[outer]; k < offsets_[outer + 1]; k++) {
+      if (csr)
+        result(outer, indices_[k]) = values_[k];
+      else
+        result(indices_[k], outer) = values_[k];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21SparseMatrix<T> S21SparseMatrix<T>::Reordered(std::size_t rows,
+                                                 std::size_t cols,
+                                                 SparseLayout layout) const {
+  // Entries grouped by inner index: the compressed form of the transpose.
+  const std::size_t inner = Inner();
+  std::pmr::vector<std::size_t> offsets(inner + 1, 0, GetResource());
+  std::pmr::vector<std::size_t> indices(GetNonZeros(), GetResource());
+  std::pmr::vector<T> values(GetNonZeros(), GetResource());
+  for (std::size_t index : indices_) offsets[index + 1]++;
+  for (std::size_t i = 0; i < inner; i++) offsets[i + 1] += offsets[i];
+  std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+  for (std::size_t outer = 0; outer < Outer(); outer++) {
+    for (std::size_t k = offsets_[outer]; k < offsets_[outer + 1]; k++) {
+      const std::size_t position = cursor[indices_[k]]++;
+      indices[position] = outer;
+      values[position] = values_[k];
+    }
+  }
+  return S21SparseMatrix(rows, cols, layout, std::move(offsets),
+                         std::move(indices), std::move(values));
+}
+
+template <typename T>
+S21SparseMatrix<T> S21SparseMatrix<T>::ToLayout(SparseLayout layout) const {
+  if (layout == layout_)
+    return S21SparseMatrix(
+        rows_, cols_, layout_,
+        std::pmr::vector<std::size_t>(offsets_, GetResource()),
+        std::pmr::vector<std::size_t>(indices_, GetResource()),
+        std::pmr::vector<T>(values_, GetResource()));
+  return Reordered(rows_, cols_, layout);
+}
+
+template <typename T>
+S21SparseMatrix<T> S21SparseMatrix<T>::Transpose() const {
+  return Reordered(cols_, rows_, layout_);
+}
+
+template <typename T>
+void S21SparseMatrix<T>::MulNumber(T num) {
+  simd::Scale(values_.data(), num, values_.size());
+}
+
+template <typename T>
+void S21SparseMatrix<T>::Merge(const S21SparseMatrix &other, bool subtract) {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::runtime_error("Matrices dimensions are not equal");
+  if (other.layout_ != layout_)
+    return Merge(other.ToLayout(layout_), subtract);
+  std::pmr::vector<std::size_t> offsets(Outer() + 1, 0, GetResource());
+  std::pmr::vector<std::size_t> indices(GetResource());
+  std::pmr::vector<T> values(GetResource());
+  indices.reserve(GetNonZeros() + other.GetNonZeros());
+  values.reserve(GetNonZeros() + other.GetNonZeros());
+  for (std::size_t outer = 0; outer < Outer(); outer++) {
+    std::size_t a = offsets_[outer], b = other.offsets_[outer];
+    const std::size_t a_end = offsets_[outer + 1];
+    const std::size_t b_end = other.offsets_[outer + 1];
+    while (a < a_end || b < b_end) {
+      const std::size_t a_index =
+          a < a_end ? indices_[a] : std::numeric_limits<std::size_t>::max();
+      const std::size_t b_index = b < b_end
+                                      ? other.indices_[b]
+                                      : std::numeric_limits<std::size_t>::max();
+      if (a_index < b_index) {
+        indices.push_back(a_index);
+        values.push_back(values_[a++]);
+      } else if (b_index < a_index) {
+        indices.push_back(b_index);
+        values.push_back(subtract ? T(0) - other.values_[b++]
+                                  : other.values_[b++]);
+      } else {
+        indices.push_back(a_index);
+        values.push_back(subtract ? values_[a++] - other.values_[b++]
+                                  : values_[a++] + other.values_[b++]);
+      }
+    }
+    offsets[outer + 1] = indices.size();
+  }
+  offsets_ = std::move(offsets);
+  indices_ = std::move(indices);
+  values_ = std::move(values);
+}
+
+template <typename T>
+void S21SparseMatrix<T>::SumMatrix(const S21SparseMatrix &other) {
+  Merge(other, false);
+}
+
+template <typename T>
+void S21SparseMatrix<T>::SubMatrix(const S21SparseMatrix &other) {
+  Merge(other, true);
+}
+
+template <typename T>
+std::vector<T> S21SparseMatrix<T>::MulVector(const std::vector<T> &x) const {
+  if (x.size() != cols_)
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  std::vector<T> y(rows_, T(0));
+  if (layout_ == SparseLayout::kCsr) {
+    detail::SparseParallelFor(
+        rows_, offsets_.data(), GetNonZeros(),
+        [&](std::size_t first, std::size_t last) {
+          for (std::size_t i = first; i < last; i++) {
+            T sum = T(0);
+            for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; k++)
+              sum += values_[k] * x[indices_[k]];
+            y[i] = sum;
+          }
+        });
+    return y;
+  }
+  // Bands of columns scatter into rows that overlap, so each band gets its
+  // own accumulator; the first one is `y` itself.
+  ThreadPool &pool = ThreadPool::Instance();
+  const bool parallel = GetNonZeros() >= S21_SPARSE_PARALLEL &&
+                        pool.GetThreadCount() > 1 &&
+                        !ThreadPool::IsSerialContext() && cols_ > 1;
+  const std::size_t tasks =
+      parallel ? std::min(cols_, pool.GetThreadCount()) : 1;
+  std::vector<std::vector<T>> partial(tasks - 1, std::vector<T>(rows_, T(0)));
+  auto band = [&](std::size_t task) {
+    T *out = task == 0 ? y.data() : partial[task - 1].data();
+    const std::size_t first = cols_ * task / tasks;
+    const std::size_t last = cols_ * (task + 1) / tasks;
+    for (std::size_t j = first; j < last; j++)
+      for (std::size_t k = offsets_[j]; k < offsets_[j + 1]; k++)
+        out[indices_[k]] += values_[k] * x[j];
+  };
+  if (tasks == 1) {
+    band(0);
+  } else {
+    pool.ParallelFor(tasks, band);
+  }
+  for (const std::vector<T> &p : partial)
+    for (std::size_t i = 0; i < rows_; i++) y[i] += p[i];
+  return y;
+}
+
+template <typename T>
+S21Matrix<T> S21SparseMatrix<T>::MulMatrix(const S21Matrix<T> &other) const {
+  if (cols_ != other.GetRows())
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  const std::size_t n = other.GetCols();
+  S21Matrix<T> result(rows_, n, GetResource());
+  const T *b = other.Data();
+  const std::size_t ldb = other.Stride(), ldc = result.Stride();
+  T *c = result.Data();
+  if (layout_ == SparseLayout::kCsr) {
+    detail::SparseParallelFor(
+        rows_, offsets_.data(), GetNonZeros() * n,
+        [&](std::size_t first, std::size_t last) {
+          for (std::size_t i = first; i < last; i++) {
+            T *c_row = c + i * ldc;
+            for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; k++) {
+              const T value = values_[k];
+              const T *b_row = b + indices_[k] * ldb;
+              for (std::size_t j = 0; j < n; j++) c_row[j] += value * b_row[j];
+            }
+          }
+        });
+    return result;
+  }
+  // Column j of A adds to every row it touches, so the tasks split the
+  // columns of the result instead.
+  auto slice = [&](std::size_t first, std::size_t last) {
+    for (std::size_t col = 0; col < cols_; col++) {
+      const T *b_row = b + col * ldb;
+      for (std::size_t k = offsets_[col]; k < offsets_[col + 1]; k++) {
+        const T value = values_[k];
+        T *c_row = c + indices_[k] * ldc;
+        for (std::size_t j = first; j < last; j++) c_row[j] += value * b_row[j];
+      }
+    }
+  };
+  ThreadPool &pool = ThreadPool::Instance();
+  if (GetNonZeros() * n < S21_SPARSE_PARALLEL || n < 2 ||
+      pool.GetThreadCount() == 1 || ThreadPool::IsSerialContext()) {
+    slice(0, n);
+    return result;
+  }
+  const std::size_t tasks = std::min(n, pool.GetThreadCount());
+  pool.ParallelFor(tasks, [&](std::size_t task) {
+    slice(n * task / tasks, n * (task + 1) / tasks);
+  });
+  return result;
+}
+
+template <typename T>
+S21SparseMatrix<T> S21SparseMatrix<T>::MulMatrix(
+    const S21SparseMatrix &other) const {
+  if (cols_ != other.rows_)
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  if (other.layout_ != layout_) return MulMatrix(other.ToLayout(layout_));
+  // In CSC the arrays of A and B are the CSR arrays of A^T and B^T, and
+  // C^T = B^T A^T, so the same row-wise product serves both layouts.
+  const bool csr = layout_ == SparseLayout::kCsr;
+  const S21SparseMatrix &left = csr ? *this : other;
+  const S21SparseMatrix &right = csr ? other : *this;
+  const std::size_t outer = left.Outer(), width = right.Inner();
+  constexpr std::size_t kUnset = std::numeric_limits<std::size_t>::max();
+
+  std::size_t work = 0;
+  for (std::size_t k = 0; k < left.GetNonZeros(); k++) {
+    const std::size_t p = left.indices_[k];
+    work += right.offsets_[p + 1] - right.offsets_[p];
+  }
+
+  // Symbolic pass: the number of distinct indices in every result row.
+  std::pmr::vector<std::size_t> offsets(outer + 1, 0, GetResource());
+  detail::SparseParallelFor(
+      outer, left.offsets_.data(), work,
+      [&](std::size_t first, std::size_t last) {
+        thread_local std::vector<std::size_t> seen;
+        if (seen.size() < width) seen.resize(width, kUnset);
+        for (std::size_t i = first; i < last; i++) {
+          std::size_t count = 0;
+          for (std::size_t k = left.offsets_[i]; k < left.offsets_[i + 1];
+               k++) {
+            const std::size_t p = left.indices_[k];
+            for (std::size_t q = right.offsets_[p]; q < right.offsets_[p + 1];
+                 q++) {
+              if (seen[right.indices_[q]] != i) {
+                seen[right.indices_[q]] = i;
+                count++;
+              }
+            }
+          }
+          offsets[i + 1] = count;
+          for (std::size_t k = left.offsets_[i]; k < left.offsets_[i + 1];
+               k++) {
+            const std::size_t p = left.indices_[k];
+            for (std::size_t q = right.offsets_[p]; q < right.offsets_[p + 1];
+                 q++)
+              seen[right.indices_[q]] = kUnset;
+          }
+        }
+      });
+  for (std::size_t i = 0; i < outer; i++) offsets[i + 1] += offsets[i];
+
+  // Numeric pass: accumulate every row densely, then sort its indices.
+  std::pmr::vector<std::size_t> indices(offsets[outer], GetResource());
+  std::pmr::vector<T> values(offsets[outer], GetResource());
+  detail::SparseParallelFor(
+      outer, left.offsets_.data(), work,
+      [&](std::size_t first, std::size_t last) {
+        thread_local std::vector<std::size_t> position;
+        if (position.size() < width) position.resize(width, kUnset);
+        thread_local std::vector<T> accumulator;
+        if (accumulator.size() < width) accumulator.resize(width, T(0));
+        for (std::size_t i = first; i < last; i++) {
+          std::size_t *row_indices = indices.data() + offsets[i];
+          std::size_t count = 0;
+          for (std::size_t k = left.offsets_[i]; k < left.offsets_[i + 1];
+               k++) {
+            const std::size_t p = left.indices_[k];
+            const T value = left.values_[k];
+            for (std::size_t q = right.offsets_[p]; q < right.offsets_[p + 1];
+                 q++) {
+              const std::size_t j = right.indices_[q];
+              if (position[j] == kUnset) {
+                position[j] = count;
+                row_indices[count++] = j;
+              }
+              accumulator[j] += value * right.values_[q];
+            }
+          }
+          std::sort(row_indices, row_indices + count);
+          T *row_values = values.data() + offsets[i];
+          for (std::size_t c = 0; c < count; c++) {
+            const std::size_t j = row_indices[c];
+            row_values[c] = accumulator[j];
+            accumulator[j] = T(0);
+            position[j] = kUnset;
+          }
+        }
+      });
+  return S21SparseMatrix(rows_, other.cols_, layout_, std::move(offsets),
+                         std::move(indices), std::move(values));
+}
+
+/// @brief Multiplies a sparse matrix by a dense one.
+/// @return A new dense matrix holding the product.
+template <typename T>
+S21Matrix<T> operator*(const S21SparseMatrix<T> &lhs,
+                       const S21Matrix<T> &rhs) {
+  return lhs.MulMatrix(rhs);
+}
+
+/// @brief Multiplies two sparse matrices.
+/// @return A new sparse matrix in the layout of `lhs`.
+template <typename T>
+S21SparseMatrix<T> operator*(const S21SparseMatrix<T> &lhs,
+                             const S21SparseMatrix<T> &rhs) {
+  return lhs.MulMatrix(rhs);
+}
+
+/// @brief Adds two sparse matrices.
+/// @return A new sparse matrix in the layout of `lhs`.
+template <typename T>
+S21SparseMatrix<T> operator+(S21SparseMatrix<T> lhs,
+                             const S21SparseMatrix<T> &rhs) {
+  lhs.SumMatrix(rhs);
+  return lhs;
+}
+
+/// @brief Subtracts a sparse matrix from another one.
+/// @return A new sparse matrix in the layout of `lhs`.
+template <typename T>
+S21SparseMatrix<T> operator-(S21SparseMatrix<T> lhs,
+                             const S21SparseMatrix<T> &rhs) {
+  lhs.SubMatrix(rhs);
+  return lhs;
+}
+
+}  // namespace S21
+
+#endif  // S21_SPARSE_HPP_
@@ -0,0 +1,288 @@
+#ifndef S21_STRASSEN_HPP_
+#define S21_STRASSEN_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_expression.hpp"
+#include "s21_gemm.hpp"
+#include "s21_matrix_oop.hpp"
+#include "s21_thread_pool.hpp"
+
+/// @file
+/// @brief Strassen-Winograd multiplication for large products.
+/// @note Each level of recursion replaces the eight half-size products of
+/// the classical algorithm by seven and fifteen additions. Recursion stops
+/// at the crossover, below which the blocked GEMM of s21_gemm.hpp is
+/// faster; odd dimensions are peeled off and handled by that kernel too.
+/// @note The result is not as accurate as the one of MulMatrix(): the
+/// error bound is normwise rather than elementwise, and it grows by a
+/// constant factor with every level of recursion. Small elements of a
+/// product of badly scaled matrices can lose all of their digits. This is
+/// why the algorithm is only used when asked for.
+
+#ifndef S21_STRASSEN_CROSSOVER
+#define S21_STRASSEN_CROSSOVER 512  // Smallest dimension that recurses
+#endif
+
+namespace S21 {
+
+/// @brief Settings of MulMatrixStrassen().
+struct StrassenOptions {
+  /// @brief Smallest dimension at which a product is split; 0 selects
+  /// S21_STRASSEN_CROSSOVER.
+  std::size_t crossover = 0;
+};
+
+/// @brief Multiplies two matrices with the Strassen-Winograd algorithm.
+/// @note Products whose smallest dimension is below the crossover are
+/// computed by the classical kernel, exactly as `a * b`. Larger ones save
+/// an eighth of the flops per level of recursion at the cost of accuracy,
+/// see s21_strassen.hpp.
+/// @note All the workspace is allocated once per call. For n x n operands
+/// it is about two thirds of an n x n matrix on one thread. When
+/// ThreadPool::Instance() has more than one thread the seven products of
+/// the first level run in parallel, which takes about four n x n matrices.
+/// @param a The left factor, with as many columns as `b` has rows.
+/// @param b The right factor.
+/// @param options Crossover to the classical kernel.
+/// @return A new matrix with the memory resource of `a`.
+/// @throw std::runtime_error if the dimensions are incompatible.
+template <typename T>
+S21Matrix<T> MulMatrixStrassen(
+    const S21Matrix<T> &a, const S21Matrix<T> &b,
+    const StrassenOptions &options = StrassenOptions());
+
+namespace detail {
+
+/// @brief Elements of a workspace slice of `count`, rounded up to whole
+/// cache lines.
+template <typename T>
+std::size_t StrassenSlice(std::size_t count) {
+  constexpr std::size_t kLine = AlignedBuffer<T>::kAlignment / sizeof(T);
+  return (count + kLine - 1) / kLine * kLine;
+}
+
+/// @brief Workspace of StrassenSerial() for an m x k by k x n product.
+template <typename T>
+std::size_t StrassenWorkspace(std::size_t m, std::size_t k, std::size_t n,
+                              std::size_t crossover) {
+  if (std::min({m, k, n}) < crossover) return 0;
+  const std::size_t hm = m / 2, hk = k / 2, hn = n / 2;
+  return StrassenSlice<T>(hm * std::max(hk, hn)) + StrassenSlice<T>(hk * hn) +
+         StrassenWorkspace<T>(hm, hk, hn, crossover);
+}
+
+/// @brief z = Op(x, y) over a rows x cols block; z may be x or y.
+template <typename Op, typename T>
+void StrassenCombine(std::size_t rows, std::size_t cols, const T *x,
+                     std::size_t ldx, const T *y, std::size_t ldy, T *z,
+                     std::size_t ldz) {
+  for (std::size_t i = 0; i < rows; i++) {
+    const T *x_row = x + i * ldx;
+    const T *y_row = y + i * ldy;
+    T *z_row = z + i * ldz;
+    for (std::size_t j = 0; j < cols; j++)
+      z_row[j] = Op::Apply(x_row[j], y_row[j]);
+  }
+}
+
+/// @brief Completes the product of the even-sized leading blocks computed
+/// by the recursion with the peeled last row, column and inner index.
+template <typename T>
+void StrassenPeel(std::size_t m, std::size_t n, std::size_t k, const T *a,
+                  std::size_t lda, const T *b, std::size_t ldb, T *c,
+                  std::size_t ldc) {
+  const std::size_t m2 = m & ~std::size_t(1), n2 = n & ~std::size_t(1);
+  const std::size_t k2 = k & ~std::size_t(1);
+  if (k2 != k)
+    Gemm(m2, n2, std::size_t(1), T(1), a + k2, lda, b + k2 * ldb, ldb, T(1),
+         c, ldc);
+  if (n2 != n)
+    Gemm(m2, std::size_t(1), k, T(1), a, lda, b + n2, ldb, T(0), c + n2, ldc);
+  if (m2 != m)
+    Gemm(std::size_t(1), n, k, T(1), a + m2 * lda, lda, b, ldb, T(0),
+         c + m2 * ldc, ldc);
+}
+
+/// @brief C = A * B in the schedule of Boyer, Dumas, Pernet and Zhou that
+/// keeps the products in the quadrants of C and needs two temporaries.
+/// @param work StrassenWorkspace() elements.
+template <typename T>
+void StrassenSerial(std::size_t m, std::size_t n, std::size_t k, const T *a,
+                    std::size_t lda, const T *b, std::size_t ldb, T *c,
+                    std::size_t ldc, std::size_t crossover, T *work) {
+  if (std::min({m, k, n}) < crossover)
+    return Gemm(m, n, k, T(1), a, lda, b, ldb, T(0), c, ldc);
+
+  const std::size_t hm = m / 2, hk = k / 2, hn = n / 2;
+  const T *a11 = a, *a12 = a + hk, *a21 = a + hm * lda, *a22 = a21 + hk;
+  const T *b11 = b, *b12 = b + hn, *b21 = b + hk * ldb, *b22 = b21 + hn;
+  T *c11 = c, *c12 = c + hn, *c21 = c + hm * ldc, *c22 = c21 + hn;
+  T *x = work;  // S1-S4 (hm x hk), then P1 (hm x hn)
+  T *y = x + StrassenSlice<T>(hm * std::max(hk, hn));  // T1-T4 (hk x hn)
+  T *rest = y + StrassenSlice<T>(hk * hn);
+  auto product = [&](const T *p, std::size_t ldp, const T *q, std::size_t ldq,
+                     T *r, std::size_t ldr) {
+    StrassenSerial(hm, hn, hk, p, ldp, q, ldq, r, ldr, crossover, rest);
+  };
+  using Add = AddOp;
+  using Sub = SubOp;
+
+  StrassenCombine<Sub>(hm, hk, a11, lda, a21, lda, x, hk);  // S3
+  StrassenCombine<Sub>(hk, hn, b22, ldb, b12, ldb, y, hn);  // T3
+  product(x, hk, y, hn, c21, ldc);                          // P7
+  StrassenCombine<Add>(hm, hk, a21, lda, a22, lda, x, hk);  // S1
+  StrassenCombine<Sub>(hk, hn, b12, ldb, b11, ldb, y, hn);  // T1
+  product(x, hk, y, hn, c22, ldc);                          // P5
+  StrassenCombine<Sub>(hk, hn, b22, ldb, y, hn, y, hn);     // T2
+  StrassenCombine<Sub>(hm, hk, x, hk, a11, lda, x, hk);     // S2
+  product(x, hk, y, hn, c12, ldc);                          // P6
+  StrassenCombine<Sub>(hm, hk, a12, lda, x, hk, x, hk);     // S4
+  product(x, hk, b22, ldb, c11, ldc);                       // P3
+  product(a11, lda, b11, ldb, x, hn);                       // P1
+  StrassenCombine<Add>(hm, hn, x, hn, c12, ldc, c12, ldc);  // U2
+  StrassenCombine<Add>(hm, hn, c12, ldc, c21, ldc, c21, ldc);  // U3
+  StrassenCombine<Add>(hm, hn, c12, ldc, c22, ldc, c12, ldc);  // U4
+  StrassenCombine<Add>(hm, hn, c21, ldc, c22, ldc, c22, ldc);  // U7 = C22
+  StrassenCombine<Add>(hm, hn, c12, ldc, c11, ldc, c12, ldc);  // U5 = C12
+  StrassenCombine<Sub>(hk, hn, y, hn, b21, ldb, y, hn);        // T4
+  product(a22, lda, y, hn, c11, ldc);                          // P4
+  StrassenCombine<Sub>(hm, hn, c21, ldc, c11, ldc, c21, ldc);  // U6 = C21
+  product(a12, lda, b21, ldb, c11, ldc);                       // P2
+  StrassenCombine<Add>(hm, hn, x, hn, c11, ldc, c11, ldc);     // U1 = C11
+
+  StrassenPeel(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+/// @brief C = A * B with the seven products of the first level computed in
+/// parallel on `pool` and the levels below them by StrassenSerial().
+/// @note Each product gets its own operands and result, so all of them
+/// are held at once; four results live in the quadrants of C.
+template <typename T>
+void StrassenParallel(ThreadPool &pool, std::size_t m, std::size_t n,
+                      std::size_t k, const T *a, std::size_t lda, const T *b,
+                      std::size_t ldb, T *c, std::size_t ldc,
+                      std::size_t crossover) {
+  const std::size_t hm = m / 2, hk = k / 2, hn = n / 2;
+  const std::size_t a_size = StrassenSlice<T>(hm * hk);
+  const std::size_t b_size = StrassenSlice<T>(hk * hn);
+  const std::size_t c_size = StrassenSlice<T>(hm * hn);
+  const std::size_t sub_size = StrassenWorkspace<T>(hm, hk, hn, crossover);
+  AlignedBuffer<T> buffer;
+  T *const s = buffer.Reserve(4 * a_size + 4 * b_size + 3 * c_size +
+                              7 * sub_size);
+  T *const t = s + 4 * a_size;
+  T *const p = t + 4 * b_size;  // P1, P6 and P7
+  T *const sub = p + 3 * c_size;
+
+  const T *a11 = a, *a12 = a + hk, *a21 = a + hm * lda, *a22 = a21 + hk;
+  const T *b11 = b, *b12 = b + hn, *b21 = b + hk * ldb, *b22 = b21 + hn;
+  T *c11 = c, *c12 = c + hn, *c21 = c + hm * ldc, *c22 = c21 + hn;
+  T *s1 = s, *s2 = s + a_size, *s3 = s2 + a_size, *s4 = s3 + a_size;
+  T *t1 = t, *t2 = t + b_size, *t3 = t2 + b_size, *t4 = t3 + b_size;
+  T *p1 = p, *p6 = p + c_size, *p7 = p6 + c_size;
+  using Add = AddOp;
+  using Sub = SubOp;
+
+  pool.ParallelFor(2, [&](std::size_t side) {
+    if (side == 0) {
+      StrassenCombine<Add>(hm, hk, a21, lda, a22, lda, s1, hk);
+      StrassenCombine<Sub>(hm, hk, s1, hk, a11, lda, s2, hk);
+      StrassenCombine<Sub>(hm, hk, a11, lda, a21, lda, s3, hk);
+      StrassenCombine<Sub>(hm, hk, a12, lda, s2, hk, s4, hk);
+    } else {
+      StrassenCombine<Sub>(hk, hn, b12, ldb, b11, ldb, t1, hn);
+      StrassenCombine<Sub>(hk, hn, b22, ldb, t1, hn, t2, hn);
+      StrassenCombine<Sub>(hk, hn, b22, ldb, b12, ldb, t3, hn);
+      StrassenCombine<Sub>(hk, hn, t2, hn, b21, ldb, t4, hn);
+    }
+  });
+
+  struct Product {
+    const T *lhs;
+    std::size_t ldl;
+    const T *rhs;
+    std::size_t ldr;
+    T *result;
+    std::size_t ldo;
+  };
+  const Product products[7] = {
+      {a11, lda, b11, ldb, p1, hn}, {a12, lda, b21, ldb, c11, ldc},
+      {s4, hk, b22, ldb, c12, ldc}, {a22, lda, t4, hn, c21, ldc},
+      {s1, hk, t1, hn, c22, ldc},   {s2, hk, t2, hn, p6, hn},
+      {s3, hk, t3, hn, p7, hn}};
+  pool.ParallelFor(7, [&](std::size_t i) {
+    const ThreadPool::ScopedSerial serial;  // The caller runs products too
+    const Product &q = products[i];
+    StrassenSerial(hm, hn, hk, q.lhs, q.ldl, q.rhs, q.ldr, q.result, q.ldo,
+                   crossover, sub + i * sub_size);
+  });
+
+  // C11 = P1 + P2, C12 = U2 + P5 + P3, C21 = U3 - P4, C22 = U3 + P5 with
+  // U2 = P1 + P6 and U3 = U2 + P7. Rows are independent.
+  const std::size_t kRows = 64;
+  pool.ParallelFor((hm + kRows - 1) / kRows, [&](std::size_t block) {
+    const std::size_t i = block * kRows, rows = std::min(kRows, hm - i);
+    T *u2 = p6 + i * hn, *u3 = p7 + i * hn;
+    StrassenCombine<Add>(rows, hn, c11 + i * ldc, ldc, p1 + i * hn, hn,
+                         c11 + i * ldc, ldc);
+    StrassenCombine<Add>(rows, hn, p1 + i * hn, hn, u2, hn, u2, hn);
+    StrassenCombine<Add>(rows, hn, u2, hn, u3, hn, u3, hn);
+    StrassenCombine<Add>(rows, hn, c12 + i * ldc, ldc, u2, hn, c12 + i * ldc,
+                         ldc);
+    StrassenCombine<Add>(rows, hn, c12 + i * ldc, ldc, c22 + i * ldc, ldc,
+                         c12 + i * ldc, ldc);
+    StrassenCombine<Sub>(rows, hn, u3, hn, c21 + i * ldc, ldc, c21 + i * ldc,
+                         ldc);
+    StrassenCombine<Add>(rows, hn, u3, hn, c22 + i * ldc, ldc, c22 + i * ldc,
+                         ldc);
+  });
+
+  StrassenPeel(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+/// @brief Row-major multiply C = A * B by Strassen-Winograd.
+/// @note Recurses while the smallest of m, n and k is at least `crossover`,
+/// which must be at least 2.
+template <typename T>
+void GemmStrassen(std::size_t m, std::size_t n, std::size_t k, const T *a,
+                  std::size_t lda, const T *b, std::size_t ldb, T *c,
+                  std::size_t ldc, std::size_t crossover) {
+  ThreadPool &pool = ThreadPool::Instance();
+  if (std::min({m, n, k}) >= crossover && pool.GetThreadCount() > 1 &&
+      !ThreadPool::IsSerialContext())
+    return StrassenParallel(pool, m, n, k, a, lda, b, ldb, c, ldc, crossover);
+  AlignedBuffer<T> work;
+  StrassenSerial(m, n, k, a, lda, b, ldb, c, ldc, crossover,
+                 work.Reserve(StrassenWorkspace<T>(m, k, n, crossover)));
+}
+
+}  // namespace detail
+
+template <typename T>
+S21Matrix<T> MulMatrixStrassen(const S21Matrix<T> &a, const S21Matrix<T> &b,
+                               const StrassenOptions &options) {
+  static_assert(std::is_floating_point_v<T>,
+                "Strassen multiplication requires a floating-point type");
+  if (a.GetCols() != b.GetRows())
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  S21_INSTRUMENT(kMulMatrixStrassen,
+                 2 * a.GetRows() * a.GetCols() * b.GetCols());
+  const std::size_t crossover =
+      std::max<std::size_t>(2, options.crossover ? options.crossover
+                                                 : S21_STRASSEN_CROSSOVER);
+  S21Matrix<T> result(a.GetRows(), b.GetCols(), a.GetResource());
+  if (result.GetRows() != 0 && result.GetCols() != 0)
+    detail::GemmStrassen(a.GetRows(), b.GetCols(), a.GetCols(), a.Data(),
+                         a.Stride(), b.Data(), b.Stride(), result.Data(),
+                         result.Stride(), crossover);
+  return result;
+}
+
+}  // namespace S21
+
+#endif  // S21_STRASSEN_HPP_
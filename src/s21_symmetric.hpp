@@ -0,0 +1,796 @@
+#ifndef S21_SYMMETRIC_HPP_
+#define S21_SYMMETRIC_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_transpose.hpp"
+#include "s21_triangular.hpp"
+#include "s21_vector.hpp"
+
+#ifndef S21_CHOLESKY_BLOCK
+#define S21_CHOLESKY_BLOCK 64  // Panel width of the blocked Cholesky
+#endif
+
+#ifndef S21_SYMMETRIC_PARALLEL
+#define S21_SYMMETRIC_PARALLEL 32768  // Elements of an update run serially
+#endif
+
+/// @file
+/// @brief Factorizations of symmetric matrices: Cholesky, A = L * L^T, for
+/// positive definite ones and LDL^T with Bunch-Kaufman pivoting,
+/// P * A * P^T = L * D * L^T, for indefinite ones.
+/// @note Both read only the lower triangle of A and need about n^3 / 3
+/// operations, half of LU. Once factorized, the strictly upper triangle of
+/// the factor storage is filled with L^T, so that solves run the same
+/// row-major forward and back substitution as LU.
+
+namespace S21 {
+
+namespace detail {
+
+/// @brief Runs `body(first, last)` on blocks of the rows [first, last) of
+/// an update of `work` elements, in parallel once it is large enough.
+/// @note Several blocks per thread let the pool balance the rows of a
+/// triangle, whose lengths grow with the row index.
+template <typename Body>
+void SymmetricParallelFor(std::size_t first, std::size_t last,
+                          std::size_t work, Body &&body) {
+  ThreadPool &pool = ThreadPool::Instance();
+  const std::size_t threads = pool.GetThreadCount();
+  if (work < S21_SYMMETRIC_PARALLEL || threads == 1 ||
+      ThreadPool::IsSerialContext())
+    return body(first, last);
+  const std::size_t count = last - first;
+  const std::size_t blocks = std::min(count, 4 * threads);
+  pool.ParallelFor(blocks, [&](std::size_t block) {
+    body(first + count * block / blocks, first + count * (block + 1) / blocks);
+  });
+}
+
+/// @brief Copies the strictly lower triangle of an n x n matrix over its
+/// strictly upper triangle, transposed.
+template <typename T>
+void MirrorLower(std::size_t n, T *a, std::size_t ld) {
+  constexpr std::size_t kTile = S21_TRANSPOSE_TILE;
+  for (std::size_t i0 = 0; i0 < n; i0 += kTile) {
+    const std::size_t ib = std::min(kTile, n - i0);
+    for (std::size_t j0 = 0; j0 < i0; j0 += kTile)
+      TransposeBlock(ib, std::min(kTile, n - j0), a + i0 * ld + j0, ld,
+                     a + j0 * ld + i0, ld);
+    for (std::size_t i = i0; i < i0 + ib; i++)
+      for (std::size_t j = i0; j < i; j++) a[j * ld + i] = a[i * ld + j];
+  }
+}
+
+/// @brief Checks the operands of Solve() of a factorization of order n.
+template <typename T>
+void CheckSolveOperands(std::size_t n, const S21MatrixView<const T> &rhs,
+                        const S21MatrixView<T> &x) {
+  if (rhs.GetRows() != n || x.GetRows() != n ||
+      x.GetCols() != rhs.GetCols())
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for solving the system");
+  if (Overlap<T>(rhs, x))
+    throw std::runtime_error("Solve cannot write over its input");
+}
+
+}  // namespace detail
+
+/// @brief Cholesky factorization of a symmetric positive definite matrix,
+/// A = L * L^T.
+/// @note Blocked and right-looking: each panel of S21_CHOLESKY_BLOCK
+/// columns is factored by dot products along contiguous rows, the rows
+/// below it are solved in parallel, and the lower triangle of the trailing
+/// submatrix is updated by GEMMs on column blocks, which skip the blocks
+/// above the diagonal and are split across ThreadPool::Instance().
+/// @note A pivot that is not positive stops the factorization and marks
+/// the matrix as not positive definite; LDLT handles such matrices.
+/// @note The factor, and the results of Solve() and Inverse(), use the
+/// memory resource of the matrix the object was constructed from.
+/// @tparam T The floating-point type of the matrix elements.
+template <typename T = double>
+class Cholesky {
+  static_assert(std::is_floating_point_v<T>,
+                "Cholesky factorization requires a floating-point type");
+
+ public:
+  /// @brief Factorizes a copy of the provided symmetric matrix.
+  /// @note Only the lower triangle is read.
+  explicit Cholesky(const S21Matrix<T> &matrix);
+
+  /// @brief Factorizes the provided symmetric matrix in its own storage.
+  /// @param matrix The matrix to factorize; its buffer is taken over.
+  explicit Cholesky(S21Matrix<T> &&matrix);
+
+  /// @brief Factorizes the value of a matrix expression, such as a view.
+  template <typename E>
+  explicit Cholesky(const MatrixExpression<E> &expr);
+
+  /// @brief Gets the order of the factorized matrix.
+  std::size_t GetSize() const;
+
+  /// @brief Checks whether every pivot was positive.
+  bool IsPositiveDefinite() const;
+
+  /// @brief Gets the lower triangular factor L, with zeros above the
+  /// diagonal.
+  /// @throw std::runtime_error if the matrix is not positive definite.
+  S21Matrix<T> GetL() const;
+
+  /// @brief Calculates the determinant, the squared product of the diagonal
+  /// of L.
+  /// @throw std::runtime_error if the matrix is not positive definite.
+  /// @throw std::overflow_error if the determinant exceeds DBL_MAX.
+  T Determinant() const;
+
+  /// @brief Calculates the natural logarithm of the determinant.
+  /// @note Sums logarithms instead of multiplying, so it stays finite for
+  /// matrices whose determinant overflows or underflows.
+  /// @throw std::runtime_error if the matrix is not positive definite.
+  T LogDeterminant() const;
+
+  /// @brief Solves A * X = B.
+  /// @param rhs The right-hand sides B, one per column.
+  /// @return The solution X with the same shape as B.
+  /// @throw std::runtime_error if B does not have one row per row of A or
+  /// the matrix is not positive definite.
+  S21Matrix<T> Solve(S21MatrixView<const T> rhs) const;
+
+  /// @brief Solves A * X = B into storage owned by the caller.
+  /// @param x The solution, with the shape of B; must not overlap B.
+  /// @throw std::runtime_error if the shapes do not match, X overlaps B or
+  /// the matrix is not positive definite.
+  void Solve(S21MatrixView<const T> rhs, S21MatrixView<T> x) const;
+
+  /// @brief Solves A * x = b for a single right-hand side.
+  S21Vector<T> Solve(const S21Vector<T> &rhs) const;
+
+  /// @brief Solves A * x = b into a vector owned by the caller.
+  /// @param x The solution; must not be `rhs`.
+  void Solve(const S21Vector<T> &rhs, S21Vector<T> &x) const;
+
+  /// @brief Calculates the inverse of the factorized matrix.
+  /// @throw std::runtime_error if the matrix is not positive definite.
+  S21Matrix<T> Inverse() const;
+
+ private:
+  void Factorize();
+  bool FactorizeDiagonalBlock(std::size_t k0, std::size_t k1);
+  void UpdateTrailing(std::size_t k0, std::size_t k1);
+  void CheckSolvable() const;
+  void Substitute(T *x, std::size_t ldx, std::size_t cols) const;
+
+  S21Matrix<T> l_;
+  bool positive_definite_ = true;
+};
+
+/// @brief LDL^T factorization of a symmetric, possibly indefinite matrix
+/// with Bunch-Kaufman pivoting, P * A * P^T = L * D * L^T.
+/// @note L is unit lower triangular and D block diagonal with blocks of
+/// order one and two. At each step the pivot is chosen by the magnitudes in
+/// one or two columns, as in LAPACK's sytrf, which bounds the growth of
+/// the trailing elements. The trailing submatrix then receives a rank-one
+/// or rank-two update whose rows are split across ThreadPool::Instance().
+/// @note A pivot column whose elements are all below EPSILON marks the
+/// matrix as singular, the criterion LU uses.
+/// @tparam T The floating-point type of the matrix elements.
+template <typename T = double>
+class LDLT {
+  static_assert(std::is_floating_point_v<T>,
+                "LDLT factorization requires a floating-point type");
+
+ public:
+  /// @brief Factorizes a copy of the provided symmetric matrix.
+  /// @note Only the lower triangle is read.
+  explicit LDLT(const S21Matrix<T> &matrix);
+
+  /// @brief Factorizes the provided symmetric matrix in its own storage.
+  explicit LDLT(S21Matrix<T> &&matrix);
+
+  /// @brief Factorizes the value of a matrix expression, such as a view.
+  template <typename E>
+  explicit LDLT(const MatrixExpression<E> &expr);
+
+  /// @brief Gets the order of the factorized matrix.
+  std::size_t GetSize() const;
+
+  /// @brief Checks whether a negligible pivot column was encountered.
+  bool IsSingular() const;
+
+  /// @brief Gets the unit lower triangular factor L.
+  S21Matrix<T> GetL() const;
+
+  /// @brief Gets the symmetric block diagonal factor D.
+  S21Matrix<T> GetD() const;
+
+  /// @brief Gets the symmetric permutation.
+  /// @return A vector p such that row and column i of P * A * P^T are row
+  /// and column p[i] of A.
+  const std::vector<std::size_t> &GetPermutation() const;
+
+  /// @brief Calculates the determinant, the product of those of the blocks
+  /// of D.
+  /// @return The determinant, or zero for a singular matrix.
+  /// @throw std::overflow_error if the determinant exceeds DBL_MAX.
+  T Determinant() const;
+
+  /// @brief Calculates the natural logarithm of the absolute value of the
+  /// determinant.
+  /// @return The logarithm, or -infinity for a singular matrix.
+  T LogAbsDeterminant() const;
+
+  /// @brief Gets the sign of the determinant: -1, 0 or 1.
+  int DeterminantSign() const;
+
+  /// @brief Solves A * X = B.
+  /// @throw std::runtime_error if B does not have one row per row of A or
+  /// the matrix is singular.
+  S21Matrix<T> Solve(S21MatrixView<const T> rhs) const;
+
+  /// @brief Solves A * X = B into storage owned by the caller.
+  /// @param x The solution, with the shape of B; must not overlap B.
+  /// @throw std::runtime_error if the shapes do not match, X overlaps B or
+  /// the matrix is singular.
+  void Solve(S21MatrixView<const T> rhs, S21MatrixView<T> x) const;
+
+  /// @brief Solves A * x = b for a single right-hand side.
+  S21Vector<T> Solve(const S21Vector<T> &rhs) const;
+
+  /// @brief Solves A * x = b into a vector owned by the caller.
+  /// @param x The solution; must not be `rhs`.
+  void Solve(const S21Vector<T> &rhs, S21Vector<T> &x) const;
+
+  /// @brief Calculates the inverse of the factorized matrix.
+  /// @throw std::runtime_error if the matrix is singular.
+  S21Matrix<T> Inverse() const;
+
+ private:
+  T &Lower(std::size_t i, std::size_t j);
+  void Factorize();
+  std::size_t ChoosePivot(std::size_t k, std::size_t &step);
+  void Interchange(std::size_t p, std::size_t q);
+  void UpdateOne(std::size_t k, std::vector<T> &w);
+  void UpdateTwo(std::size_t k, std::vector<T> &w);
+  void CheckSolvable() const;
+  void Substitute(T *x, std::size_t ldx, std::size_t cols) const;
+
+  S21Matrix<T> ld_;
+  std::vector<std::size_t> permutation_;
+  std::vector<unsigned char> block_;  // Order of the block of D starting here
+  std::vector<T> subdiagonal_;        // D(k + 1, k) of the blocks of order 2
+  bool singular_ = false;
+};
+
+// Cholesky
+
+template <typename T>
+Cholesky<T>::Cholesky(const S21Matrix<T> &matrix)
+    : Cholesky(S21Matrix<T>(matrix, matrix.GetResource())) {}
+
+template <typename T>
+Cholesky<T>::Cholesky(S21Matrix<T> &&matrix) : l_(std::move(matrix)) {
+  if (l_.GetRows() != l_.GetCols())
+    throw std::runtime_error("Matrix must be square to be factorized");
+  Factorize();
+}
+
+template <typename T>
+template <typename E>
+Cholesky<T>::Cholesky(const MatrixExpression<E> &expr)
+    : Cholesky(S21Matrix<T>(expr)) {}
+
+template <typename T>
+std::size_t Cholesky<T>::GetSize() const {
+  return l_.GetRows();
+}
+
+template <typename T>
+bool Cholesky<T>::IsPositiveDefinite() const {
+  return positive_definite_;
+}
+
+template <typename T>
+bool Cholesky<T>::FactorizeDiagonalBlock(std::size_t k0, std::size_t k1) {
+  const std::size_t ld = l_.Stride();
+  T *a = l_.Data();
+  for (std::size_t i = k0; i < k1; i++) {
+    T *row = a + i * ld;
+    for (std::size_t j = k0; j < i; j++) {
+      const T *l_row = a + j * ld;
+      row[j] = (row[j] - simd::Dot(row + k0, l_row + k0, j - k0)) / l_row[j];
+    }
+    const T pivot = row[i] - simd::Dot(row + k0, row + k0, i - k0);
+    if (!(pivot > T(0))) return false;  // NaN is not positive either
+    row[i] = std::sqrt(pivot);
+  }
+  return true;
+}
+
+template <typename T>
+void Cholesky<T>::UpdateTrailing(std::size_t k0, std::size_t k1) {
+  const std::size_t n = GetSize();
+  const std::size_t ld = l_.Stride();
+  const std::size_t kb = k1 - k0;
+  T *a = l_.Data();
+
+  // L21 = A21 * L11^-T, one independent row at a time.
+  detail::SymmetricParallelFor(
+      k1, n, (n - k1) * kb * kb, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+          T *row = a + i * ld;
+          for (std::size_t j = k0; j < k1; j++) {
+            const T *l_row = a + j * ld;
+            row[j] = (row[j] - simd::Dot(row + k0, l_row + k0, j - k0)) /
+                     l_row[j];
+          }
+        }
+      });
+
+  // A22 -= L21 * L21^T on the lower triangle, by column blocks. The GEMM
+  // needs L21^T row-major, so it is packed once per panel.
+  const std::size_t m = n - k1;
+  S21Matrix<T> l21t(kb, m, ScratchResource());
+  detail::TransposeCopy(m, kb, a + k1 * ld + k0, ld, l21t.Data(),
+                        l21t.Stride());
+  constexpr std::size_t kColumns = 4 * S21_CHOLESKY_BLOCK;
+  for (std::size_t j0 = k1; j0 < n; j0 += kColumns) {
+    const std::size_t jb = std::min(kColumns, n - j0);
+    detail::Gemm(n - j0, jb, kb, T(-1), a + j0 * ld + k0, ld,
+                 l21t.Data() + (j0 - k1), l21t.Stride(), T(1),
+                 a + j0 * ld + j0, ld);
+  }
+}
+
+template <typename T>
+void Cholesky<T>::Factorize() {
+  const std::size_t n = GetSize();
+  for (std::size_t k0 = 0; k0 < n; k0 += S21_CHOLESKY_BLOCK) {
+    const std::size_t k1 = std::min<std::size_t>(k0 + S21_CHOLESKY_BLOCK, n);
+    if (!FactorizeDiagonalBlock(k0, k1)) {
+      positive_definite_ = false;
+      return;
+    }
+    if (k1 < n) UpdateTrailing(k0, k1);
+  }
+  detail::MirrorLower(n, l_.Data(), l_.Stride());
+}
+
+template <typename T>
+void Cholesky<T>::CheckSolvable() const {
+  if (!positive_definite_)
+    throw std::runtime_error("Matrix is not positive definite");
+}
+
+template <typename T>
+S21Matrix<T> Cholesky<T>::GetL() const {
+  CheckSolvable();
+  S21Matrix<T> l(l_, l_.GetResource());
+  for (std::size_t i = 0; i < GetSize(); i++)
+    std::fill_n(l.Data() + i * l.Stride() + i + 1, GetSize() - i - 1, T(0));
+  return l;
+}
+
+template <typename T>
+T Cholesky<T>::Determinant() const {
+  CheckSolvable();
+  long double l_result = 1.0L;
+  for (std::size_t i = 0; i < GetSize(); i++) {
+    const long double diag = l_.Data()[i * l_.Stride() + i];
+    l_result *= diag * diag;
+  }
+  if (l_result > std::numeric_limits<double>::max())
+    throw std::overflow_error("Value exceeds DBL_MAX");
+  return (T)l_result;
+}
+
+template <typename T>
+T Cholesky<T>::LogDeterminant() const {
+  CheckSolvable();
+  long double l_result = 0.0L;
+  for (std::size_t i = 0; i < GetSize(); i++)
+    l_result += std::log((long double)l_.Data()[i * l_.Stride() + i]);
+  return (T)(2.0L * l_result);
+}
+
+template <typename T>
+void Cholesky<T>::Substitute(T *x, std::size_t ldx, std::size_t cols) const {
+  const std::size_t n = GetSize();
+  detail::ForEachColumnBlock<T>(
+      n, cols, [&](std::size_t first, std::size_t count) {
+        // L * Y = B, then L^T * X = Y with L^T read from the upper triangle.
+        detail::TriangularSolveBlocked(Triangle::kLower, Diagonal::kNonUnit,
+                                       n, count, l_.Data(), l_.Stride(),
+                                       x + first, ldx);
+        detail::TriangularSolveBlocked(Triangle::kUpper, Diagonal::kNonUnit,
+                                       n, count, l_.Data(), l_.Stride(),
+                                       x + first, ldx);
+      });
+}
+
+template <typename T>
+void Cholesky<T>::Solve(S21MatrixView<const T> rhs, S21MatrixView<T> x) const {
+  const std::size_t n = GetSize();
+  detail::CheckSolveOperands(n, rhs, x);
+  CheckSolvable();
+  S21_INSTRUMENT(kSolve, 2 * n * n * rhs.GetCols());
+  x = rhs;
+  Substitute(x.Data(), x.Stride(), x.GetCols());
+}
+
+template <typename T>
+S21Matrix<T> Cholesky<T>::Solve(S21MatrixView<const T> rhs) const {
+  S21_INSTRUMENT(kSolve, 2 * GetSize() * GetSize() * rhs.GetCols());
+  S21Matrix<T> x(GetSize(), rhs.GetCols(), l_.GetResource());
+  Solve(rhs, x);
+  return x;
+}
+
+template <typename T>
+void Cholesky<T>::Solve(const S21Vector<T> &rhs, S21Vector<T> &x) const {
+  if (&rhs == &x) throw std::runtime_error("Solve cannot write over its input");
+  Solve(S21MatrixView<const T>(rhs.Data(), rhs.GetSize(), 1, 1),
+        S21MatrixView<T>(x.Data(), x.GetSize(), 1, 1));
+}
+
+template <typename T>
+S21Vector<T> Cholesky<T>::Solve(const S21Vector<T> &rhs) const {
+  S21_INSTRUMENT(kSolve, 2 * GetSize() * GetSize());
+  S21Vector<T> x(GetSize(), l_.GetResource());
+  Solve(rhs, x);
+  return x;
+}
+
+template <typename T>
+S21Matrix<T> Cholesky<T>::Inverse() const {
+  CheckSolvable();
+  const std::size_t n = GetSize();
+  S21Matrix<T> x(n, n, l_.GetResource());
+  for (std::size_t i = 0; i < n; i++) x(i, i) = T(1);
+  Substitute(x.Data(), x.Stride(), n);
+  return x;
+}
+
+// LDLT
+
+template <typename T>
+LDLT<T>::LDLT(const S21Matrix<T> &matrix)
+    : LDLT(S21Matrix<T>(matrix, matrix.GetResource())) {}
+
+template <typename T>
+LDLT<T>::LDLT(S21Matrix<T> &&matrix) : ld_(std::move(matrix)) {
+  if (ld_.GetRows() != ld_.GetCols())
+    throw std::runtime_error("Matrix must be square to be factorized");
+  const std::size_t n = ld_.GetRows();
+  permutation_.resize(n);
+  std::iota(permutation_.begin(), permutation_.end(), std::size_t{0});
+  block_.assign(n, 0);
+  subdiagonal_.assign(n, T(0));
+  Factorize();
+}
+
+template <typename T>
+template <typename E>
+LDLT<T>::LDLT(const MatrixExpression<E> &expr) : LDLT(S21Matrix<T>(expr)) {}
+
+template <typename T>
+std::size_t LDLT<T>::GetSize() const {
+  return ld_.GetRows();
+}
+
+template <typename T>
+bool LDLT<T>::IsSingular() const {
+  return singular_;
+}
+
+template <typename T>
+const std::vector<std::size_t> &LDLT<T>::GetPermutation() const {
+  return permutation_;
+}
+
+template <typename T>
+T &LDLT<T>::Lower(std::size_t i, std::size_t j) {
+  return i >= j ? ld_.Data()[i * ld_.Stride() + j]
+                : ld_.Data()[j * ld_.Stride() + i];
+}
+
+// Bunch-Kaufman: a 1 x 1 pivot is kept while the diagonal is large enough
+// against its column, otherwise row `imax` of the largest element decides
+// between swapping it in as a 1 x 1 pivot and pairing it with k.
+template <typename T>
+std::size_t LDLT<T>::ChoosePivot(std::size_t k, std::size_t &step) {
+  const T alpha = (T(1) + std::sqrt(T(17))) / T(8);
+  const std::size_t n = GetSize();
+  step = 1;
+  const T absakk = std::abs(Lower(k, k));
+  std::size_t imax = k;
+  T colmax = T(0);
+  for (std::size_t i = k + 1; i < n; i++) {
+    if (std::abs(Lower(i, k)) > colmax) {
+      colmax = std::abs(Lower(i, k));
+      imax = i;
+    }
+  }
+  if (std::max(absakk, colmax) < EPSILON) {
+    singular_ = true;
+    for (std::size_t i = k + 1; i < n; i++) Lower(i, k) = T(0);
+    return k;
+  }
+  if (absakk >= alpha * colmax) return k;
+
+  T rowmax = T(0);
+  for (std::size_t j = k; j < n; j++)
+    if (j != imax) rowmax = std::max(rowmax, std::abs(Lower(imax, j)));
+  if (absakk >= alpha * colmax * (colmax / rowmax)) return k;
+  if (std::abs(Lower(imax, imax)) >= alpha * rowmax) return imax;
+  step = 2;
+  return imax;
+}
+
+// Swaps rows and columns p < q of the symmetric matrix, including the
+// columns of L that are already computed, through its lower triangle.
+template <typename T>
+void LDLT<T>::Interchange(std::size_t p, std::size_t q) {
+  const std::size_t n = GetSize();
+  const std::size_t ld = ld_.Stride();
+  T *a = ld_.Data();
+  std::swap_ranges(a + p * ld, a + p * ld + p, a + q * ld);
+  std::swap(a[p * ld + p], a[q * ld + q]);
+  for (std::size_t j = p + 1; j < q; j++)
+    std::swap(a[j * ld + p], a[q * ld + j]);
+  for (std::size_t i = q + 1; i < n; i++)
+    std::swap(a[i * ld + p], a[i * ld + q]);
+  std::swap(permutation_[p], permutation_[q]);
+}
+
+template <typename T>
+void LDLT<T>::UpdateOne(std::size_t k, std::vector<T> &w) {
+  const std::size_t n = GetSize();
+  const std::size_t ld = ld_.Stride();
+  T *a = ld_.Data();
+  const T d = a[k * ld + k];
+  // w is column k below the pivot, gathered so that rows read it
+  // contiguously: A(i, j) -= w_i * w_j / d for k < j <= i.
+  const std::size_t r = n - k - 1;
+  for (std::size_t i = 0; i < r; i++) w[i] = a[(k + 1 + i) * ld + k];
+  detail::SymmetricParallelFor(
+      k + 1, n, r * r / 2, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+          const T l = w[i - k - 1] / d;
+          simd::Axpy(a + i * ld + k + 1, -l, w.data(), i - k);
+          a[i * ld + k] = l;
+        }
+      });
+}
+
+template <typename T>
+void LDLT<T>::UpdateTwo(std::size_t k, std::vector<T> &w) {
+  const std::size_t n = GetSize();
+  const std::size_t ld = ld_.Stride();
+  T *a = ld_.Data();
+  // D^-1 in the scaled form of LAPACK's sytf2, which avoids overflow.
+  const T d21 = a[(k + 1) * ld + k];
+  const T d11 = a[(k + 1) * ld + k + 1] / d21;
+  const T d22 = a[k * ld + k] / d21;
+  const T t = T(1) / (d11 * d22 - T(1));
+  const T scale = t / d21;
+  const std::size_t r = n - k - 2;
+  T *w1 = w.data(), *w2 = w.data() + r;
+  for (std::size_t i = 0; i < r; i++) {
+    w1[i] = a[(k + 2 + i) * ld + k];
+    w2[i] = a[(k + 2 + i) * ld + k + 1];
+  }
+  detail::SymmetricParallelFor(
+      k + 2, n, r * r, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+          const std::size_t c = i - k - 2;
+          const T l1 = scale * (d11 * w1[c] - w2[c]);
+          const T l2 = scale * (d22 * w2[c] - w1[c]);
+          simd::Axpy(a + i * ld + k + 2, -l1, w1, c + 1);
+          simd::Axpy(a + i * ld + k + 2, -l2, w2, c + 1);
+          a[i * ld + k] = l1;
+          a[i * ld + k + 1] = l2;
+        }
+      });
+  // L(k + 1, k) is zero; D(k + 1, k) is kept aside.
+  subdiagonal_[k] = d21;
+  a[(k + 1) * ld + k] = T(0);
+}
+
+template <typename T>
+void LDLT<T>::Factorize() {
+  const std::size_t n = GetSize();
+  std::vector<T> w(2 * n);
+  for (std::size_t k = 0; k < n;) {
+    std::size_t step;
+    const std::size_t pivot = ChoosePivot(k, step);
+    const std::size_t kk = k + step - 1;
+    if (pivot != kk) Interchange(kk, pivot);
+    block_[k] = static_cast<unsigned char>(step);
+    if (step == 1) {
+      if (ld_.Data()[k * ld_.Stride() + k] != T(0)) UpdateOne(k, w);
+    } else {
+      UpdateTwo(k, w);
+    }
+    k += step;
+  }
+  detail::MirrorLower(n, ld_.Data(), ld_.Stride());
+}
+
+template <typename T>
+S21Matrix<T> LDLT<T>::GetL() const {
+  const std::size_t n = GetSize();
+  S21Matrix<T> l(n, n, ld_.GetResource());
+  for (std::size_t i = 0; i < n; i++) {
+    std::copy_n(ld_.Data() + i * ld_.Stride(), i, l.Data() + i * l.Stride());
+    l(i, i) = T(1);
+  }
+  return l;
+}
+
+template <typename T>
+S21Matrix<T> LDLT<T>::GetD() const {
+  const std::size_t n = GetSize();
+  S21Matrix<T> d(n, n, ld_.GetResource());
+  for (std::size_t k = 0; k < n; k++) {
+    d(k, k) = ld_.Data()[k * ld_.Stride() + k];
+    if (block_[k] == 2) d(k + 1, k) = d(k, k + 1) = subdiagonal_[k];
+  }
+  return d;
+}
+
+template <typename T>
+T LDLT<T>::Determinant() const {
+  if (singular_) return T(0);
+  long double l_result = 1.0L;
+  const T *a = ld_.Data();
+  const std::size_t ld = ld_.Stride();
+  for (std::size_t k = 0; k < GetSize(); k += block_[k]) {
+    const long double d11 = a[k * ld + k];
+    if (block_[k] == 1) {
+      l_result *= d11;
+    } else {
+      const long double d22 = a[(k + 1) * ld + k + 1];
+      const long double d21 = subdiagonal_[k];
+      l_result *= d11 * d22 - d21 * d21;
+    }
+  }
+  if (std::abs(l_result) > std::numeric_limits<double>::max())
+    throw std::overflow_error("Value exceeds DBL_MAX");
+  return (T)l_result;
+}
+
+template <typename T>
+T LDLT<T>::LogAbsDeterminant() const {
+  if (singular_) return -std::numeric_limits<T>::infinity();
+  long double l_result = 0.0L;
+  const T *a = ld_.Data();
+  const std::size_t ld = ld_.Stride();
+  for (std::size_t k = 0; k < GetSize(); k += block_[k]) {
+    const long double d11 = a[k * ld + k];
+    if (block_[k] == 1) {
+      l_result += std::log(std::abs(d11));
+    } else {
+      const long double d22 = a[(k + 1) * ld + k + 1];
+      const long double d21 = subdiagonal_[k];
+      l_result += std::log(std::abs(d11 * d22 - d21 * d21));
+    }
+  }
+  return (T)l_result;
+}
+
+template <typename T>
+int LDLT<T>::DeterminantSign() const {
+  if (singular_) return 0;
+  int sign = 1;
+  const T *a = ld_.Data();
+  const std::size_t ld = ld_.Stride();
+  for (std::size_t k = 0; k < GetSize(); k += block_[k]) {
+    // A block of order two has one positive and one negative eigenvalue.
+    if (block_[k] == 2 || a[k * ld + k] < T(0)) sign = -sign;
+  }
+  return sign;
+}
+
+template <typename T>
+void LDLT<T>::CheckSolvable() const {
+  if (singular_) throw std::runtime_error("Matrix is not invertible");
+}
+
+template <typename T>
+void LDLT<T>::Substitute(T *x, std::size_t ldx, std::size_t cols) const {
+  const std::size_t n = GetSize();
+  const T *a = ld_.Data();
+  const std::size_t ld = ld_.Stride();
+  detail::ForEachColumnBlock<T>(
+      n, cols, [&](std::size_t first, std::size_t count) {
+        T *b = x + first;
+        detail::TriangularSolveBlocked(Triangle::kLower, Diagonal::kUnit, n,
+                                       count, a, ld, b, ldx);
+        for (std::size_t k = 0; k < n; k += block_[k]) {
+          T *row = b + k * ldx;
+          if (block_[k] == 1) {
+            simd::Scale(row, T(1) / a[k * ld + k], count);
+            continue;
+          }
+          // The inverse of a 2 x 2 block, scaled as in UpdateTwo().
+          T *next = row + ldx;
+          const T d21 = subdiagonal_[k];
+          const T d11 = a[(k + 1) * ld + k + 1] / d21;
+          const T d22 = a[k * ld + k] / d21;
+          const T scale = T(1) / (d11 * d22 - T(1)) / d21;
+          for (std::size_t c = 0; c < count; c++) {
+            const T y1 = row[c], y2 = next[c];
+            row[c] = scale * (d11 * y1 - y2);
+            next[c] = scale * (d22 * y2 - y1);
+          }
+        }
+        detail::TriangularSolveBlocked(Triangle::kUpper, Diagonal::kUnit, n,
+                                       count, a, ld, b, ldx);
+      });
+}
+
+template <typename T>
+void LDLT<T>::Solve(S21MatrixView<const T> rhs, S21MatrixView<T> x) const {
+  const std::size_t n = GetSize();
+  const std::size_t m = rhs.GetCols();
+  detail::CheckSolveOperands(n, rhs, x);
+  CheckSolvable();
+  S21_INSTRUMENT(kSolve, 2 * n * n * m);
+
+  // X = P^T * (L D L^T)^-1 * P * B, permuted through a scratch copy.
+  S21Matrix<T> work(n, m, ScratchResource());
+  for (std::size_t i = 0; i < n; i++)
+    std::copy_n(rhs.Data() + permutation_[i] * rhs.Stride(), m,
+                work.Data() + i * work.Stride());
+  Substitute(work.Data(), work.Stride(), m);
+  for (std::size_t i = 0; i < n; i++)
+    std::copy_n(work.Data() + i * work.Stride(), m,
+                x.Data() + permutation_[i] * x.Stride());
+}
+
+template <typename T>
+S21Matrix<T> LDLT<T>::Solve(S21MatrixView<const T> rhs) const {
+  S21_INSTRUMENT(kSolve, 2 * GetSize() * GetSize() * rhs.GetCols());
+  S21Matrix<T> x(GetSize(), rhs.GetCols(), ld_.GetResource());
+  Solve(rhs, x);
+  return x;
+}
+
+template <typename T>
+void LDLT<T>::Solve(const S21Vector<T> &rhs, S21Vector<T> &x) const {
+  if (&rhs == &x) throw std::runtime_error("Solve cannot write over its input");
+  Solve(S21MatrixView<const T>(rhs.Data(), rhs.GetSize(), 1, 1),
+        S21MatrixView<T>(x.Data(), x.GetSize(), 1, 1));
+}
+
+template <typename T>
+S21Vector<T> LDLT<T>::Solve(const S21Vector<T> &rhs) const {
+  S21_INSTRUMENT(kSolve, 2 * GetSize() * GetSize());
+  S21Vector<T> x(GetSize(), ld_.GetResource());
+  Solve(rhs, x);
+  return x;
+}
+
+template <typename T>
+S21Matrix<T> LDLT<T>::Inverse() const {
+  CheckSolvable();
+  const std::size_t n = GetSize();
+  S21Matrix<T> identity(n, n, ScratchResource());
+  for (std::size_t i = 0; i < n; i++) identity(i, i) = T(1);
+  S21Matrix<T> x(n, n, ld_.GetResource());
+  Solve(identity, x);
+  return x;
+}
+
+}  // namespace S21
+
+#endif  // S21_SYMMETRIC_HPP_
@@ -0,0 +1,262 @@
+#ifndef S21_THREAD_POOL_HPP_
+#define S21_THREAD_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace S21 {
+
+/// @brief Persistent work-stealing thread pool shared by all matrix kernels.
+/// @note Every worker owns a task deque: it pops from the front of its own
+/// deque and, when that is empty, steals from the back of the others. The
+/// thread that submits a parallel loop helps execute tasks until the loop is
+/// finished, so a pool of N threads runs N - 1 workers plus the caller.
+/// @note The library-wide instance is sized from the `S21_NUM_THREADS`
+/// environment variable when it is set, and from
+/// std::thread::hardware_concurrency() otherwise.
+class ThreadPool {
+ public:
+  /// @brief Creates a pool that runs loops on `threads` threads in total.
+  /// @param threads Number of threads including the caller; 0 means one.
+  explicit ThreadPool(std::size_t threads);
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// @brief Stops and joins all workers.
+  ~ThreadPool();
+
+  /// @brief Gets the pool used internally by S21Matrix operations.
+  static ThreadPool &Instance();
+
+  /// @brief Gets the number of threads a parallel loop may use.
+  /// @return Worker count plus the calling thread.
+  std::size_t GetThreadCount() const;
+
+  /// @brief Restarts the pool with a different number of threads.
+  /// @note Must not be called while a parallel loop is running on this pool.
+  /// @param threads Number of threads including the caller; 0 means one.
+  void SetThreadCount(std::size_t threads);
+
+  /// @brief Runs `body(index)` for every index in [0, count).
+  /// @note Runs inline when the pool has a single thread, when called from
+  /// one of the pool's own workers or while a ScopedSerial guard is active
+  /// on the calling thread. The first exception thrown by `body` is
+  /// rethrown to the caller after all indices have finished.
+  template <typename Body>
+  void ParallelFor(std::size_t count, Body &&body);
+
+  /// @brief Checks whether parallel loops issued from this thread would run
+  /// inline.
+  static bool IsSerialContext();
+
+  /// @brief Disables parallel execution on the current thread for its
+  /// lifetime.
+  /// @note Intended for callers that already run inside their own thread
+  /// pool and do not want the library to oversubscribe the machine.
+  class ScopedSerial {
+   public:
+    ScopedSerial() : previous_(SerialFlag()) { SerialFlag() = true; }
+    ~ScopedSerial() { SerialFlag() = previous_; }
+    ScopedSerial(const ScopedSerial &) = delete;
+    ScopedSerial &operator=(const ScopedSerial &) = delete;
+
+   private:
+    bool previous_;
+  };
+
+ private:
+  using Task = std::function<void()>;
+
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  static bool &SerialFlag();
+  static std::size_t DefaultThreadCount();
+
+  void Start(std::size_t threads);
+  void Stop();
+  void Push(std::size_t queue, Task task);
+  bool TryRun(std::size_t home);
+  void WorkerLoop(std::size_t index);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> pending_{0};
+  std::atomic<std::size_t> next_queue_{0};
+  bool stop_ = false;
+};
+
+namespace detail {
+
+/// @brief Parses a thread count such as the value of `S21_NUM_THREADS`.
+/// @return The parsed positive count, or 0 when the text is not one.
+inline std::size_t ParseThreadCount(const char *text) {
+  if (text == nullptr || *text == '\0') return 0;
+  char *end = nullptr;
+  long long value = std::strtoll(text, &end, 10);
+  if (*end != '\0' || value <= 0) return 0;
+  return static_cast<std::size_t>(value);
+}
+
+}  // namespace detail
+
+inline ThreadPool::ThreadPool(std::size_t threads) { Start(threads); }
+
+inline ThreadPool::~ThreadPool() { Stop(); }
+
+inline ThreadPool &ThreadPool::Instance() {
+  static ThreadPool pool(DefaultThreadCount());
+  return pool;
+}
+
+inline std::size_t ThreadPool::GetThreadCount() const {
+  return workers_.size() + 1;
+}
+
+inline void ThreadPool::SetThreadCount(std::size_t threads) {
+  Stop();
+  Start(threads);
+}
+
+inline bool ThreadPool::IsSerialContext() { return SerialFlag(); }
+
+inline bool &ThreadPool::SerialFlag() {
+  thread_local bool serial = false;
+  return serial;
+}
+
+inline std::size_t ThreadPool::DefaultThreadCount() {
+  std::size_t threads =
+      detail::ParseThreadCount(std::getenv("S21_NUM_THREADS"));
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  return threads;
+}
+
+inline void ThreadPool::Start(std::size_t threads) {
+  std::size_t workers = threads > 1 ? threads - 1 : 0;
+  stop_ = false;
+  queues_.clear();
+  for (std::size_t i = 0; i < workers; i++)
+    queues_.push_back(std::make_unique<WorkQueue>());
+  for (std::size_t i = 0; i < workers; i++)
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+inline void ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) worker.join();
+  workers_.clear();
+}
+
+inline void ThreadPool::Push(std::size_t queue, Task task) {
+  {
+    std::lock_guard<std::mutex> lock(queues_[queue]->mutex);
+    queues_[queue]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    pending_.fetch_add(1, std::memory_order_relaxed);
+  }
+  wake_.notify_one();
+}
+
+inline bool ThreadPool::TryRun(std::size_t home) {
+  Task task;
+  const std::size_t count = queues_.size();
+  for (std::size_t offset = 0; offset < count && !task; offset++) {
+    WorkQueue &queue = *queues_[(home + offset) % count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) continue;
+    if (offset == 0) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    } else {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+  }
+  if (!task) return false;
+  pending_.fetch_sub(1, std::memory_order_relaxed);
+  task();
+  return true;
+}
+
+inline void ThreadPool::WorkerLoop(std::size_t index) {
+  SerialFlag() = true;  // Nested loops issued by tasks run inline
+  for (;;) {
+    if (TryRun(index)) continue;
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this] {
+      return stop_ || pending_.load(std::memory_order_relaxed) > 0;
+    });
+    if (stop_) return;
+  }
+}
+
+template <typename Body>
+void ThreadPool::ParallelFor(std::size_t count, Body &&body) {
+  if (count == 0) return;
+  if (count == 1 || workers_.empty() || IsSerialContext()) {
+    for (std::size_t i = 0; i < count; i++) body(i);
+    return;
+  }
+
+  struct Loop {
+    std::atomic<std::size_t> remaining;
+    std::mutex mutex;  // Guards error and the wake-up of the caller
+    std::condition_variable done;
+    std::exception_ptr error;
+  };
+  auto loop = std::make_shared<Loop>();
+  loop->remaining.store(count, std::memory_order_relaxed);
+
+  const std::size_t first = next_queue_.fetch_add(1, std::memory_order_relaxed);
+  for (std::size_t i = 0; i < count; i++) {
+    Push((first + i) % queues_.size(), [loop, &body, i] {
+      try {
+        body(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        if (!loop->error) loop->error = std::current_exception();
+      }
+      if (loop->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        loop->done.notify_one();
+      }
+    });
+  }
+
+  // Help while tasks are queued. Once the queues are empty every task of
+  // this loop has been taken, so sleep until the last one finishes.
+  while (loop->remaining.load(std::memory_order_acquire) != 0) {
+    if (TryRun(first)) continue;
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->done.wait(lock, [&loop] {
+      return loop->remaining.load(std::memory_order_acquire) == 0;
+    });
+  }
+  if (loop->error) std::rethrow_exception(loop->error);
+}
+
+}  // namespace S21
+
+#endif  // S21_THREAD_POOL_HPP_
@@ -0,0 +1,126 @@
+#ifndef S21_TRANSPOSE_HPP_
+#define S21_TRANSPOSE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "s21_thread_pool.hpp"
+
+/// @file
+/// @brief Out-of-place and in-place row-major transposition used by
+/// S21Matrix::Transpose() and S21Matrix::TransposeInPlace().
+/// @note The copy is cache-oblivious: the larger dimension is halved until
+/// a tile fits in L1, so source rows and destination rows are both touched
+/// in cache-sized pieces whatever the cache hierarchy looks like.
+
+#ifndef S21_TRANSPOSE_TILE
+#define S21_TRANSPOSE_TILE 32  // Side of the tiles copied with plain loops
+#endif
+
+#ifndef S21_TRANSPOSE_PARALLEL
+#define S21_TRANSPOSE_PARALLEL 1048576  // Elements below which it is serial
+#endif
+
+namespace S21 {
+namespace detail {
+
+/// @brief Writes the transpose of a rows x cols block of `src` to `dst`.
+/// @param lds Distance in elements between rows of `src`.
+/// @param ldd Distance in elements between rows of `dst`, which has cols
+/// rows and rows columns.
+template <typename T>
+void TransposeBlock(std::size_t rows, std::size_t cols, const T *src,
+                    std::size_t lds, T *dst, std::size_t ldd) {
+  constexpr std::size_t kTile = S21_TRANSPOSE_TILE;
+  if (rows <= kTile && cols <= kTile) {
+    for (std::size_t i = 0; i < rows; i++)
+      for (std::size_t j = 0; j < cols; j++)
+        dst[j * ldd + i] = src[i * lds + j];
+  } else if (rows >= cols) {
+    const std::size_t half = rows / 2;
+    TransposeBlock(half, cols, src, lds, dst, ldd);
+    TransposeBlock(rows - half, cols, src + half * lds, lds, dst + half, ldd);
+  } else {
+    const std::size_t half = cols / 2;
+    TransposeBlock(rows, half, src, lds, dst, ldd);
+    TransposeBlock(rows, cols - half, src + half, lds, dst + half * ldd, ldd);
+  }
+}
+
+/// @brief Transposes a rows x cols matrix into a separate buffer.
+/// @note Large matrices are split into bands of source rows, one task per
+/// band on ThreadPool::Instance(); bands write disjoint destination columns.
+template <typename T>
+void TransposeCopy(std::size_t rows, std::size_t cols, const T *src,
+                   std::size_t lds, T *dst, std::size_t ldd) {
+  constexpr std::size_t kTile = S21_TRANSPOSE_TILE;
+  ThreadPool &pool = ThreadPool::Instance();
+  if (rows * cols < S21_TRANSPOSE_PARALLEL || pool.GetThreadCount() == 1 ||
+      ThreadPool::IsSerialContext()) {
+    TransposeBlock(rows, cols, src, lds, dst, ldd);
+    return;
+  }
+  const std::size_t tiles = (rows + kTile - 1) / kTile;
+  const std::size_t bands = std::min(tiles, 4 * pool.GetThreadCount());
+  const std::size_t band = (tiles + bands - 1) / bands * kTile;
+  pool.ParallelFor((rows + band - 1) / band, [&](std::size_t index) {
+    const std::size_t first = index * band;
+    TransposeBlock(std::min(band, rows - first), cols, src + first * lds, lds,
+                   dst + first, ldd);
+  });
+}
+
+/// @brief Transposes an n x n matrix in place.
+/// @note Walks the upper triangle tile by tile, swapping every element with
+/// its mirror, so both tiles of a pair stay in cache. Tile rows run in
+/// parallel for large matrices: each one owns the pairs it swaps.
+template <typename T>
+void TransposeSquareInPlace(std::size_t n, T *data, std::size_t stride) {
+  constexpr std::size_t kTile = S21_TRANSPOSE_TILE;
+  auto tile_row = [&](std::size_t index) {
+    const std::size_t i0 = index * kTile;
+    const std::size_t i1 = std::min(n, i0 + kTile);
+    for (std::size_t j0 = i0; j0 < n; j0 += kTile) {
+      const std::size_t j1 = std::min(n, j0 + kTile);
+      for (std::size_t i = i0; i < i1; i++)
+        for (std::size_t j = std::max(j0, i + 1); j < j1; j++)
+          std::swap(data[i * stride + j], data[j * stride + i]);
+    }
+  };
+  const std::size_t tiles = (n + kTile - 1) / kTile;
+  if (n * n < S21_TRANSPOSE_PARALLEL) {
+    for (std::size_t index = 0; index < tiles; index++) tile_row(index);
+  } else {
+    ThreadPool::Instance().ParallelFor(tiles, tile_row);
+  }
+}
+
+/// @brief Transposes a contiguous rows x cols matrix in place, leaving a
+/// contiguous cols x rows matrix in the same buffer.
+/// @note Follows the permutation cycles of k -> k * rows mod (size - 1),
+/// marking visited positions in a bit set of rows * cols bits.
+template <typename T>
+void TransposeCyclesInPlace(std::size_t rows, std::size_t cols, T *data) {
+  const std::size_t size = rows * cols;
+  if (size < 3) return;
+  const std::size_t last = size - 1;
+  std::vector<bool> visited(size);
+  for (std::size_t start = 1; start < last; start++) {
+    if (visited[start]) continue;
+    T carried = data[start];
+    std::size_t position = start;
+    do {
+      // Element (i, j) at i * cols + j belongs at j * rows + i
+      position = position * rows % last;
+      std::swap(carried, data[position]);
+      visited[position] = true;
+    } while (position != start);
+  }
+}
+
+}  // namespace detail
+}  // namespace S21
+
+#endif  // S21_TRANSPOSE_HPP_
@@ -0,0 +1,148 @@
+#ifndef S21_TRIANGULAR_HPP_
+#define S21_TRIANGULAR_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include "s21_matrix_oop.hpp"
+
+#ifndef S21_TRSM_BLOCK
+#define S21_TRSM_BLOCK 64  // Order of the diagonal blocks solved directly
+#endif
+
+#ifndef S21_TRSM_PARALLEL
+#define S21_TRSM_PARALLEL 2097152  // n * n * rhs below which it is serial
+#endif
+
+/// @file
+/// @brief Forward and back substitution with many right-hand sides.
+/// @note TriangularSolve() overwrites B with the solution X of A * X = B
+/// for a triangular A. The diagonal is walked in blocks of S21_TRSM_BLOCK
+/// rows: each diagonal block is solved by substitution, row by row with the
+/// SIMD kernels, and the rest of B is updated with one GEMM, which carries
+/// most of the work. Right-hand sides are independent, so large solves give
+/// each thread of ThreadPool::Instance() its own block of columns.
+/// @note A single contiguous right-hand side is solved with one SIMD dot
+/// product per row instead, reading A once.
+
+namespace S21 {
+
+/// @brief Which triangle of a matrix holds the system.
+enum class Triangle { kLower, kUpper };
+
+/// @brief Whether the diagonal is read or taken as all ones, as for the L
+/// factor of LU.
+enum class Diagonal { kNonUnit, kUnit };
+
+namespace detail {
+
+/// @brief Solves A * X = B for an n x n triangular A and n x m B, in place,
+/// by blocked substitution.
+template <typename T>
+void TriangularSolveBlocked(Triangle uplo, Diagonal diag, std::size_t n,
+                            std::size_t m, const T *a, std::size_t lda, T *b,
+                            std::size_t ldb) {
+  const bool unit = diag == Diagonal::kUnit;
+  if (m == 1 && ldb == 1) {
+    // One contiguous vector: x_i = (b_i - A[i, solved] . x[solved]) / a_ii.
+    for (std::size_t step = 0; step < n; step++) {
+      const std::size_t i = uplo == Triangle::kLower ? step : n - 1 - step;
+      const std::size_t first = uplo == Triangle::kLower ? 0 : i + 1;
+      b[i] -= simd::Dot(a + i * lda + first, b + first, step);
+      if (!unit) b[i] /= a[i * lda + i];
+    }
+    return;
+  }
+
+  constexpr std::size_t kBlock = S21_TRSM_BLOCK;
+  for (std::size_t done = 0; done < n; done += kBlock) {
+    const std::size_t kb = std::min(kBlock, n - done);
+    // Lower systems are solved from the top, upper ones from the bottom.
+    const std::size_t k0 = uplo == Triangle::kLower ? done : n - done - kb;
+    const std::size_t k1 = k0 + kb;
+    for (std::size_t step = 0; step < kb; step++) {
+      const std::size_t i =
+          uplo == Triangle::kLower ? k0 + step : k1 - 1 - step;
+      T *row = b + i * ldb;
+      const std::size_t p0 = uplo == Triangle::kLower ? k0 : i + 1;
+      const std::size_t p1 = uplo == Triangle::kLower ? i : k1;
+      for (std::size_t p = p0; p < p1; p++)
+        simd::Axpy(row, -a[i * lda + p], b + p * ldb, m);
+      if (!unit) simd::Scale(row, T(1) / a[i * lda + i], m);
+    }
+    // Take the solved rows out of the rows that are still to be solved.
+    if (uplo == Triangle::kLower && k1 < n)
+      Gemm(n - k1, m, kb, T(-1), a + k1 * lda + k0, lda, b + k0 * ldb, ldb,
+           T(1), b + k1 * ldb, ldb);
+    else if (uplo == Triangle::kUpper && k0 > 0)
+      Gemm(k0, m, kb, T(-1), a + k0, lda, b + k0 * ldb, ldb, T(1), b, ldb);
+  }
+}
+
+/// @brief Runs `body(first, count)` on blocks of the m right-hand sides of
+/// an order n solve, in parallel once it has S21_TRSM_PARALLEL work.
+/// @note Blocks are whole cache lines wide so that threads do not share
+/// lines of B. Small ones run serially and leave the threads to the GEMM.
+template <typename T, typename Body>
+void ForEachColumnBlock(std::size_t n, std::size_t m, Body &&body) {
+  ThreadPool &pool = ThreadPool::Instance();
+  const std::size_t threads = pool.GetThreadCount();
+  constexpr std::size_t kLine = S21Matrix<T>::kAlignment / sizeof(T);
+  if (n * n * m < S21_TRSM_PARALLEL || threads == 1 || m < 2 * kLine ||
+      ThreadPool::IsSerialContext())
+    return body(std::size_t(0), m);
+  std::size_t block = (m + threads - 1) / threads;
+  block = (block + kLine - 1) / kLine * kLine;
+  pool.ParallelFor((m + block - 1) / block, [&](std::size_t index) {
+    const std::size_t first = index * block;
+    body(first, std::min(block, m - first));
+  });
+}
+
+}  // namespace detail
+
+/// @brief Solves A * X = B for a triangular A, overwriting B with X.
+/// @note Only the triangle `uplo` of A is read, and its diagonal only when
+/// `diag` is Diagonal::kNonUnit. Either operand may be a block of a larger
+/// matrix.
+/// @param a The square triangular matrix.
+/// @param b The right-hand sides, one per column, with as many rows as A.
+/// @throw std::runtime_error if the shapes do not match, a diagonal element
+/// that is read has magnitude below EPSILON, or A shares memory with B.
+template <typename T>
+void TriangularSolve(Triangle uplo, Diagonal diag,
+                     typename detail::Identity<S21MatrixView<const T>>::type a,
+                     S21MatrixView<T> b) {
+  const std::size_t n = a.GetRows();
+  if (a.GetCols() != n || b.GetRows() != n)
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for solving the system");
+  if (detail::Overlap<T>(a, b))
+    throw std::runtime_error("TriangularSolve cannot write over its input");
+  if (diag == Diagonal::kNonUnit) {
+    for (std::size_t i = 0; i < n; i++)
+      if (std::abs(a.Coeff(i, i)) < EPSILON)
+        throw std::runtime_error("Matrix is not invertible");
+  }
+  S21_INSTRUMENT(kTriangularSolve, n * n * b.GetCols());
+  detail::ForEachColumnBlock<T>(
+      n, b.GetCols(), [&](std::size_t first, std::size_t count) {
+        detail::TriangularSolveBlocked(uplo, diag, n, count, a.Data(),
+                                       a.Stride(), b.Data() + first,
+                                       b.Stride());
+      });
+}
+
+/// @brief Solves A * X = B for a triangular A, overwriting B with X.
+/// @throw std::runtime_error as the overload on views.
+template <typename T>
+void TriangularSolve(Triangle uplo, Diagonal diag, const S21Matrix<T> &a,
+                     S21Matrix<T> &b) {
+  TriangularSolve<T>(uplo, diag, a, S21MatrixView<T>(b));
+}
+
+}  // namespace S21
+
+#endif  // S21_TRIANGULAR_HPP_
@@ -0,0 +1,233 @@
+#ifndef S21_VECTOR_HPP_
+#define S21_VECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_simd.hpp"
+#include "s21_thread_pool.hpp"
+
+#ifndef S21_GEMV_PARALLEL
+#define S21_GEMV_PARALLEL 262144  // rows * cols below which GEMV is serial
+#endif
+
+/// @file
+/// @brief Dense vectors and matrix-vector products.
+/// @note Gemv() and GemvT() write into a vector owned by the caller, so an
+/// iterative method can run its products without allocating. Both stream
+/// the matrix once in storage order through the SIMD dot and axpy kernels
+/// of s21_simd.hpp, and split large matrices across ThreadPool::Instance().
+
+namespace S21 {
+
+/// @brief A dense vector with the storage of a one-row S21Matrix.
+/// @note The buffer is aligned to S21Matrix<T>::kAlignment bytes and comes
+/// from the memory resource given at construction.
+/// @tparam T The type of the elements.
+template <typename T = double>
+class S21Vector {
+  static_assert(std::is_arithmetic_v<T>, "T must be an arithmetic type");
+
+ public:
+  using value_type = T;
+
+  /// @brief Creates a zero vector of `size` elements.
+  /// @param resource Memory resource the buffer is allocated from.
+  explicit S21Vector(std::size_t size = 0,
+                     std::pmr::memory_resource *resource =
+                         std::pmr::get_default_resource())
+      : storage_(1, size, resource) {}
+
+  /// @brief Creates a vector holding `values`.
+  S21Vector(std::initializer_list<T> values,
+            std::pmr::memory_resource *resource =
+                std::pmr::get_default_resource())
+      : storage_(1, values.size(), resource) {
+    std::copy(values.begin(), values.end(), Data());
+  }
+
+  /// @brief Converts a vector of another element type, e.g. float to
+  /// double, element by element with static_cast.
+  template <typename U, typename = std::enable_if_t<!std::is_same_v<U, T>>>
+  explicit S21Vector(const S21Vector<U> &other,
+                     std::pmr::memory_resource *resource =
+                         std::pmr::get_default_resource())
+      : storage_(1, other.GetSize(), resource) {
+    std::transform(other.Data(), other.Data() + other.GetSize(), Data(),
+                   [](U value) { return static_cast<T>(value); });
+  }
+
+  std::size_t GetSize() const { return storage_.GetCols(); }
+  std::pmr::memory_resource *GetResource() const {
+    return storage_.GetResource();
+  }
+
+  T *Data() { return storage_.Data(); }
+  const T *Data() const { return storage_.Data(); }
+
+  /// @brief Accesses an element without bounds checking.
+  T &operator[](std::size_t index) { return Data()[index]; }
+  const T &operator[](std::size_t index) const { return Data()[index]; }
+
+  /// @brief Accesses an element.
+  /// @throw std::out_of_range if the index is out of range.
+  T &operator()(std::size_t index) { return storage_(0, index); }
+  const T &operator()(std::size_t index) const { return storage_(0, index); }
+
+  /// @brief Checks that both vectors have the same size and elements that
+  /// differ by at most EPSILON.
+  bool EqVector(const S21Vector &other) const {
+    return storage_.EqMatrix(other.storage_);
+  }
+
+  /// @throw std::runtime_error if the sizes differ.
+  void SumVector(const S21Vector &other) { storage_.SumMatrix(other.storage_); }
+
+  /// @throw std::runtime_error if the sizes differ.
+  void SubVector(const S21Vector &other) { storage_.SubMatrix(other.storage_); }
+
+  void MulNumber(T num) { storage_.MulNumber(num); }
+
+  /// @brief Adds `alpha * x` to the vector.
+  /// @throw std::runtime_error if the sizes differ.
+  void Axpy(T alpha, const S21Vector &x) {
+    CheckSameSize(x);
+    simd::Axpy(Data(), alpha, x.Data(), GetSize());
+  }
+
+  /// @brief Computes the dot product with `other`.
+  /// @throw std::runtime_error if the sizes differ.
+  T Dot(const S21Vector &other) const {
+    CheckSameSize(other);
+    return simd::Dot(Data(), other.Data(), GetSize());
+  }
+
+ private:
+  void CheckSameSize(const S21Vector &other) const {
+    if (GetSize() != other.GetSize())
+      throw std::runtime_error("Vector sizes are not equal");
+  }
+
+  S21Matrix<T> storage_;
+};
+
+/// @brief Computes y = alpha * A * x + beta * y.
+/// @note When beta is zero the previous contents of `y` are ignored, even
+/// NaN. Rows are split across ThreadPool::Instance() once A has
+/// S21_GEMV_PARALLEL elements.
+/// @param y The output, with one element per row of A; must not be `x`.
+/// @throw std::runtime_error if the sizes do not match A or `y` is `x`.
+template <typename T>
+void Gemv(T alpha, const S21Matrix<T> &a, const S21Vector<T> &x, T beta,
+          S21Vector<T> &y);
+
+/// @brief Computes y = alpha * A^T * x + beta * y without transposing A.
+/// @note A is read row by row, each row adding a multiple of itself to y,
+/// and columns are split across ThreadPool::Instance() once A has
+/// S21_GEMV_PARALLEL elements.
+/// @param y The output, with one element per column of A; must not be `x`.
+/// @throw std::runtime_error if the sizes do not match A or `y` is `x`.
+template <typename T>
+void GemvT(T alpha, const S21Matrix<T> &a, const S21Vector<T> &x, T beta,
+           S21Vector<T> &y);
+
+/// @brief Multiplies a matrix by a vector into a new vector.
+/// @note Allocates the result; use Gemv() in loops.
+/// @throw std::runtime_error if the vector does not have one element per
+/// column of the matrix.
+template <typename T>
+S21Vector<T> operator*(const S21Matrix<T> &a, const S21Vector<T> &x) {
+  S21_INSTRUMENT(kGemv, 2 * a.GetRows() * a.GetCols());
+  S21Vector<T> y(a.GetRows(), a.GetResource());
+  Gemv(T(1), a, x, T(0), y);
+  return y;
+}
+
+namespace detail {
+
+/// @brief y[i] = alpha * dot(A[i], x) + beta * y[i] for rows [first, last).
+template <typename T>
+void GemvRows(std::size_t first, std::size_t last, std::size_t n, T alpha,
+              const T *a, std::size_t lda, const T *x, T beta, T *y) {
+  for (std::size_t i = first; i < last; i++) {
+    const T dot = alpha * simd::Dot(a + i * lda, x, n);
+    y[i] = beta == T(0) ? dot : dot + beta * y[i];
+  }
+}
+
+/// @brief y[j] = alpha * sum_i A[i][j] x[i] + beta * y[j] for columns
+/// [first, last).
+template <typename T>
+void GemvTCols(std::size_t first, std::size_t last, std::size_t m, T alpha,
+               const T *a, std::size_t lda, const T *x, T beta, T *y) {
+  const std::size_t n = last - first;
+  if (beta == T(0))
+    std::fill_n(y + first, n, T(0));
+  else if (beta != T(1))
+    simd::Scale(y + first, beta, n);
+  for (std::size_t i = 0; i < m; i++) {
+    if (x[i] != T(0))
+      simd::Axpy(y + first, alpha * x[i], a + i * lda + first, n);
+  }
+}
+
+/// @brief Splits [0, count) into blocks for the pool, each a multiple of
+/// `grain` unless it is the last one, and runs `body(first, last)` on each.
+template <typename Body>
+void GemvParallelFor(std::size_t count, std::size_t work, std::size_t grain,
+                     Body &&body) {
+  ThreadPool &pool = ThreadPool::Instance();
+  const std::size_t threads = pool.GetThreadCount();
+  if (work < S21_GEMV_PARALLEL || threads == 1 ||
+      ThreadPool::IsSerialContext())
+    return body(std::size_t(0), count);
+  std::size_t block = (count + threads - 1) / threads;
+  block = (block + grain - 1) / grain * grain;
+  pool.ParallelFor((count + block - 1) / block, [&](std::size_t index) {
+    const std::size_t first = index * block;
+    body(first, std::min(count, first + block));
+  });
+}
+
+}  // namespace detail
+
+template <typename T>
+void Gemv(T alpha, const S21Matrix<T> &a, const S21Vector<T> &x, T beta,
+          S21Vector<T> &y) {
+  if (x.GetSize() != a.GetCols() || y.GetSize() != a.GetRows())
+    throw std::runtime_error("Vector sizes do not match the matrix");
+  if (&x == &y) throw std::runtime_error("Gemv cannot write over its input");
+  S21_INSTRUMENT(kGemv, 2 * a.GetRows() * a.GetCols());
+  const std::size_t m = a.GetRows(), n = a.GetCols();
+  detail::GemvParallelFor(m, m * n, 1, [&](std::size_t first,
+                                           std::size_t last) {
+    detail::GemvRows(first, last, n, alpha, a.Data(), a.Stride(), x.Data(),
+                     beta, y.Data());
+  });
+}
+
+template <typename T>
+void GemvT(T alpha, const S21Matrix<T> &a, const S21Vector<T> &x, T beta,
+           S21Vector<T> &y) {
+  if (x.GetSize() != a.GetRows() || y.GetSize() != a.GetCols())
+    throw std::runtime_error("Vector sizes do not match the matrix");
+  if (&x == &y) throw std::runtime_error("GemvT cannot write over its input");
+  S21_INSTRUMENT(kGemvT, 2 * a.GetRows() * a.GetCols());
+  const std::size_t m = a.GetRows(), n = a.GetCols();
+  // Column blocks of whole cache lines keep threads off each other's lines.
+  constexpr std::size_t kLine = S21Matrix<T>::kAlignment / sizeof(T);
+  detail::GemvParallelFor(n, m * n, kLine, [&](std::size_t first,
+                                               std::size_t last) {
+    detail::GemvTCols(first, last, m, alpha, a.Data(), a.Stride(), x.Data(),
+                      beta, y.Data());
+  });
+}
+
+}  // namespace S21
+
+#endif  // S21_VECTOR_HPP_
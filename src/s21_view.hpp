@@ -0,0 +1,402 @@
+#ifndef S21_VIEW_HPP_
+#define S21_VIEW_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_expression.hpp"
+#include "s21_gemm.hpp"
+#include "s21_instrumentation.hpp"
+#include "s21_simd.hpp"
+
+/// @file
+/// @brief Non-owning views of the elements of a matrix.
+/// @note S21Matrix::Block(), S21Matrix::Strided() and
+/// S21Matrix::GetMinorView() give access to part of a matrix without copying
+/// it. Views are matrix expressions, so they mix with matrices in `+`, `-`
+/// and scalar products, are multiplied by the GEMM kernel in place, and can
+/// be evaluated into an S21Matrix or factorized by LU.
+/// @note A view refers to the buffer of its matrix and is invalidated by
+/// any operation that reallocates it, such as SetRows() or an assignment of
+/// a matrix of another shape. Copying a view copies the reference, while
+/// assigning to a writable view writes the elements it covers.
+
+namespace S21 {
+
+template <typename T>
+class S21Matrix;
+
+template <typename T = double>
+class S21MinorView;
+
+namespace detail {
+
+inline void CheckViewIndex(std::size_t row, std::size_t col, std::size_t rows,
+                           std::size_t cols) {
+  if (row >= rows || col >= cols)
+    throw std::out_of_range("Row or column index out of range");
+}
+
+// Whether `count` indices `step` apart from `first` all lie in [0, size),
+// checked without overflowing.
+inline bool FitsExtent(std::size_t first, std::size_t count, std::size_t step,
+                       std::size_t size) {
+  if (count == 0) return first <= size;
+  if (first >= size) return false;
+  return step == 0 || count - 1 <= (size - 1 - first) / step;
+}
+
+template <typename V, typename E>
+void CheckViewShape(const V &view, const E &expr) {
+  if (view.GetRows() != expr.GetRows() || view.GetCols() != expr.GetCols())
+    throw std::runtime_error("Matrices dimensions are not equal");
+}
+
+}  // namespace detail
+
+/// @brief A rectangular block of a matrix, read and written in place.
+/// @note Rows of the block are contiguous and `Stride()` elements apart, as
+/// in S21Matrix, so blocks are handed to the GEMM and SIMD kernels directly.
+/// @tparam T `U` for a writable block, `const U` for a read-only one.
+template <typename T = double>
+class S21MatrixView : public MatrixExpression<S21MatrixView<T>> {
+ public:
+  using value_type = std::remove_const_t<T>;
+
+  /// @brief Views `rows` x `cols` elements starting at `data`.
+  /// @param stride Distance in elements between the starts of two rows.
+  S21MatrixView(T *data, std::size_t rows, std::size_t cols,
+                std::size_t stride) noexcept
+      : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+
+  /// @brief Views a whole matrix.
+  template <typename M,
+            typename = std::enable_if_t<
+                std::is_same_v<std::remove_const_t<M>, S21Matrix<value_type>> &&
+                (std::is_const_v<T> || !std::is_const_v<M>)>>
+  S21MatrixView(M &matrix) noexcept  // NOLINT(runtime/explicit)
+      : S21MatrixView(matrix.Data(), matrix.GetRows(), matrix.GetCols(),
+                      matrix.Stride()) {}
+
+  /// @brief Makes a read-only view of a writable one.
+  template <typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, T> &&
+                                        !std::is_const_v<U>>>
+  S21MatrixView(const S21MatrixView<U> &view) noexcept  // NOLINT
+      : S21MatrixView(view.Data(), view.GetRows(), view.GetCols(),
+                      view.Stride()) {}
+
+  S21MatrixView(const S21MatrixView &other) = default;
+
+  std::size_t GetRows() const noexcept { return rows_; }
+  std::size_t GetCols() const noexcept { return cols_; }
+  std::size_t Stride() const noexcept { return stride_; }
+  T *Data() const noexcept { return data_; }
+
+  value_type Coeff(std::size_t row, std::size_t col) const {
+    return data_[row * stride_ + col];
+  }
+
+  /// @throw std::out_of_range if the index is outside of the view.
+  T &operator()(std::size_t row, std::size_t col) const {
+    detail::CheckViewIndex(row, col, rows_, cols_);
+    return data_[row * stride_ + col];
+  }
+
+  /// @brief Views a block of this view.
+  /// @throw std::out_of_range if the block does not fit in the view.
+  S21MatrixView Block(std::size_t row, std::size_t col, std::size_t rows,
+                      std::size_t cols) const {
+    if (!detail::FitsExtent(row, rows, 1, rows_) ||
+        !detail::FitsExtent(col, cols, 1, cols_))
+      throw std::out_of_range("Block is out of range");
+    return S21MatrixView(data_ + row * stride_ + col, rows, cols, stride_);
+  }
+
+  /// @brief Views the elements outside of one row and one column.
+  /// @throw std::out_of_range if the index is outside of the view.
+  S21MinorView<value_type> GetMinorView(std::size_t row,
+                                        std::size_t col) const;
+
+  /// @brief Writes the elements of `other` into the viewed ones.
+  /// @throw std::runtime_error if the shapes differ.
+  S21MatrixView &operator=(const S21MatrixView &other) {
+    return *this = static_cast<const MatrixExpression<S21MatrixView> &>(other);
+  }
+
+  /// @brief Writes the value of an expression into the viewed elements.
+  /// @note Element (i, j) is read before it is written, so the expression
+  /// may refer to the same elements, but not to other overlapping ones.
+  /// @throw std::runtime_error if the shapes differ.
+  template <typename E>
+  S21MatrixView &operator=(const MatrixExpression<E> &expr) {
+    static_assert(!std::is_const_v<T>, "The view is read-only");
+    const E &e = expr.Self();
+    detail::CheckViewShape(*this, e);
+    for (std::size_t i = 0; i < rows_; i++) {
+      T *dst = data_ + i * stride_;
+      for (std::size_t j = 0; j < cols_; j++) dst[j] = e.Coeff(i, j);
+    }
+    return *this;
+  }
+
+  /// @throw std::runtime_error if the shapes differ.
+  template <typename E>
+  S21MatrixView &operator+=(const MatrixExpression<E> &expr) {
+    if constexpr (std::is_same_v<E, S21Matrix<value_type>> ||
+                  std::is_same_v<E, S21MatrixView<value_type>> ||
+                  std::is_same_v<E, S21MatrixView<const value_type>>) {
+      static_assert(!std::is_const_v<T>, "The view is read-only");
+      detail::CheckViewShape(*this, expr.Self());
+      for (std::size_t i = 0; i < rows_; i++)
+        simd::Add(data_ + i * stride_,
+                  expr.Self().Data() + i * expr.Self().Stride(), cols_);
+      return *this;
+    } else {
+      return *this = *this + expr.Self();
+    }
+  }
+
+  /// @throw std::runtime_error if the shapes differ.
+  template <typename E>
+  S21MatrixView &operator-=(const MatrixExpression<E> &expr) {
+    if constexpr (std::is_same_v<E, S21Matrix<value_type>> ||
+                  std::is_same_v<E, S21MatrixView<value_type>> ||
+                  std::is_same_v<E, S21MatrixView<const value_type>>) {
+      static_assert(!std::is_const_v<T>, "The view is read-only");
+      detail::CheckViewShape(*this, expr.Self());
+      for (std::size_t i = 0; i < rows_; i++)
+        simd::Sub(data_ + i * stride_,
+                  expr.Self().Data() + i * expr.Self().Stride(), cols_);
+      return *this;
+    } else {
+      return *this = *this - expr.Self();
+    }
+  }
+
+  S21MatrixView &operator*=(value_type num) {
+    static_assert(!std::is_const_v<T>, "The view is read-only");
+    for (std::size_t i = 0; i < rows_; i++)
+      simd::Scale(data_ + i * stride_, num, cols_);
+    return *this;
+  }
+
+ private:
+  T *data_;
+  std::size_t rows_;
+  std::size_t cols_;
+  std::size_t stride_;
+};
+
+/// @brief Every `row_step`-th row and `col_step`-th column of a region of
+/// a matrix, such as a column or the even elements of a row.
+/// @note Element (i, j) lives at `Data()[i * RowStride() + j * ColStride()]`.
+/// Unlike S21MatrixView, rows are not contiguous, so products with a
+/// strided view go through a packed copy.
+/// @tparam T `U` for a writable view, `const U` for a read-only one.
+template <typename T = double>
+class S21StridedView : public MatrixExpression<S21StridedView<T>> {
+ public:
+  using value_type = std::remove_const_t<T>;
+
+  S21StridedView(T *data, std::size_t rows, std::size_t cols,
+                 std::size_t row_stride, std::size_t col_stride) noexcept
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        row_stride_(row_stride),
+        col_stride_(col_stride) {}
+
+  /// @brief Makes a read-only view of a writable one.
+  template <typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, T> &&
+                                        !std::is_const_v<U>>>
+  S21StridedView(const S21StridedView<U> &view) noexcept  // NOLINT
+      : S21StridedView(view.Data(), view.GetRows(), view.GetCols(),
+                       view.RowStride(), view.ColStride()) {}
+
+  S21StridedView(const S21StridedView &other) = default;
+
+  std::size_t GetRows() const noexcept { return rows_; }
+  std::size_t GetCols() const noexcept { return cols_; }
+  std::size_t RowStride() const noexcept { return row_stride_; }
+  std::size_t ColStride() const noexcept { return col_stride_; }
+  T *Data() const noexcept { return data_; }
+
+  value_type Coeff(std::size_t row, std::size_t col) const {
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+
+  /// @throw std::out_of_range if the index is outside of the view.
+  T &operator()(std::size_t row, std::size_t col) const {
+    detail::CheckViewIndex(row, col, rows_, cols_);
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+
+  /// @brief Writes the elements of `other` into the viewed ones.
+  /// @throw std::runtime_error if the shapes differ.
+  S21StridedView &operator=(const S21StridedView &other) {
+    return *this =
+               static_cast<const MatrixExpression<S21StridedView> &>(other);
+  }
+
+  /// @brief Writes the value of an expression into the viewed elements.
+  /// @note As for S21MatrixView, the expression may refer to the same
+  /// elements but not to other overlapping ones.
+  /// @throw std::runtime_error if the shapes differ.
+  template <typename E>
+  S21StridedView &operator=(const MatrixExpression<E> &expr) {
+    static_assert(!std::is_const_v<T>, "The view is read-only");
+    const E &e = expr.Self();
+    detail::CheckViewShape(*this, e);
+    for (std::size_t i = 0; i < rows_; i++)
+      for (std::size_t j = 0; j < cols_; j++)
+        data_[i * row_stride_ + j * col_stride_] = e.Coeff(i, j);
+    return *this;
+  }
+
+ private:
+  T *data_;
+  std::size_t rows_;
+  std::size_t cols_;
+  std::size_t row_stride_;
+  std::size_t col_stride_;
+};
+
+/// @brief A matrix without one of its rows and one of its columns.
+/// @note Read-only. Replaces the (n-1) x (n-1) copy of S21Matrix::GetMinor()
+/// wherever the minor is only read, e.g. to factorize it with LU.
+/// @tparam T The type of the matrix elements.
+template <typename T>
+class S21MinorView : public MatrixExpression<S21MinorView<T>> {
+ public:
+  using value_type = T;
+
+  /// @throw std::out_of_range if the index is outside of `base`.
+  S21MinorView(S21MatrixView<const T> base, std::size_t row, std::size_t col)
+      : base_(base), row_(row), col_(col) {
+    detail::CheckViewIndex(row, col, base.GetRows(), base.GetCols());
+  }
+
+  std::size_t GetRows() const noexcept { return base_.GetRows() - 1; }
+  std::size_t GetCols() const noexcept { return base_.GetCols() - 1; }
+
+  /// @brief Gets the row and the column of the base that are left out.
+  std::size_t GetExcludedRow() const noexcept { return row_; }
+  std::size_t GetExcludedCol() const noexcept { return col_; }
+
+  T Coeff(std::size_t row, std::size_t col) const {
+    return base_.Coeff(row + (row >= row_), col + (col >= col_));
+  }
+
+  /// @brief Copies the minor into a row-major buffer with rows `stride`
+  /// elements apart.
+  void CopyTo(T *dst, std::size_t stride) const {
+    for (std::size_t i = 0, k = 0; i < base_.GetRows(); i++) {
+      if (i == row_) continue;
+      const T *src = base_.Data() + i * base_.Stride();
+      T *row = dst + k++ * stride;
+      std::copy(src, src + col_, row);
+      std::copy(src + col_ + 1, src + base_.GetCols(), row + col_);
+    }
+  }
+
+  /// @throw std::out_of_range if the index is outside of the view.
+  const T &operator()(std::size_t row, std::size_t col) const {
+    detail::CheckViewIndex(row, col, GetRows(), GetCols());
+    return base_.Data()[(row + (row >= row_)) * base_.Stride() + col +
+                        (col >= col_)];
+  }
+
+ private:
+  S21MatrixView<const T> base_;
+  std::size_t row_;
+  std::size_t col_;
+};
+
+template <typename T>
+S21MinorView<typename S21MatrixView<T>::value_type>
+S21MatrixView<T>::GetMinorView(std::size_t row, std::size_t col) const {
+  return S21MinorView<value_type>(*this, row, col);
+}
+
+namespace detail {
+
+// Whether the intervals [a, a + a_count) and [b, b + b_count) intersect.
+inline bool Intersect(std::size_t a, std::size_t a_count, std::size_t b,
+                      std::size_t b_count) {
+  return a < b + b_count && b < a + a_count;
+}
+
+/// @brief Tells whether two views share an element.
+/// @note Blocks of one matrix, which have the same stride, are compared
+/// exactly, so the disjoint blocks of a blocked algorithm are not reported.
+/// Views with different strides are compared by the address ranges they
+/// span, which may report an overlap that does not exist.
+template <typename T>
+bool Overlap(const S21MatrixView<const T> &a, const S21MatrixView<const T> &b) {
+  if (a.GetRows() == 0 || a.GetCols() == 0 || b.GetRows() == 0 ||
+      b.GetCols() == 0)
+    return false;
+  const auto address = [](const T *p) {
+    return reinterpret_cast<std::uintptr_t>(p) / sizeof(T);
+  };
+  const std::uintptr_t a_first = address(a.Data()), b_first = address(b.Data());
+  if (b_first < a_first) return Overlap(b, a);
+  const std::size_t stride = a.Stride();
+  const std::uintptr_t a_last = a_first + (a.GetRows() - 1) * stride +
+                                a.GetCols();
+  if (b_first >= a_last) return false;
+  if (b.Stride() != stride || stride == 0) return true;
+
+  // B starts at (row, col) of A; columns past the stride belong to the
+  // next row.
+  const std::size_t row = (b_first - a_first) / stride;
+  const std::size_t col = (b_first - a_first) % stride;
+  const std::size_t head = std::min(b.GetCols(), stride - col);
+  if (Intersect(0, a.GetRows(), row, b.GetRows()) &&
+      Intersect(0, a.GetCols(), col, head))
+    return true;
+  return head < b.GetCols() &&
+         Intersect(0, a.GetRows(), row + 1, b.GetRows()) &&
+         Intersect(0, a.GetCols(), 0, b.GetCols() - head);
+}
+
+template <typename T>
+struct Identity {
+  using type = T;
+};
+
+}  // namespace detail
+
+/// @brief Computes C = alpha * A * B + beta * C in place.
+/// @note The operands may be blocks of larger matrices, e.g.
+/// `Gemm(-1.0, a.Block(k, 0, m, k), a.Block(0, k, k, n), 1.0,
+/// a.Block(k, k, m, n))`, and are multiplied by the GEMM kernel of
+/// s21_gemm.hpp without being copied. When beta is zero the previous
+/// contents of C are ignored.
+/// @param c The output; it must not share memory with `a` or `b`.
+/// @throw std::runtime_error if the shapes are incompatible or C shares
+/// memory with A or B.
+template <typename T>
+void Gemm(T alpha,
+          typename detail::Identity<S21MatrixView<const T>>::type a,
+          typename detail::Identity<S21MatrixView<const T>>::type b, T beta,
+          typename detail::Identity<S21MatrixView<T>>::type c) {
+  if (a.GetCols() != b.GetRows() || a.GetRows() != c.GetRows() ||
+      b.GetCols() != c.GetCols())
+    throw std::runtime_error(
+        "Matrix dimensions are incompatible for multiplication");
+  if (detail::Overlap<T>(a, c) || detail::Overlap<T>(b, c))
+    throw std::runtime_error("Gemm cannot write over its input");
+  S21_INSTRUMENT(kGemm, 2 * a.GetRows() * a.GetCols() * b.GetCols());
+  detail::Gemm(a.GetRows(), b.GetCols(), a.GetCols(), alpha, a.Data(),
+               a.Stride(), b.Data(), b.Stride(), beta, c.Data(), c.Stride());
+}
+
+}  // namespace S21
+
+#endif  // S21_VIEW_HPP_
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+S21MatrixBatch<> SampleBatch(std::size_t count, std::size_t rows,
+                             std::size_t cols) {
+  S21MatrixBatch<> batch(count, rows, cols);
+  for (std::size_t b = 0; b < count; b++)
+    batch.Set(b, DiagonallyDominant(rows, cols, b));
+  return batch;
+}
+
+}  // namespace
+
+TEST(BatchTest, Test1) {
+  S21MatrixBatch<> batch(13, 3, 2);
+  EXPECT_EQ(batch.GetCount(), 13);
+  EXPECT_EQ(batch.GetRows(), 3);
+  EXPECT_EQ(batch.GetCols(), 2);
+  EXPECT_EQ(batch.ChunkSize(), 6 * S21MatrixBatch<>::kLanes);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(batch.Data()) %
+                S21Matrix<>::kAlignment,
+            0);
+  batch(12, 2, 1) = 4.0;
+  const std::size_t lanes = S21MatrixBatch<>::kLanes;
+  EXPECT_DOUBLE_EQ(batch.Data()[12 / lanes * batch.ChunkSize() +
+                                (2 * 2 + 1) * lanes + 12 % lanes],
+                   4.0);
+  EXPECT_DOUBLE_EQ(batch.Get(12)(2, 1), 4.0);
+  EXPECT_THROW(batch(13, 0, 0), std::out_of_range);
+  EXPECT_THROW(batch(0, 3, 0), std::out_of_range);
+  EXPECT_THROW(batch.Get(13), std::out_of_range);
+  EXPECT_THROW(batch.Set(0, S21Matrix<>(2, 3)), std::runtime_error);
+}
+
+TEST(BatchTest, Test2) {
+  const std::size_t count = 13;
+  S21MatrixBatch<> a = SampleBatch(count, 3, 4);
+  S21MatrixBatch<> b = SampleBatch(count, 4, 2);
+  S21MatrixBatch<> c = SampleBatch(count, 3, 4);
+  S21MatrixBatch<> sum = a, difference = a, product = a;
+  sum.SumMatrix(c);
+  difference.SubMatrix(c);
+  difference.MulNumber(2.0);
+  product.MulMatrix(b);
+  ASSERT_EQ(product.GetRows(), 3);
+  ASSERT_EQ(product.GetCols(), 2);
+  for (std::size_t i = 0; i < count; i++) {
+    EXPECT_TRUE(sum.Get(i) == a.Get(i) + c.Get(i));
+    EXPECT_TRUE(difference.Get(i) == (a.Get(i) - c.Get(i)) * 2.0);
+    EXPECT_TRUE(product.Get(i) == a.Get(i) * b.Get(i));
+  }
+  EXPECT_THROW(a.SumMatrix(b), std::runtime_error);
+  EXPECT_THROW(a.MulMatrix(c), std::runtime_error);
+  EXPECT_THROW(a.MulMatrix(SampleBatch(count + 1, 4, 2)), std::runtime_error);
+}
+
+TEST(BatchTest, Test3) {
+  const std::size_t count = 13, n = 5;
+  S21MatrixBatch<> batch = SampleBatch(count, n, n);
+  batch.Set(4, S21Matrix<>(n, n));  // Singular lanes have determinant 0
+  S21Matrix<> rank_deficient = DiagonallyDominant(n, n, 9);
+  for (std::size_t j = 0; j < n; j++)
+    rank_deficient(3, j) = 2.0 * rank_deficient(1, j);
+  batch.Set(9, rank_deficient);
+  std::vector<double> det = batch.Determinant();
+  ASSERT_EQ(det.size(), count);
+  for (std::size_t i = 0; i < count; i++)
+    EXPECT_NEAR(det[i], batch.Get(i).Determinant(),
+                1e-9 * std::max(1.0, std::abs(det[i])));
+  EXPECT_DOUBLE_EQ(det[4], 0.0);
+  EXPECT_THROW(batch.InverseMatrix(), std::runtime_error);
+  EXPECT_THROW(SampleBatch(count, 2, 3).Determinant(), std::runtime_error);
+}
+
+TEST(BatchTest, Test4) {
+  const std::size_t count = 21, n = 4;
+  S21MatrixBatch<> batch = SampleBatch(count, n, n);
+  S21MatrixBatch<> inverse = batch.InverseMatrix();
+  S21MatrixBatch<> rhs = SampleBatch(count, n, 3);
+  S21MatrixBatch<> solution = batch.Solve(rhs);
+  ASSERT_EQ(solution.GetCols(), 3);
+  for (std::size_t i = 0; i < count; i++) {
+    EXPECT_LT(Distance(inverse.Get(i), batch.Get(i).InverseMatrix()), 1e-12);
+    EXPECT_LT(Distance(batch.Get(i) * solution.Get(i), rhs.Get(i)), 1e-12);
+  }
+  EXPECT_THROW(batch.Solve(SampleBatch(count, n + 1, 1)), std::runtime_error);
+}
+
+TEST(BatchTest, Test5) {
+  // Large enough to be split over the thread pool.
+  const std::size_t count = 20000, n = 4;
+  S21MatrixBatch<float> batch(count, n, n);
+  for (std::size_t b = 0; b < count; b++)
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t j = 0; j < n; j++)
+        batch(b, i, j) = i == j ? 4.0f + b % 3 : (i + j + b) % 5 * 0.25f;
+  S21MatrixBatch<float> inverse = batch.InverseMatrix();
+  S21MatrixBatch<float> product = batch;
+  product.MulMatrix(inverse);
+  std::vector<float> det = batch.Determinant();
+  for (std::size_t b = 0; b < count; b += 997) {
+    S21Matrix<float> expected = batch.Get(b);
+    EXPECT_NEAR(det[b], expected.Determinant(), 1e-3f * std::abs(det[b]));
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t j = 0; j < n; j++)
+        EXPECT_NEAR(product(b, i, j), i == j ? 1.0f : 0.0f, 1e-5f);
+  }
+}
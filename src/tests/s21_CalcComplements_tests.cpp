@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
 
 using namespace S21;
 
@@ -23,7 +24,7 @@ TEST(S21MatrixTest, s21_CalcComplements_test_2) {
   expected(1, 0) = -2;
   expected(1, 1) = 1;
 
-  EXPECT_TRUE(matrix1.CalcComplements().EqMatrix(expected));
+  EXPECT_LT(Distance(matrix1.CalcComplements(), expected), 1e-9);
 }
 
 TEST(S21MatrixTest, s21_CalcComplements_test_3) {
@@ -62,7 +63,7 @@ TEST(S21MatrixTest, s21_CalcComplements_test_3) {
   expected(3, 2) = 0;
   expected(3, 3) = -3;
 
-  EXPECT_TRUE(matrix1.CalcComplements().EqMatrix(expected));
+  EXPECT_LT(Distance(matrix1.CalcComplements(), expected), 1e-9);
 }
 
 TEST(S21MatrixTest, s21_CalcComplements_test_4) {
@@ -87,5 +88,80 @@ TEST(S21MatrixTest, s21_CalcComplements_test_4) {
   expected(2, 1) = -2;
   expected(2, 2) = 4;
 
+  EXPECT_LT(Distance(matrix1.CalcComplements(), expected), 1e-9);
+}
+
+static S21Matrix<double> BruteForceComplements(S21Matrix<double> &m) {
+  S21Matrix<double> result(m.GetRows(), m.GetCols());
+  for (std::size_t i = 0; i < m.GetRows(); i++)
+    for (std::size_t j = 0; j < m.GetCols(); j++)
+      result(i, j) =
+          ((i + j) % 2 ? -1.0 : 1.0) * m.GetMinor(i, j).Determinant();
+  return result;
+}
+
+TEST(S21MatrixTest, s21_CalcComplements_test_5) {
+  // Rank 2: the cofactor matrix has rank one.
+  S21Matrix matrix1{3, 3};
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 3; j++) matrix1(i, j) = 3.0 * i + j + 1;
+  S21Matrix expected{3, 3};
+  expected(0, 0) = -3;
+  expected(0, 1) = 6;
+  expected(0, 2) = -3;
+  expected(1, 0) = 6;
+  expected(1, 1) = -12;
+  expected(1, 2) = 6;
+  expected(2, 0) = -3;
+  expected(2, 1) = 6;
+  expected(2, 2) = -3;
+
+  EXPECT_LT(Distance(matrix1.CalcComplements(), expected), 1e-9);
+}
+
+TEST(S21MatrixTest, s21_CalcComplements_test_6) {
+  // Rank 1: every minor of order n - 1 vanishes.
+  S21Matrix matrix1{4, 4};
+  for (std::size_t i = 0; i < 4; i++)
+    for (std::size_t j = 0; j < 4; j++) matrix1(i, j) = (i + 1.0) * (j + 2.0);
+
+  EXPECT_LT(Distance(matrix1.CalcComplements(), S21Matrix(4, 4)), 1e-9);
+}
+
+TEST(S21MatrixTest, s21_CalcComplements_test_7) {
+  // A singular matrix whose zero pivot partial pivoting meets early.
+  S21Matrix matrix1{5, 5};
+  for (std::size_t i = 0; i < 5; i++)
+    for (std::size_t j = 0; j < 5; j++)
+      matrix1(i, j) = static_cast<double>((i * 3 + j * j + 1) % 7);
+  for (std::size_t i = 0; i < 5; i++) matrix1(i, 1) = 0;
+  S21Matrix expected = BruteForceComplements(matrix1);
+
+  EXPECT_LT(Distance(matrix1.CalcComplements(), expected), 1e-9);
+}
+
+TEST(S21MatrixTest, s21_CalcComplements_test_8) {
+  S21Matrix matrix1{7, 7};
+  for (std::size_t i = 0; i < 7; i++)
+    for (std::size_t j = 0; j < 7; j++)
+      matrix1(i, j) = static_cast<double>((i * 5 + j * 3 + i * j) % 11) - 5;
+  S21Matrix expected = BruteForceComplements(matrix1);
+
+  EXPECT_LT(Distance(matrix1.CalcComplements(), expected), 1e-9);
+  // The full-rank branch of the fallback agrees with the regular path.
+  EXPECT_LT(Distance(detail::CofactorsCompletePivoting(matrix1), expected),
+            1e-9);
+}
+
+TEST(S21MatrixTest, s21_CalcComplements_test_9) {
+  const int values[3][3] = {{2, 5, 7}, {6, 3, 4}, {5, -2, -3}};
+  const int cofactors[3][3] = {{-1, 38, -27}, {1, -41, 29}, {-1, 34, -24}};
+  S21Matrix<int> matrix1{3, 3}, expected{3, 3};
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 3; j++) {
+      matrix1(i, j) = values[i][j];
+      expected(i, j) = cofactors[i][j];
+    }
+
   EXPECT_TRUE(matrix1.CalcComplements().EqMatrix(expected));
-}
\ No newline at end of file
+}
@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+std::vector<simd::Isa> SupportedIsas() {
+  std::vector<simd::Isa> isas;
+  for (simd::Isa isa : {simd::Isa::kScalar, simd::Isa::kSse2,
+                        simd::Isa::kAvx2, simd::Isa::kAvx512}) {
+    if (isa <= simd::DetectIsa()) isas.push_back(isa);
+  }
+  return isas;
+}
+
+CompareOptions Options(Comparison mode, double tolerance,
+                       std::uint64_t max_ulps = 4) {
+  CompareOptions options;
+  options.mode = mode;
+  options.tolerance = tolerance;
+  options.max_ulps = max_ulps;
+  return options;
+}
+
+// Moves `value` by `ulps` representable values towards +infinity.
+template <typename T>
+T Next(T value, int ulps) {
+  for (int i = 0; i < ulps; i++)
+    value = std::nextafter(value, std::numeric_limits<T>::infinity());
+  return value;
+}
+
+// Runs the relative and ULP kernels of every supported instruction set on
+// lengths up to 100, which cover the unrolled loops and the tails, with
+// mismatches at several positions.
+template <typename T>
+void CheckKernels() {
+  for (simd::Isa isa : SupportedIsas()) {
+    simd::ForceIsa(isa);
+    SCOPED_TRACE(simd::IsaName(isa));
+    for (std::size_t count = 0; count <= 100; count++) {
+      std::vector<T> lhs(count), rhs(count);
+      for (std::size_t i = 0; i < count; i++) {
+        lhs[i] = static_cast<T>(std::sin(i * 0.3 + 0.1) * 100.0);
+        rhs[i] = Next(lhs[i], 2);
+      }
+      ASSERT_TRUE(simd::EqualUlp(lhs.data(), rhs.data(), count, 2));
+      ASSERT_TRUE(simd::EqualRelative(lhs.data(), rhs.data(), count,
+                                      4 * std::numeric_limits<T>::epsilon()));
+      for (std::size_t i = 0; i < count; i += 7) {
+        std::vector<T> other = rhs;
+        other[i] = Next(lhs[i], 3);
+        ASSERT_FALSE(simd::EqualUlp(lhs.data(), other.data(), count, 2));
+        other[i] = lhs[i] * T(1.01);
+        ASSERT_FALSE(simd::EqualRelative(lhs.data(), other.data(), count,
+                                         T(0.001)));
+        other[i] = std::numeric_limits<T>::quiet_NaN();
+        ASSERT_FALSE(simd::EqualUlp(lhs.data(), other.data(), count,
+                                    std::numeric_limits<std::uint64_t>::max()));
+        ASSERT_FALSE(simd::EqualRelative(lhs.data(), other.data(), count,
+                                         T(1e30)));
+        other[i] = std::numeric_limits<T>::infinity();
+        ASSERT_FALSE(simd::EqualRelative(lhs.data(), other.data(), count,
+                                         T(1e30)));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// Returns to the default instruction set even when an assertion fails.
+class CompareTest : public ::testing::Test {
+ protected:
+  void TearDown() override { simd::ResetIsa(); }
+};
+
+TEST_F(CompareTest, Test1) {
+  CheckKernels<double>();
+  CheckKernels<float>();
+  EXPECT_EQ(simd::UlpDistance(0.0, -0.0), 0);
+  EXPECT_EQ(simd::UlpDistance(-Next(0.0, 1), Next(0.0, 2)), 3);
+  EXPECT_EQ(simd::UlpDistance(1.0f, Next(1.0f, 5)), 5);
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(simd::UlpDistance(inf, inf), 0);
+  EXPECT_EQ(simd::UlpDistance(std::numeric_limits<double>::max(), inf), 1);
+  EXPECT_EQ(simd::UlpDistance(1.0L, 1.0L), 0);
+  EXPECT_EQ(simd::UlpDistance(std::nan(""), 1.0),
+            std::numeric_limits<std::uint64_t>::max());
+}
+
+TEST_F(CompareTest, Test2) {
+  const S21Matrix<> a = Sample(30, 40) * 1e3;
+  S21Matrix<> b = a;
+  b(17, 23) = Next(b(17, 23), 3);
+  const S21Matrix<> &c = b;
+  EXPECT_TRUE(a == c);
+  EXPECT_TRUE(Compare(a, b, Options(Comparison::kUlp, 0, 3)));
+  EXPECT_FALSE(Compare(a, b, Options(Comparison::kUlp, 0, 2)));
+  EXPECT_FALSE(a.EqMatrix(b, Options(Comparison::kAbsolute, 0.0)));
+
+  // Relative tolerance scales with the magnitude, absolute does not.
+  b(3, 4) = a(3, 4) * (1 + 1e-9);
+  b(5, 6) = a(5, 6) * 1e6;
+  S21Matrix<> big = b * 1e6;
+  const S21Matrix<> big_a = a * 1e6;
+  EXPECT_FALSE(Compare(a, b, Options(Comparison::kRelative, 1e-8)));
+  b(5, 6) = a(5, 6);
+  EXPECT_TRUE(Compare(a, b, Options(Comparison::kRelative, 1e-8)));
+  EXPECT_FALSE(Compare(a, b, Options(Comparison::kRelative, 1e-10)));
+  big(5, 6) = big_a(5, 6);
+  EXPECT_TRUE(Compare(big_a, big, Options(Comparison::kRelative, 1e-8)));
+  EXPECT_FALSE(big_a.EqMatrix(big));
+
+  // Blocks, expressions, shapes and NaN.
+  EXPECT_TRUE(Compare(a.Block(0, 0, 3, 40), b.Block(0, 0, 3, 40)));
+  EXPECT_TRUE(Compare(a * 2.0, a + a));
+  EXPECT_FALSE(Compare(a.Block(0, 0, 3, 30), a.Block(0, 0, 30, 3)));
+  EXPECT_TRUE(Compare(a.Block(0, 0, 0, 4), b.Block(1, 1, 0, 4)));
+  b(29, 39) = std::nan("");
+  EXPECT_FALSE(Compare(b, b, Options(Comparison::kUlp, 0, 1000)));
+
+  // An infinity never matches a finite value, in rows long enough for the
+  // vector kernels and in the scalar tail.
+  const double inf = std::numeric_limits<double>::infinity();
+  S21Matrix<> finite(2, 67), infinite(2, 67);
+  finite(1, 37) = -5.0;
+  infinite(1, 37) = inf;
+  infinite(1, 66) = -inf;
+  for (Comparison mode :
+       {Comparison::kAbsolute, Comparison::kRelative, Comparison::kUlp}) {
+    const CompareOptions options = Options(mode, 1e-9);
+    EXPECT_FALSE(Compare(finite, infinite, options));
+    EXPECT_FALSE(Compare(finite.Block(1, 60, 1, 7),
+                         infinite.Block(1, 60, 1, 7), options));
+    const MatrixDiff diff = Diff(finite, infinite, options);
+    EXPECT_FALSE(diff.equal);
+    EXPECT_EQ(diff.mismatches, 2);
+    EXPECT_GT(diff.max_error, 1e18);
+    EXPECT_EQ(diff.row, 1);
+    if (mode != Comparison::kUlp) {
+      EXPECT_EQ(diff.max_error, inf);
+      EXPECT_EQ(diff.col, 37);
+    }
+  }
+  EXPECT_TRUE(Compare(infinite, infinite,
+                      Options(Comparison::kRelative, 1e-9)));
+  EXPECT_TRUE(Compare(infinite, infinite, Options(Comparison::kUlp, 0)));
+
+  // Integers: exact by default, ULPs are units.
+  S21Matrix<int> i(2, 3), j(2, 3);
+  j(1, 2) = 2;
+  EXPECT_FALSE(i == j);
+  EXPECT_TRUE(Compare(i, j, Options(Comparison::kUlp, 0, 2)));
+  EXPECT_FALSE(Compare(i, j, Options(Comparison::kRelative, 0.5)));
+  EXPECT_TRUE(Compare(i, j, Options(Comparison::kAbsolute, 2.0)));
+
+  // Differences beyond the range of the element type, on every
+  // instruction set.
+  S21Matrix<int> k(3, 70), l(3, 70);
+  S21Matrix<signed char> m(4, 100), n(4, 100);
+  k(1, 3) = 2000000000;
+  l(1, 3) = -2000000000;
+  m(2, 50) = 100;
+  n(2, 50) = -100;
+  for (simd::Isa isa : SupportedIsas()) {
+    simd::ForceIsa(isa);
+    SCOPED_TRACE(simd::IsaName(isa));
+    for (Comparison mode :
+         {Comparison::kAbsolute, Comparison::kRelative, Comparison::kUlp}) {
+      EXPECT_FALSE(Compare(k, l, Options(mode, 1.5, 2)));
+      EXPECT_FALSE(Compare(m, n, Options(mode, 1.5, 2)));
+    }
+    EXPECT_TRUE(Compare(m, n, Options(Comparison::kAbsolute, 200.0)));
+    EXPECT_FALSE(Compare(m, n, Options(Comparison::kAbsolute, 199.0)));
+    EXPECT_TRUE(Compare(m, n, Options(Comparison::kUlp, 0, 200)));
+    EXPECT_FALSE(Compare(m, n, Options(Comparison::kUlp, 0, 199)));
+    EXPECT_TRUE(Compare(k, l, Options(Comparison::kAbsolute, 4e9)));
+  }
+}
+
+TEST_F(CompareTest, Test3) {
+  // Large enough for bands on several threads and early-exit checks.
+  const S21Matrix<> a = Sample(1100, 1000) * 1e3;
+  S21Matrix<> b = a;
+  b(1099, 999) += 1.0;
+  b(400, 10) -= 1.0;
+  b(7, 500) += 1e-7;
+  b(1050, 3) = std::nan("");
+  const ScopedThreadCount threads(3);
+  EXPECT_FALSE(Compare(a, b));
+  EXPECT_TRUE(Compare(a, a));
+  EXPECT_TRUE(Compare(a.Block(0, 0, 300, 1000), b.Block(0, 0, 300, 1000)));
+  const MatrixDiff diff = Diff(a, b);
+  const MatrixDiff block =
+      Diff(a.Block(0, 0, 1000, 900), b.Block(0, 0, 1000, 900));
+  // Ties go to the first element in row order, across bands.
+  const S21Matrix<> zero(1100, 1000);
+  S21Matrix<> c = zero;
+  c(1000, 2) = 0.5;
+  c(100, 5) = -0.5;
+  const MatrixDiff tie = Diff(zero, c, Options(Comparison::kAbsolute, 1.0));
+
+  EXPECT_FALSE(diff.equal);
+  EXPECT_EQ(diff.mismatches, 3);
+  EXPECT_EQ(diff.max_error, std::numeric_limits<double>::infinity());
+  EXPECT_EQ(diff.row, 1050);
+  EXPECT_EQ(diff.col, 3);
+  EXPECT_EQ(block.mismatches, 1);
+  EXPECT_NEAR(block.max_error, 1.0, 1e-9);
+  EXPECT_EQ(block.row, 400);
+  EXPECT_EQ(block.col, 10);
+  EXPECT_TRUE(tie.equal);
+  EXPECT_EQ(tie.mismatches, 0);
+  EXPECT_EQ(tie.max_error, 0.5);
+  EXPECT_EQ(tie.row, 100);
+  EXPECT_EQ(tie.col, 5);
+
+  const MatrixDiff same = Diff(a, a, Options(Comparison::kUlp, 0, 0));
+  EXPECT_TRUE(same.equal);
+  EXPECT_EQ(same.max_error, 0.0);
+  EXPECT_EQ(same.row, 0);
+  std::ostringstream out;
+  out << Diff(a.Block(0, 0, 2, 2), b.Block(1, 4, 2, 2));
+  EXPECT_EQ(out.str().rfind("not equal, 4 mismatches", 0), 0);
+  EXPECT_THROW(Diff(a, a.Block(0, 0, 2, 2)), std::runtime_error);
+}
@@ -54,6 +54,26 @@ TEST(DeterminantTest, Test5) {
   EXPECT_THROW(matrix1.Determinant(), std::overflow_error);
 }
 
+TEST(DeterminantTest, Test6) {
+  S21Matrix<int> matrix1{3, 3};
+  matrix1[0][0] = 0;
+  matrix1[0][1] = 2;
+  matrix1[0][2] = 1;
+  matrix1[1][0] = 3;
+  matrix1[1][1] = 1;
+  matrix1[1][2] = 4;
+  matrix1[2][0] = 1;
+  matrix1[2][1] = 5;
+  matrix1[2][2] = 9;
+  EXPECT_EQ(matrix1.Determinant(), -32);
+  matrix1[2][2] = 11;
+  EXPECT_EQ(matrix1.Determinant(), -44);
+  matrix1[0][1] = 0;
+  matrix1[1][1] = 0;
+  matrix1[2][1] = 0;
+  EXPECT_EQ(matrix1.Determinant(), 0);
+}
+
 TEST(GetMinorTest, Test4) {
   S21Matrix matrix1{2, 2};
   matrix1[0][0] = 1.0;
@@ -38,4 +38,38 @@ TEST(EqTest, Test3) {
   matrix1.RandomizeMatrix();
   matrix2.RandomizeMatrix();
   EXPECT_FALSE(matrix1.EqMatrix(matrix2));
-}
\ No newline at end of file
+}
+
+TEST(EqTest, Test4) {
+  // Differences that overflow the element type, in the vector kernels and
+  // in the scalar tail.
+  S21Matrix<signed char> chars1(4, 100), chars2(4, 100);
+  chars1(1, 20) = 100;
+  chars2(1, 20) = -100;
+  EXPECT_FALSE(chars1.EqMatrix(chars2));
+  chars2(1, 20) = 100;
+  EXPECT_TRUE(chars1.EqMatrix(chars2));
+  chars1(3, 99) = -128;
+  chars2(3, 99) = 127;
+  EXPECT_FALSE(chars1.EqMatrix(chars2));
+
+  S21Matrix<int> ints1(3, 70), ints2(3, 70);
+  ints1(0, 5) = 2000000000;
+  ints2(0, 5) = -2000000000;
+  EXPECT_FALSE(ints1.EqMatrix(ints2));
+  EXPECT_FALSE(ints1 == ints2);
+  ints2(0, 5) = 2000000000;
+  ints2(2, 69) = 1;
+  EXPECT_FALSE(ints1.EqMatrix(ints2));
+}
+
+TEST(EqTest, Test5) {
+  // Elements that differ by at most EPSILON compare equal.
+  S21Matrix<> matrix1(3, 3), matrix2(3, 3);
+  matrix1(1, 2) = 1.0;
+  matrix2(1, 2) = 1.0 + EPSILON / 2;
+  EXPECT_TRUE(matrix1.EqMatrix(matrix2));
+  EXPECT_TRUE(matrix1 == matrix2);
+  matrix2(1, 2) = 1.0 + 2 * EPSILON;
+  EXPECT_FALSE(matrix1.EqMatrix(matrix2));
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_oop.hpp"
+
+using namespace S21;
+
+static S21Matrix<double> Filled(std::size_t rows, std::size_t cols,
+                                double start) {
+  S21Matrix<double> result(rows, cols);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      result(i, j) = start + static_cast<double>(i * cols + j);
+  return result;
+}
+
+TEST(ExpressionTest, Test1) {
+  S21Matrix<double> a = Filled(3, 4, 1), b = Filled(3, 4, 10),
+                    c = Filled(3, 4, -2);
+  S21Matrix<double> result = a + b * 2.0 - c;
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 4; j++)
+      EXPECT_DOUBLE_EQ(result(i, j), a(i, j) + 2.0 * b(i, j) - c(i, j));
+}
+
+TEST(ExpressionTest, Test2) {
+  S21Matrix<double> a = Filled(2, 3, 1), b = Filled(2, 3, 5);
+  S21Matrix<double> expected = Filled(2, 3, 7);
+  for (std::size_t i = 0; i < 2; i++)
+    for (std::size_t j = 0; j < 3; j++) expected(i, j) = 3 * a(i, j) + b(i, j);
+  a = a * 2.0 + b + 1.0 * a;
+  EXPECT_TRUE(a.EqMatrix(expected));
+}
+
+TEST(ExpressionTest, Test3) {
+  S21Matrix<double> a = Filled(2, 3, 1), b = Filled(3, 2, 1);
+  EXPECT_THROW(S21Matrix<double>(a + b), std::runtime_error);
+  EXPECT_THROW(a -= b, std::runtime_error);
+  EXPECT_THROW(S21Matrix<double>(a * a), std::runtime_error);
+}
+
+TEST(ExpressionTest, Test4) {
+  S21Matrix<double> a = Filled(2, 2, 1), b = Filled(2, 2, 0),
+                    c = Filled(2, 3, 1);
+  S21Matrix<double> sum = a + b;
+  S21Matrix<double> expected = sum * c;
+  S21Matrix<double> result = (a + b) * c;
+  EXPECT_TRUE(result.EqMatrix(expected));
+  result += 2.0 * expected;
+  EXPECT_TRUE(result.EqMatrix(expected * 3.0));
+}
+
+TEST(ExpressionTest, Test5) {
+  S21Matrix<double> a = Filled(4, 4, 1), b = Filled(4, 4, 2);
+  S21Matrix<double> result(1, 1);
+  result = a - b;
+  ASSERT_EQ(result.GetRows(), 4);
+  ASSERT_EQ(result.GetCols(), 4);
+  EXPECT_DOUBLE_EQ(result(3, 3), -1.0);
+}
+
+TEST(RvalueOperatorTest, Test1) {
+  S21Matrix<double> a = Filled(3, 3, 1), b = Filled(3, 3, 4);
+  S21Matrix<double> expected = a + b;
+  const double *buffer = a.Data();
+  S21Matrix<double> result = std::move(a) + b;
+  EXPECT_EQ(result.Data(), buffer);
+  EXPECT_TRUE(result.EqMatrix(expected));
+}
+
+TEST(RvalueOperatorTest, Test2) {
+  S21Matrix<double> a = Filled(2, 2, 1), b = Filled(2, 2, 3),
+                    c = Filled(2, 2, -1);
+  S21Matrix<double> product = a * b;
+  S21Matrix<double> expected = c - product;
+  S21Matrix<double> result = c - a * b;
+  EXPECT_TRUE(result.EqMatrix(expected));
+  expected = product + c;
+  result = a * b + c;
+  EXPECT_TRUE(result.EqMatrix(expected));
+}
+
+TEST(RvalueOperatorTest, Test3) {
+  S21Matrix<double> a = Filled(2, 3, 1), b = Filled(2, 3, 2);
+  S21Matrix<double> expected = (a - b) * 2.0;
+  S21Matrix<double> tmp_a(a), tmp_b(b);
+  const double *buffer = tmp_a.Data();
+  S21Matrix<double> result = 2 * (std::move(tmp_a) - std::move(tmp_b));
+  EXPECT_EQ(result.Data(), buffer);
+  EXPECT_TRUE(result.EqMatrix(expected));
+  EXPECT_THROW(S21Matrix<double>(2, 2) + Filled(3, 3, 0), std::runtime_error);
+}
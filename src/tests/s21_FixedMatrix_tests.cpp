@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+template <std::size_t N>
+S21FixedMatrix<double, N, N> WellConditioned() {
+  S21FixedMatrix<double, N, N> matrix;
+  for (std::size_t i = 0; i < N; i++)
+    for (std::size_t j = 0; j < N; j++)
+      matrix(i, j) = i == j ? 10.0 + i : 1.0 / (1.0 + i + 2.0 * j);
+  return matrix;
+}
+
+template <std::size_t N>
+void CheckAgainstDynamic() {
+  using Fixed = S21FixedMatrix<double, N, N>;
+  const Fixed fixed = WellConditioned<N>();
+  S21Matrix<> dynamic = fixed.ToMatrix();
+  EXPECT_NEAR(fixed.Determinant(), dynamic.Determinant(), 1e-9);
+  const S21Matrix<> inverse = fixed.InverseMatrix().ToMatrix();
+  EXPECT_LT(Distance(inverse, dynamic.InverseMatrix()), 1e-12);
+  EXPECT_LT(Distance(dynamic * inverse, Fixed::Identity().ToMatrix()), 1e-12);
+  EXPECT_LT(Distance(dynamic * dynamic, (fixed * fixed).ToMatrix()), 1e-12);
+}
+
+}  // namespace
+
+TEST(FixedMatrixTest, Test1) {
+  constexpr S21FixedMatrix<int, 2, 3> a{1, 2, 3, 4, 5, 6};
+  constexpr S21FixedMatrix<int, 3, 2> b = a.Transpose();
+  constexpr S21FixedMatrix<int, 2, 2> product = a * b;
+  static_assert(product.Coeff(0, 0) == 14 && product.Coeff(0, 1) == 32);
+  static_assert(product.Coeff(1, 0) == 32 && product.Coeff(1, 1) == 77);
+  static_assert(product.Determinant() == 14 * 77 - 32 * 32);
+  static_assert((a + a - a) * 2 == 2 * a);
+  static_assert(sizeof(S21FixedMatrix<float, 3, 3>) == 9 * sizeof(float));
+
+  // Integer matrices above 4x4 go through S21Matrix as well.
+  S21FixedMatrix<int, 5, 5> large = S21FixedMatrix<int, 5, 5>::Identity() * 2;
+  large(0, 4) = 7;
+  large(4, 0) = 1;
+  EXPECT_EQ(large.Determinant(), 16 * 2 - 8 * 7);
+}
+
+TEST(FixedMatrixTest, Test2) {
+  CheckAgainstDynamic<1>();
+  CheckAgainstDynamic<2>();
+  CheckAgainstDynamic<3>();
+  CheckAgainstDynamic<4>();
+  CheckAgainstDynamic<6>();
+}
+
+TEST(FixedMatrixTest, Test3) {
+  const S21FixedMatrix<double, 4, 4> singular{1, 2, 3, 4, 2, 4, 6, 8,
+                                              0, 1, 0, 1, 5, 6, 7, 9};
+  EXPECT_DOUBLE_EQ(singular.Determinant(), 0.0);
+  EXPECT_THROW(singular.InverseMatrix(), std::runtime_error);
+  const S21FixedMatrix<double, 3, 3> m{2, 0, 1, 1, 3, 2, 1, 1, 2};
+  EXPECT_DOUBLE_EQ(m.Determinant(), 6.0);
+
+  // A small determinant alone does not make it singular, as for S21Matrix.
+  const auto scaled = S21FixedMatrix<double, 4, 4>::Identity() * 0.03;
+  EXPECT_NEAR(scaled.Determinant(), 8.1e-7, 1e-18);
+  S21Matrix<> dynamic = scaled.ToMatrix();
+  const S21Matrix<> inverse = scaled.InverseMatrix().ToMatrix();
+  EXPECT_LT(Distance(inverse, dynamic.InverseMatrix()), 1e-9);
+  EXPECT_NEAR(scaled.InverseMatrix()(2, 2), 1.0 / 0.03, 1e-9);
+  const S21FixedMatrix<double, 2, 2> tiny{1e-7, 0, 0, 1e7};
+  EXPECT_THROW(tiny.InverseMatrix(), std::runtime_error);
+  EXPECT_THROW(tiny.ToMatrix().InverseMatrix(), std::runtime_error);
+
+  // Integer differences beyond the range of the element type.
+  const S21FixedMatrix<signed char, 1, 1> c1{100}, c2{-100};
+  const S21FixedMatrix<short, 1, 1> s1{30000}, s2{-30000};
+  const S21FixedMatrix<int, 1, 2> i1{2000000000, 0}, i2{-2000000000, 0};
+  EXPECT_FALSE(c1 == c2);
+  EXPECT_FALSE(s1 == s2);
+  EXPECT_FALSE(i1 == i2);
+  static_assert(!(S21FixedMatrix<int, 1, 1>{2000000000} ==
+                  S21FixedMatrix<int, 1, 1>{-2000000000}));
+}
+
+TEST(FixedMatrixTest, Test4) {
+  S21Matrix<> dynamic(2, 3);
+  EXPECT_THROW((S21FixedMatrix<double, 3, 2>(dynamic)), std::runtime_error);
+  EXPECT_THROW((S21FixedMatrix<double, 2, 2>{1, 2, 3}), std::length_error);
+  S21FixedMatrix<double, 2, 3> fixed;
+  EXPECT_THROW(fixed(2, 0), std::out_of_range);
+  fixed(1, 2) = 5.0;
+  S21Matrix<> round_trip = fixed.ToMatrix();
+  EXPECT_DOUBLE_EQ(round_trip(1, 2), 5.0);
+  EXPECT_TRUE(decltype(fixed)(round_trip) == fixed);
+  S21FixedMatrix<double, 2, 2> square{1, 2, 3, 4};
+  square *= S21FixedMatrix<double, 2, 2>::Identity() * 2.0;
+  EXPECT_TRUE(square == (S21FixedMatrix<double, 2, 2>{2, 4, 6, 8}));
+}
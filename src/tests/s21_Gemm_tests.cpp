@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_oop.hpp"
+
+using namespace S21;
+
+template <typename T>
+static S21Matrix<T> FillPattern(std::size_t rows, std::size_t cols, int seed) {
+  S21Matrix<T> result(rows, cols);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      result(i, j) = static_cast<T>((i * 7 + j * 3 + seed) % 11) - T(5);
+  return result;
+}
+
+template <typename T>
+static S21Matrix<T> MulReference(const S21Matrix<T> &a, const S21Matrix<T> &b) {
+  S21Matrix<T> result(a.GetRows(), b.GetCols());
+  detail::GemmReference(a.GetRows(), b.GetCols(), a.GetCols(), T(1), a.Data(),
+                        a.Stride(), b.Data(), b.Stride(), T(0), result.Data(),
+                        result.Stride());
+  return result;
+}
+
+TEST(GemmTest, Test1) {
+  // Odd sizes exercise partial MR/NR tiles and partial MC/KC blocks.
+  S21Matrix<double> a = FillPattern<double>(131, 301, 1);
+  S21Matrix<double> b = FillPattern<double>(301, 67, 2);
+  S21Matrix<double> expected = MulReference(a, b);
+  a.MulMatrix(b);
+  EXPECT_TRUE(a.EqMatrix(expected));
+}
+
+TEST(GemmTest, Test2) {
+  S21Matrix<float> a = FillPattern<float>(97, 45, 3);
+  S21Matrix<float> b = FillPattern<float>(45, 130, 4);
+  S21Matrix<float> expected = MulReference(a, b);
+  a.MulMatrix(b);
+  EXPECT_TRUE(a.EqMatrix(expected));
+}
+
+TEST(GemmTest, Test3) {
+  S21Matrix<int> a = FillPattern<int>(70, 70, 5);
+  S21Matrix<int> b = FillPattern<int>(70, 70, 6);
+  S21Matrix<int> expected = MulReference(a, b);
+  a.MulMatrix(b);
+  EXPECT_TRUE(a.EqMatrix(expected));
+}
+
+TEST(GemmTest, Test4) {
+  S21Matrix<double> a = FillPattern<double>(40, 50, 7);
+  S21Matrix<double> b = FillPattern<double>(50, 60, 8);
+  S21Matrix<double> c = FillPattern<double>(40, 60, 9);
+  S21Matrix<double> expected(c);
+  detail::GemmReference(40, 60, 50, 2.0, a.Data(), a.Stride(), b.Data(),
+                        b.Stride(), -1.0, expected.Data(), expected.Stride());
+  detail::GemmBlocked(40, 60, 50, 2.0, a.Data(), a.Stride(), b.Data(),
+                      b.Stride(), -1.0, c.Data(), c.Stride());
+  EXPECT_TRUE(c.EqMatrix(expected));
+}
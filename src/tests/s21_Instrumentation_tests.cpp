@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+TEST(InstrumentationTest, Test1) {
+  EXPECT_STREQ(OperationName(Operation::kMulMatrix), "MulMatrix");
+  EXPECT_STREQ(OperationName(Operation::kGetMinor), "GetMinor");
+  EXPECT_STREQ(OperationName(Operation::kCount), "Unknown");
+  if (!kInstrumentationEnabled) {
+    S21Matrix<> a = DiagonallyDominant(4, 4);
+    a.MulMatrix(a);
+    EXPECT_EQ(GetInstrumentationSnapshot().Total().calls, 0);
+    GTEST_SKIP() << "Built without S21_INSTRUMENTATION";
+  }
+
+  S21Matrix<> a = DiagonallyDominant(8, 8), b = DiagonallyDominant(8, 8);
+  ResetInstrumentation();
+  S21Matrix<> product = a * b;
+  a *= b;
+  a *= 2.0;
+  InstrumentationSnapshot snapshot = GetInstrumentationSnapshot();
+  EXPECT_EQ(snapshot[Operation::kProduct].calls, 1);
+  EXPECT_EQ(snapshot[Operation::kProduct].flops, 2 * 8 * 8 * 8);
+  EXPECT_EQ(snapshot[Operation::kProduct].temporaries, 1);
+  EXPECT_EQ(snapshot[Operation::kProduct].bytes_allocated,
+            8 * 8 * sizeof(double));
+  EXPECT_EQ(snapshot[Operation::kMulMatrix].calls, 1);
+  EXPECT_EQ(snapshot[Operation::kMulMatrix].temporaries, 1);
+  EXPECT_EQ(snapshot[Operation::kMulNumber].calls, 1);
+  EXPECT_EQ(snapshot[Operation::kMulNumber].flops, 64);
+  EXPECT_EQ(snapshot[Operation::kMulNumber].temporaries, 0);
+  EXPECT_EQ(snapshot[Operation::kConstruct].calls, 0);
+  EXPECT_EQ(snapshot.Total().calls, 3);
+
+  // Work done inside an operation belongs to it.
+  ResetInstrumentation();
+  S21Matrix<> inverse = b.InverseMatrix();
+  S21Matrix<> copy = b;
+  S21Matrix<> sum = a + b * 2.0;
+  S21Matrix<> fresh(3, 5);
+  snapshot = GetInstrumentationSnapshot();
+  EXPECT_EQ(snapshot[Operation::kInverseMatrix].calls, 1);
+  EXPECT_EQ(snapshot[Operation::kInverseMatrix].temporaries, 1);
+  EXPECT_EQ(snapshot[Operation::kInvertMatrix].calls, 0);
+  EXPECT_EQ(snapshot[Operation::kCopy].calls, 1);
+  EXPECT_EQ(snapshot[Operation::kCopy].temporaries, 1);
+  EXPECT_EQ(snapshot[Operation::kEvaluate].calls, 1);
+  EXPECT_EQ(snapshot[Operation::kEvaluate].temporaries, 1);
+  EXPECT_EQ(snapshot[Operation::kConstruct].calls, 1);
+  EXPECT_EQ(snapshot[Operation::kConstruct].bytes_allocated,
+            S21Matrix<>::kAlignment * 2);
+  EXPECT_EQ(snapshot.Total().temporaries, 4);
+  ResetInstrumentation();
+  EXPECT_EQ(GetInstrumentationSnapshot().Total().calls, 0);
+}
+
+TEST(InstrumentationTest, Test2) {
+  if (!kInstrumentationEnabled)
+    GTEST_SKIP() << "Built without S21_INSTRUMENTATION";
+
+  std::vector<std::string> names;
+  std::vector<OperationStats> calls;
+  SetInstrumentationCallback([&](Operation op, const OperationStats &stats) {
+    names.push_back(OperationName(op));
+    calls.push_back(stats);
+  });
+  S21Matrix<> a = DiagonallyDominant(6, 6);
+  a.Determinant();
+  a.SetRows(7);
+  EXPECT_THROW(a.Determinant(), std::runtime_error);  // Still accounted
+  SetInstrumentationCallback(nullptr);
+  a.Transpose();
+
+  ASSERT_EQ(names, (std::vector<std::string>{"Determinant", "SetRows",
+                                             "Determinant"}));
+  EXPECT_EQ(calls[0].calls, 1);
+  EXPECT_EQ(calls[0].flops, 2 * 6 * 6 * 6 / 3);
+  EXPECT_EQ(calls[0].temporaries, 1);  // The factorized scratch copy
+  EXPECT_EQ(calls[1].temporaries, 1);
+  EXPECT_EQ(calls[1].bytes_allocated, 6 * S21Matrix<>::kAlignment);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
 
 using namespace S21;
 
@@ -23,5 +24,52 @@ TEST(InverseMatrixTest, Test2) {
   expected[1][0] = 1.5;
   expected[1][1] = -0.5;
   S21Matrix res = matrix1.InverseMatrix();
-  EXPECT_TRUE(res.EqMatrix(expected));
-}
\ No newline at end of file
+  EXPECT_LT(Distance(res, expected), 1e-12);
+}
+
+static double DistanceToIdentity(const S21Matrix<double> &m) {
+  S21Matrix<double> identity(m.GetRows(), m.GetCols());
+  for (std::size_t i = 0; i < m.GetRows(); i++) identity(i, i) = 1.0;
+  return Distance(m, identity);
+}
+
+TEST(InverseMatrixTest, Test3) {
+  S21Matrix<double> a = DiagonallyDominant(120, 120);
+  S21Matrix<double> inverse = a.InverseMatrix();
+  EXPECT_LT(DistanceToIdentity(a * inverse), 1e-12);
+  a.InvertMatrix();
+  EXPECT_TRUE(a.EqMatrix(inverse));
+}
+
+TEST(InverseMatrixTest, Test4) {
+  S21Matrix matrix1{2, 2};
+  matrix1[0][0] = 1.0;
+  matrix1[0][1] = 2.0;
+  matrix1[1][0] = 2.0;
+  matrix1[1][1] = 4.0;
+  EXPECT_THROW(matrix1.InverseMatrix(), std::runtime_error);
+  EXPECT_THROW(S21Matrix(2, 3).InverseMatrix(), std::runtime_error);
+}
+
+TEST(InverseMatrixTest, Test5) {
+  // Orders from S21_INVERSE_PARALLEL up take the parallel LU path.
+  const ScopedThreadCount threads(4);
+  S21Matrix<double> a = DiagonallyDominant(300, 300);
+  S21Matrix<double> inverse = a.InverseMatrix();
+  EXPECT_LT(DistanceToIdentity(a * inverse), 1e-12);
+}
+
+TEST(InverseMatrixTest, Test6) {
+  const int values[3][3] = {{2, 5, 7}, {6, 3, 4}, {5, -2, -3}};
+  const int inverse[3][3] = {{1, -1, 1}, {-38, 41, -34}, {27, -29, 24}};
+  S21Matrix<int> matrix1{3, 3}, expected{3, 3};
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 3; j++) {
+      matrix1(i, j) = values[i][j];
+      expected(i, j) = inverse[i][j];
+    }
+
+  EXPECT_TRUE(matrix1.InverseMatrix().EqMatrix(expected));
+  matrix1.InvertMatrix();
+  EXPECT_TRUE(matrix1.EqMatrix(expected));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+std::string TempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() /
+          ("s21_" + name + "_" + std::to_string(getpid()) + ".bin"))
+      .string();
+}
+
+std::vector<char> ReadBytes(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+}
+
+void WriteBytes(const std::string &path, const std::vector<char> &bytes) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+}  // namespace
+
+TEST(IoTest, Test1) {
+  const std::string path = TempPath("io1");
+  S21Matrix<> matrix = Sample(3, 5);
+  SaveMatrix(matrix, path);
+  EXPECT_EQ(std::filesystem::file_size(path), 64 + 15 * sizeof(double));
+  std::pmr::monotonic_buffer_resource arena;
+  S21Matrix<> loaded = LoadMatrix(path, &arena);
+  EXPECT_EQ(loaded.GetResource(), &arena);
+  EXPECT_EQ(loaded.GetRows(), 3);
+  EXPECT_EQ(loaded.GetCols(), 5);
+  EXPECT_TRUE(loaded == matrix);
+
+  S21Matrix<std::int16_t> small(2, 2);
+  small(0, 1) = -300;
+  small(1, 0) = 7;
+  SaveMatrix(small, path, false);
+  S21Matrix<std::int16_t> small_loaded = LoadMatrix<std::int16_t>(path);
+  EXPECT_EQ(small_loaded(0, 1), -300);
+  EXPECT_EQ(small_loaded(1, 0), 7);
+  EXPECT_THROW(LoadMatrix<std::uint16_t>(path), std::runtime_error);
+  EXPECT_THROW(LoadMatrix<double>(path), std::runtime_error);
+
+  SaveMatrix(S21Matrix<float>(0, 4), path);
+  EXPECT_EQ(LoadMatrix<float>(path).GetCols(), 4);
+  std::filesystem::remove(path);
+}
+
+TEST(IoTest, Test2) {
+  const std::string path = TempPath("io2");
+  EXPECT_THROW(LoadMatrix(path), std::runtime_error);
+  SaveMatrix(Sample(4, 4), path);
+  std::vector<char> bytes = ReadBytes(path);
+  bytes[64 + 13] ^= 1;
+  WriteBytes(path, bytes);
+  EXPECT_THROW(LoadMatrix(path), std::runtime_error);
+  EXPECT_NO_THROW(S21MappedMatrix<>{path});
+  EXPECT_THROW(S21MappedMatrix<>(path, MapMode::kReadOnly, true),
+               std::runtime_error);
+
+  bytes.resize(bytes.size() - 1);
+  WriteBytes(path, bytes);
+  EXPECT_THROW(LoadMatrix(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix<>{path}, std::runtime_error);
+  WriteBytes(path, {'1', ' ', '2', '\n'});
+  EXPECT_THROW(LoadMatrix(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix<>{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(IoTest, Test3) {
+  // A file from a machine with the other byte order.
+  const std::string path = TempPath("io3");
+  S21Matrix<> matrix = Sample(3, 2);
+  SaveMatrix(matrix, path);
+  std::vector<char> bytes = ReadBytes(path);
+  for (std::size_t k = 0; k < 6; k++) {
+    char *element = bytes.data() + 64 + k * sizeof(double);
+    std::reverse(element, element + sizeof(double));
+  }
+  MatrixFileHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  header.checksum = detail::Fnv1a(bytes.data() + 64, 6 * sizeof(double));
+  detail::ByteSwap(header);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  WriteBytes(path, bytes);
+  EXPECT_TRUE(LoadMatrix(path) == matrix);
+  EXPECT_THROW(S21MappedMatrix<>{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(IoTest, Test4) {
+  const std::string path = TempPath("io4");
+  S21Matrix<> matrix = Sample(20, 20);
+  SaveMatrix(matrix, path);
+  {
+    S21MappedMatrix<> mapped(path, MapMode::kReadOnly, true);
+    S21MappedMatrix<> shared(path);
+    EXPECT_EQ(mapped.GetMode(), MapMode::kReadOnly);
+    EXPECT_TRUE(mapped.Matrix().EqMatrix(matrix));
+    EXPECT_TRUE(shared.Matrix().EqMatrix(matrix));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.Matrix().Data()) %
+                  S21Matrix<>::kAlignment,
+              0);
+    EXPECT_THROW(mapped.MutableMatrix(), std::runtime_error);
+    S21Matrix<> copy = mapped.Matrix();
+    EXPECT_NEAR(copy.Determinant(), matrix.Determinant(), 1e-6);
+    EXPECT_TRUE(mapped.Matrix() * matrix == matrix * matrix);
+  }
+
+  S21MappedMatrix<> writable(path, MapMode::kCopyOnWrite);
+  writable.MutableMatrix()(2, 3) = 42.0;
+  writable.MutableMatrix().MulNumber(2.0);
+  EXPECT_DOUBLE_EQ(writable.Matrix()(2, 3), 84.0);
+  EXPECT_TRUE(LoadMatrix(path) == matrix);  // The file is untouched
+  S21MappedMatrix<> moved(std::move(writable));
+  moved.MutableMatrix().SetRows(25);  // Leaves the mapping
+  EXPECT_DOUBLE_EQ(moved.Matrix()(2, 3), 84.0);
+  EXPECT_DOUBLE_EQ(moved.Matrix()(24, 0), 0.0);
+  std::filesystem::remove(path);
+}
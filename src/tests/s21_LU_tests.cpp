@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+TEST(LUTest, Test1) {
+  // 150 spans several S21_LU_BLOCK panels plus a partial one.
+  const std::size_t n = 150;
+  S21Matrix<double> a = DiagonallyDominant(n, n);
+  a.SwapRows(0, 5);
+  LU<double> lu(a);
+  ASSERT_FALSE(lu.IsSingular());
+  const S21Matrix<double> &f = lu.GetFactors();
+  const auto &perm = lu.GetPermutation();
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      double sum = 0;
+      for (std::size_t p = 0; p <= std::min(i, j); p++)
+        sum += (p == i ? 1.0 : f(i, p)) * f(p, j);
+      ASSERT_NEAR(sum, a(perm[i], j), 1e-9);
+    }
+  }
+}
+
+TEST(LUTest, Test2) {
+  S21Matrix<double> a{3, 3};
+  a(0, 0) = 0;
+  a(0, 1) = 2;
+  a(0, 2) = 1;
+  a(1, 0) = 3;
+  a(1, 1) = 1;
+  a(1, 2) = 4;
+  a(2, 0) = 1;
+  a(2, 1) = 5;
+  a(2, 2) = 9;
+  LU<double> lu(a);
+  EXPECT_NEAR(lu.Determinant(), -32.0, 1e-12);
+  EXPECT_NEAR(a.Determinant(), -32.0, 1e-12);
+
+  S21Matrix<double> b{3, 2};
+  b(0, 0) = 3;
+  b(1, 0) = 8;
+  b(2, 0) = 15;
+  b(0, 1) = 1;
+  S21Matrix<double> x = lu.Solve(b);
+  for (std::size_t c = 0; c < 2; c++)
+    for (std::size_t i = 0; i < 3; i++) {
+      double sum = 0;
+      for (std::size_t p = 0; p < 3; p++) sum += a(i, p) * x(p, c);
+      EXPECT_NEAR(sum, b(i, c), 1e-12);
+    }
+}
+
+TEST(LUTest, Test3) {
+  const std::size_t n = 90;
+  S21Matrix<double> a = DiagonallyDominant(n, n);
+  LU<double> lu(std::move(a));
+  a = DiagonallyDominant(n, n);
+  S21Matrix<double> product = a * lu.Inverse();
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      ASSERT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-12);
+}
+
+TEST(LUTest, Test4) {
+  S21Matrix<double> a{3, 3};
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 3; j++) a(i, j) = static_cast<double>(i + j);
+  LU<double> lu(a);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_EQ(lu.Determinant(), 0.0);
+  EXPECT_THROW(lu.Inverse(), std::runtime_error);
+  EXPECT_THROW(LU<double>(S21Matrix<double>(2, 3)), std::runtime_error);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+
+#include "../s21_matrix_oop.hpp"
+
+using namespace S21;
+
+namespace {
+
+// Forwards to the global heap and counts what goes through it.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+  std::size_t live_bytes = 0;
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    allocations++;
+    live_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    live_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+S21Matrix<> Invertible(std::size_t n, std::pmr::memory_resource *resource) {
+  S21Matrix<> matrix(n, n, resource);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      matrix(i, j) = i == j ? n + 1.0 : 1.0 / (i + j + 1.0);
+  return matrix;
+}
+
+}  // namespace
+
+TEST(MemoryTest, Test1) {
+  CountingResource arena;
+  {
+    S21Matrix<> matrix(3, 4, &arena);
+    EXPECT_EQ(arena.allocations, 1);
+    EXPECT_EQ(matrix.GetResource(), &arena);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.Data()) %
+                  S21Matrix<>::kAlignment,
+              0);
+    S21Matrix<> transposed = matrix.Transpose();
+    S21Matrix<> minor = matrix.GetMinor(0, 0);
+    EXPECT_EQ(transposed.GetResource(), &arena);
+    EXPECT_EQ(minor.GetResource(), &arena);
+    EXPECT_EQ(arena.allocations, 3);
+
+    S21Matrix<> copy(matrix);
+    EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+    copy = minor;  // Assignment keeps the target's resource
+    EXPECT_EQ(copy.GetResource(), std::pmr::get_default_resource());
+    minor = matrix;
+    EXPECT_EQ(minor.GetResource(), &arena);
+    S21Matrix<> moved(std::move(matrix));
+    EXPECT_EQ(moved.GetResource(), &arena);
+  }
+  EXPECT_EQ(arena.live_bytes, 0);
+}
+
+TEST(MemoryTest, Test2) {
+  alignas(64) unsigned char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  S21Matrix<> a = Invertible(4, &arena);
+  S21Matrix<> b(4, 4, &arena);
+  b = a * 2.0 + a;  // Same shape: evaluated in place
+  S21Matrix<> c(a - b, &arena);
+  S21Matrix<> inverse = a.InverseMatrix();
+  S21Matrix<> product = a * inverse;
+  S21Matrix<> complements = a.CalcComplements();
+  EXPECT_EQ(product.GetResource(), &arena);
+  EXPECT_EQ(complements.GetResource(), &arena);
+  for (std::size_t i = 0; i < 4; i++)
+    for (std::size_t j = 0; j < 4; j++)
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-12);
+  EXPECT_DOUBLE_EQ(c(1, 2), -2.0 * a(1, 2));
+}
+
+TEST(MemoryTest, Test3) {
+  // Internal temporaries come from the scratch pool, not from the default
+  // resource.
+  CountingResource arena, fallback;
+  std::pmr::memory_resource *previous =
+      std::pmr::set_default_resource(&fallback);
+  {
+    S21Matrix<> matrix = Invertible(20, &arena);
+    S21Matrix<> singular(20, 20, &arena);
+    singular(0, 0) = 1.0;
+    const double det = matrix.Determinant();
+    S21Matrix<> complements = matrix.CalcComplements();
+    S21Matrix<> singular_complements = singular.CalcComplements();
+    S21Matrix<> product = (matrix + matrix) * (matrix - matrix);
+    EXPECT_GT(det, 0.0);
+    EXPECT_EQ(complements.GetResource(), &arena);
+    EXPECT_EQ(singular_complements.GetResource(), &arena);
+  }
+  std::pmr::set_default_resource(previous);
+  EXPECT_EQ(fallback.allocations, 1);  // Only the product of expressions
+  EXPECT_EQ(arena.live_bytes, 0);
+  ReleaseScratch();
+}
+
+TEST(MemoryTest, Test4) {
+  std::pmr::memory_resource *other = nullptr;
+  std::thread([&] { other = ScratchResource(); }).join();
+  EXPECT_NE(ScratchResource(), other);
+  S21Matrix<> matrix(8, 8, ScratchResource());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.Data()) %
+                S21Matrix<>::kAlignment,
+            0);
+}
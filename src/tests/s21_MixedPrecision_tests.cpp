@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+// A well-conditioned matrix that still needs row interchanges.
+S21Matrix<> System(std::size_t n) {
+  S21Matrix<> a = Sample(n, n, 1.0);
+  for (std::size_t i = 0; i < n; i++) a(i, (i * 7 + 3) % n) += 2.0 * n;
+  return a;
+}
+
+// A scaled Hilbert matrix, with a condition number near 1e10.
+S21Matrix<> Hilbert(std::size_t n) {
+  S21Matrix<> a(n, n);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++) a(i, j) = 1e6 / (i + j + 1.0);
+  return a;
+}
+
+// Largest element of |A * X - B| relative to the largest of |B|.
+double Residual(const S21Matrix<> &a, const S21Matrix<> &x,
+                const S21Matrix<> &b) {
+  const S21Matrix<> r = a * x - b;
+  double result = 0, scale = 0;
+  for (std::size_t i = 0; i < r.GetRows(); i++) {
+    for (std::size_t j = 0; j < r.GetCols(); j++) {
+      result = std::max(result, std::abs(r(i, j)));
+      scale = std::max(scale, std::abs(b(i, j)));
+    }
+  }
+  return result / scale;
+}
+
+}  // namespace
+
+TEST(MixedPrecisionTest, Test1) {
+  const S21Matrix<> a = Sample(5, 7, 1.0);
+  S21Matrix<float> single(a);
+  EXPECT_EQ(single.GetRows(), 5);
+  EXPECT_EQ(single.GetCols(), 7);
+  EXPECT_FLOAT_EQ(single(4, 6), static_cast<float>(a(4, 6)));
+  const S21Matrix<> back(single);
+  EXPECT_NEAR(back(2, 3), a(2, 3), 1e-7);
+  EXPECT_NE(back(2, 3), a(2, 3));
+
+  // Out of the range of float.
+  S21Matrix<> huge(1, 2);
+  huge(0, 0) = 1e300;
+  huge(0, 1) = -1e300;
+  EXPECT_EQ(S21Matrix<float>(huge)(0, 0),
+            std::numeric_limits<float>::infinity());
+  EXPECT_EQ(S21Matrix<float>(huge)(0, 1),
+            -std::numeric_limits<float>::infinity());
+
+  const S21Vector<float> v{1.5f, -2.25f};
+  const S21Vector<> w(v);
+  EXPECT_DOUBLE_EQ(w[1], -2.25);
+  EXPECT_EQ(S21Vector<float>(w).GetSize(), 2);
+}
+
+TEST(MixedPrecisionTest, Test2) {
+  // Large enough for several panels of the blocked factorization.
+  const S21Matrix<> a = System(200), b = Sample(200, 3, 2.0);
+  const RefinementResult<double> result = SolveMixedPrecision(a, b);
+  EXPECT_FALSE(result.fell_back);
+  EXPECT_GT(result.iterations, 0);
+  EXPECT_LT(Residual(a, result.solution, b), 1e-14);
+  const S21Matrix<> x = Solve(a, b);
+  for (std::size_t i = 0; i < 200; i++)
+    for (std::size_t j = 0; j < 3; j++)
+      EXPECT_NEAR(result.solution(i, j), x(i, j), 1e-14);
+
+  // Expressions and blocks.
+  const S21Matrix<> c = System(100);
+  const RefinementResult<double> block =
+      SolveMixedPrecision(c * 2.0, b.Block(0, 1, 100, 1));
+  EXPECT_FALSE(block.fell_back);
+  EXPECT_EQ(block.solution.GetCols(), 1);
+  EXPECT_LT(Residual(c * 2.0, block.solution, b.Block(0, 1, 100, 1)), 1e-13);
+
+  // Two steps are needed here, so a limit of one falls back.
+  ASSERT_EQ(result.iterations, 2);
+  RefinementOptions options;
+  options.max_iterations = 1;
+  const RefinementResult<double> limited = SolveMixedPrecision(a, b, options);
+  EXPECT_TRUE(limited.fell_back);
+  EXPECT_EQ(limited.iterations, 1);
+  EXPECT_TRUE(limited.solution.EqMatrix(x));
+}
+
+TEST(MixedPrecisionTest, Test3) {
+  // Too ill-conditioned for float: refinement diverges and double takes
+  // over.
+  const S21Matrix<> a = Hilbert(8), b = Sample(8, 2, 3.0);
+  const RefinementResult<double> result = SolveMixedPrecision(a, b);
+  EXPECT_TRUE(result.fell_back);
+  EXPECT_LT(Residual(a, result.solution, b), 1e-9);
+
+  // Out of the range of float.
+  S21Matrix<> huge = System(10);
+  huge *= 1e40;
+  const RefinementResult<double> scaled =
+      SolveMixedPrecision(huge, Sample(10, 1, 4.0));
+  EXPECT_TRUE(scaled.fell_back);
+  EXPECT_EQ(scaled.iterations, 0);
+  EXPECT_LT(Residual(huge, scaled.solution, Sample(10, 1, 4.0)), 1e-14);
+
+  S21Matrix<> singular = Sample(4, 4, 5.0);
+  for (std::size_t j = 0; j < 4; j++) singular(3, j) = singular(0, j);
+  EXPECT_THROW(SolveMixedPrecision(singular, Sample(4, 1, 4.0)),
+               std::runtime_error);
+  EXPECT_THROW(SolveMixedPrecision(a, Sample(7, 1, 4.0)), std::runtime_error);
+  EXPECT_THROW(SolveMixedPrecision(Sample(3, 4, 1.0), Sample(3, 1, 1.0)),
+               std::runtime_error);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <string>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+std::string TempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() /
+          ("s21_" + name + "_" + std::to_string(getpid()) + ".bin"))
+      .string();
+}
+
+}  // namespace
+
+TEST(OutOfCoreTest, Test1) {
+  const std::string a_path = TempPath("ooc_a"), b_path = TempPath("ooc_b");
+  const std::string c_path = TempPath("ooc_c");
+  S21Matrix<> a = Sample(150, 130, 1.0), b = Sample(130, 170, 2.0);
+  SaveMatrix(a, a_path);
+  SaveMatrix(b, b_path);
+  S21Matrix<> expected = a * b;
+
+  OutOfCoreOptions options;
+  options.tile = 32;  // Edge tiles on every side
+  MulMatrixFiles(a_path, b_path, c_path, options);
+  EXPECT_LT(Distance(LoadMatrix(c_path), expected), 1e-12);
+
+  options.tile = 0;
+  options.memory_budget = 6 * 64 * 64 * sizeof(double);
+  MulMatrixFiles(a_path, b_path, c_path, options);
+  EXPECT_LT(Distance(LoadMatrix(c_path), expected), 1e-12);
+
+  MulMatrixFiles(a_path, b_path, c_path);  // One tile per operand
+  S21MappedMatrix<> mapped(c_path);
+  EXPECT_TRUE(mapped.Matrix().EqMatrix(expected));
+  for (const std::string &path : {a_path, b_path, c_path})
+    std::filesystem::remove(path);
+}
+
+TEST(OutOfCoreTest, Test2) {
+  const std::string a_path = TempPath("ooc_d"), c_path = TempPath("ooc_e");
+  SaveMatrix(Sample(10, 20, 0.0), a_path);
+  EXPECT_THROW(MulMatrixFiles(a_path, a_path, c_path), std::runtime_error);
+  EXPECT_THROW(MulMatrixFiles(a_path, TempPath("missing"), c_path),
+               std::runtime_error);
+  EXPECT_THROW(MulMatrixFiles<float>(a_path, a_path, c_path),
+               std::runtime_error);
+  OutOfCoreOptions options;
+  options.memory_budget = 16;
+  SaveMatrix(Sample(20, 10, 0.0), c_path);
+  EXPECT_THROW(MulMatrixFiles(a_path, c_path, TempPath("ooc_f"), options),
+               std::runtime_error);
+  std::filesystem::remove(a_path);
+  std::filesystem::remove(c_path);
+}
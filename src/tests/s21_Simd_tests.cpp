@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+
+using namespace S21;
+
+namespace {
+
+// Every instruction set the running CPU can execute.
+std::vector<simd::Isa> SupportedIsas() {
+  std::vector<simd::Isa> isas;
+  for (simd::Isa isa : {simd::Isa::kScalar, simd::Isa::kSse2,
+                        simd::Isa::kAvx2, simd::Isa::kAvx512}) {
+    if (isa <= simd::DetectIsa()) isas.push_back(isa);
+  }
+  return isas;
+}
+
+// Runs the kernels on every length up to 150, which covers empty inputs,
+// pure tails and several full vectors for all widths, against plain loops.
+template <typename T>
+void CheckKernels() {
+  for (simd::Isa isa : SupportedIsas()) {
+    simd::ForceIsa(isa);
+    SCOPED_TRACE(simd::IsaName(isa));
+    for (std::size_t count = 0; count <= 150; count++) {
+      std::vector<T> lhs(count), rhs(count);
+      for (std::size_t i = 0; i < count; i++) {
+        lhs[i] = static_cast<T>(i % 7 + 1);
+        rhs[i] = static_cast<T>(i % 5);
+      }
+      std::vector<T> sum = lhs, diff = lhs, scaled = lhs, axpy = lhs;
+      simd::Add(sum.data(), rhs.data(), count);
+      simd::Sub(diff.data(), rhs.data(), count);
+      simd::Scale(scaled.data(), T(3), count);
+      simd::Axpy(axpy.data(), T(2), rhs.data(), count);
+      T dot = T(0);
+      for (std::size_t i = 0; i < count; i++) {
+        ASSERT_EQ(sum[i], static_cast<T>(lhs[i] + rhs[i]));
+        ASSERT_EQ(diff[i], static_cast<T>(lhs[i] - rhs[i]));
+        ASSERT_EQ(scaled[i], static_cast<T>(lhs[i] * T(3)));
+        ASSERT_EQ(axpy[i], static_cast<T>(lhs[i] + T(2) * rhs[i]));
+        dot = static_cast<T>(dot + lhs[i] * rhs[i]);
+      }
+      ASSERT_EQ(simd::Dot(lhs.data(), rhs.data(), count), dot);
+      ASSERT_TRUE(simd::Equal(lhs.data(), lhs.data(), count, T(0)));
+      for (std::size_t i = 0; i < count; i += 13) {
+        std::vector<T> other = lhs;
+        other[i] = static_cast<T>(other[i] + 1);
+        ASSERT_FALSE(simd::Equal(lhs.data(), other.data(), count, T(0)));
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// Returns to the default instruction set even when an assertion fails.
+class SimdTest : public ::testing::Test {
+ protected:
+  void TearDown() override { simd::ResetIsa(); }
+};
+
+TEST_F(SimdTest, Test1) {
+  CheckKernels<double>();
+  CheckKernels<float>();
+}
+
+TEST_F(SimdTest, Test2) {
+  CheckKernels<int>();
+  CheckKernels<long long>();
+  CheckKernels<unsigned>();
+  CheckKernels<short>();
+}
+
+TEST_F(SimdTest, Test3) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> lhs(100, 1.0), rhs(100, 1.0 + EPSILON / 2);
+  for (simd::Isa isa : SupportedIsas()) {
+    simd::ForceIsa(isa);
+    SCOPED_TRACE(simd::IsaName(isa));
+    ASSERT_TRUE(simd::Equal(lhs.data(), rhs.data(), 100, EPSILON));
+    rhs[70] = 1.0 + 2 * EPSILON;
+    ASSERT_FALSE(simd::Equal(lhs.data(), rhs.data(), 100, EPSILON));
+    rhs[70] = nan;
+    ASSERT_FALSE(simd::Equal(lhs.data(), rhs.data(), 100, EPSILON));
+    lhs[70] = nan;
+    ASSERT_FALSE(simd::Equal(lhs.data(), rhs.data(), 100, EPSILON));
+    lhs[70] = rhs[70] = 1.0;
+  }
+}
+
+TEST_F(SimdTest, Test4) {
+  for (simd::Isa isa : SupportedIsas()) {
+    simd::ForceIsa(isa);
+    SCOPED_TRACE(simd::IsaName(isa));
+    S21Matrix<float> a(9, 7), b(9, 7);
+    for (std::size_t i = 0; i < 9; i++) {
+      for (std::size_t j = 0; j < 7; j++) {
+        a[i][j] = static_cast<float>(i) * 0.5f - static_cast<float>(j);
+        b[i][j] = static_cast<float>(i * j) * 0.25f;
+      }
+    }
+    S21Matrix<float> sum(a);
+    sum.SumMatrix(b);
+    sum.SubMatrix(b);
+    EXPECT_TRUE(sum.EqMatrix(a));
+    sum.MulNumber(2.0f);
+    for (std::size_t i = 0; i < 9; i++)
+      for (std::size_t j = 0; j < 7; j++) ASSERT_EQ(sum(i, j), 2.0f * a(i, j));
+    EXPECT_FALSE(sum.EqMatrix(a));
+  }
+}
+
+TEST_F(SimdTest, Test5) {
+  EXPECT_EQ(simd::GetIsa(), simd::detail::DefaultIsa());
+  if (simd::DetectIsa() != simd::Isa::kAvx512) {
+    EXPECT_THROW(simd::ForceIsa(simd::Isa::kAvx512), std::runtime_error);
+  }
+  simd::Isa isa = simd::Isa::kScalar;
+  EXPECT_TRUE(simd::detail::ParseIsa("avx2", isa));
+  EXPECT_EQ(isa, simd::Isa::kAvx2);
+  EXPECT_FALSE(simd::detail::ParseIsa("neon", isa));
+  EXPECT_FALSE(simd::detail::ParseIsa(nullptr, isa));
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+// A well-conditioned matrix that still needs row interchanges.
+S21Matrix<> System(std::size_t n) {
+  S21Matrix<> a = Sample(n, n, 1.0);
+  for (std::size_t i = 0; i < n; i++) a(i, (i * 7 + 3) % n) += 2.0 * n;
+  return a;
+}
+
+// Largest element of |A * X - B|.
+double Residual(const S21Matrix<> &a, const S21Matrix<> &x,
+                const S21Matrix<> &b) {
+  const S21Matrix<> r = a * x - b;
+  double result = 0;
+  for (std::size_t i = 0; i < r.GetRows(); i++)
+    for (std::size_t j = 0; j < r.GetCols(); j++)
+      result = std::max(result, std::abs(r(i, j)));
+  return result;
+}
+
+}  // namespace
+
+TEST(SolveTest, Test1) {
+  // 150 spans several S21_TRSM_BLOCK blocks plus a partial one.
+  const S21Matrix<> a = System(150), b = Sample(150, 37, 2.0);
+  S21Matrix<> x = Solve(a, b);
+  EXPECT_EQ(x.GetRows(), 150);
+  EXPECT_EQ(x.GetCols(), 37);
+  EXPECT_LT(Residual(a, x, b), 1e-12);
+  EXPECT_TRUE(Solve(a * 1.0, b.Block(0, 0, 150, 37)) == x);
+
+  S21Vector<> v(150);
+  for (std::size_t i = 0; i < 150; i++) v[i] = b(i, 5);
+  S21Vector<> y = Solve(a, v);
+  for (std::size_t i = 0; i < 150; i++) EXPECT_NEAR(y[i], x(i, 5), 1e-12);
+
+  S21Matrix<> singular = Sample(4, 4, 3.0);
+  for (std::size_t j = 0; j < 4; j++) singular(3, j) = singular(0, j);
+  EXPECT_THROW(Solve(singular, Sample(4, 1, 4.0)), std::runtime_error);
+  EXPECT_THROW(Solve(a, Sample(149, 2, 4.0)), std::runtime_error);
+  EXPECT_THROW(Solve(Sample(3, 4, 4.0), Sample(3, 1, 4.0)), std::runtime_error);
+}
+
+TEST(SolveTest, Test2) {
+  const std::size_t n = 200;
+  // Small off-diagonal elements keep the triangles well conditioned.
+  S21Matrix<> lower = Sample(n, n, 3.0) * (1.0 / n);
+  S21Matrix<> upper = Sample(n, n, 4.0) * (1.0 / n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      if (j > i) lower(i, j) = 0.0;
+      if (j < i) upper(i, j) = 0.0;
+    }
+    lower(i, i) = 1.0 + i % 3;
+    upper(i, i) = -1.0 - i % 5;
+  }
+  S21Matrix<> unit = lower;
+  for (std::size_t i = 0; i < n; i++) unit(i, i) = 1.0;
+
+  // Many right-hand sides are split across threads, one is a dot per row.
+  for (std::size_t m : {300, 1}) {
+    const S21Matrix<> b = Sample(n, m, 5.0);
+    S21Matrix<> x = b, y = b, z = b;
+    const ScopedThreadCount threads(3);
+    TriangularSolve(Triangle::kLower, Diagonal::kNonUnit, lower, x);
+    TriangularSolve(Triangle::kUpper, Diagonal::kNonUnit, upper, y);
+    TriangularSolve(Triangle::kLower, Diagonal::kUnit, lower, z);
+    EXPECT_LT(Residual(lower, x, b), 1e-9);
+    EXPECT_LT(Residual(upper, y, b), 1e-9);
+    EXPECT_LT(Residual(unit, z, b), 1e-9);
+  }
+
+  // A block of a matrix solved in place against another block of it.
+  S21Matrix<> c = upper;
+  TriangularSolve<double>(Triangle::kUpper, Diagonal::kNonUnit,
+                          c.Block(0, 0, 50, 50), c.Block(0, 50, 50, 150));
+  EXPECT_LT(Residual(S21Matrix<>(upper.Block(0, 0, 50, 50)),
+                     S21Matrix<>(c.Block(0, 50, 50, 150)),
+                     S21Matrix<>(upper.Block(0, 50, 50, 150))),
+            1e-9);
+  EXPECT_THROW(TriangularSolve<double>(Triangle::kLower, Diagonal::kUnit,
+                                       c.Block(0, 0, 50, 50),
+                                       c.Block(10, 10, 50, 5)),
+               std::runtime_error);
+  lower(7, 7) = 0.0;
+  S21Matrix<> b = Sample(n, 2, 6.0);
+  EXPECT_THROW(TriangularSolve(Triangle::kLower, Diagonal::kNonUnit, lower, b),
+               std::runtime_error);
+  EXPECT_NO_THROW(
+      TriangularSolve(Triangle::kLower, Diagonal::kUnit, lower, b));
+}
+
+TEST(SolveTest, Test3) {
+  // One factorization applied to a stream of right-hand sides.
+  const S21Matrix<> a = System(90);
+  const LU<> lu(a);
+  S21Matrix<> x(90, 4);
+  S21Vector<> v(90), y(90);
+  for (int step = 0; step < 3; step++) {
+    const S21Matrix<> b = Sample(90, 4, step);
+    lu.Solve(b, x);
+    EXPECT_LT(Residual(a, x, b), 1e-12);
+    EXPECT_TRUE(Solve(lu, b) == x);
+    for (std::size_t i = 0; i < 90; i++) v[i] = b(i, 0);
+    lu.Solve(v, y);
+    for (std::size_t i = 0; i < 90; i++) EXPECT_NEAR(y[i], x(i, 0), 1e-12);
+  }
+  EXPECT_TRUE(Solve(lu, v).EqVector(y));
+  EXPECT_THROW(lu.Solve(v, v), std::runtime_error);
+  EXPECT_THROW(lu.Solve(x, x), std::runtime_error);
+  S21Matrix<> narrow(90, 3);
+  EXPECT_THROW(lu.Solve(x, narrow), std::runtime_error);
+
+  const S21Matrix<float> af = Sample<float>(3, 3, 7.0);
+  S21Matrix<float> id(3, 3);
+  for (std::size_t i = 0; i < 3; i++) id(i, i) = 1.0f;
+  S21Matrix<float> inv = Solve(af * 0.1f + id, id);
+  S21Matrix<float> check = (af * 0.1f + id) * inv;
+  for (std::size_t i = 0; i < 3; i++)
+    for (std::size_t j = 0; j < 3; j++)
+      EXPECT_NEAR(check(i, j), i == j ? 1.0f : 0.0f, 1e-5f);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+using Triplet = S21SparseMatrix<>::Triplet;
+
+// About `per_row` nonzeros per row at pseudo-random columns.
+S21Matrix<> SparseDense(std::size_t rows, std::size_t cols,
+                        std::size_t per_row, std::size_t seed) {
+  S21Matrix<> matrix(rows, cols);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t k = 0; k < per_row; k++)
+      matrix(i, (i * 7 + k * 13 + seed) * 31 % cols) +=
+          ((i + k + seed) % 9) - 4.0;
+  return matrix;
+}
+
+}  // namespace
+
+TEST(SparseTest, Test1) {
+  std::vector<Triplet> triplets = {
+      {2, 1, 3.0}, {0, 3, 1.0}, {2, 1, -1.0}, {1, 0, 4.0}, {0, 0, 5.0}};
+  for (SparseLayout layout : {SparseLayout::kCsr, SparseLayout::kCsc}) {
+    S21SparseMatrix<> sparse(3, 4, triplets, layout);
+    EXPECT_EQ(sparse.GetLayout(), layout);
+    EXPECT_EQ(sparse.GetNonZeros(), 4);  // Duplicates are summed
+    EXPECT_DOUBLE_EQ(sparse.Coeff(2, 1), 2.0);
+    EXPECT_DOUBLE_EQ(sparse.Coeff(0, 3), 1.0);
+    EXPECT_DOUBLE_EQ(sparse.Coeff(1, 1), 0.0);
+    S21Matrix<> dense = sparse.ToDense();
+    EXPECT_DOUBLE_EQ(dense(0, 0), 5.0);
+    EXPECT_DOUBLE_EQ(dense(1, 0), 4.0);
+    EXPECT_DOUBLE_EQ(dense(2, 3), 0.0);
+    EXPECT_THROW(sparse.Coeff(3, 0), std::out_of_range);
+  }
+  S21SparseMatrix<> csr(3, 4, triplets);
+  EXPECT_EQ(std::vector<std::size_t>(csr.Offsets().begin(),
+                                     csr.Offsets().end()),
+            std::vector<std::size_t>({0, 2, 3, 4}));
+  EXPECT_EQ(std::vector<std::size_t>(csr.Indices().begin(),
+                                     csr.Indices().end()),
+            std::vector<std::size_t>({0, 3, 0, 1}));
+  triplets.push_back({3, 0, 1.0});
+  EXPECT_THROW(S21SparseMatrix<>(3, 4, triplets), std::out_of_range);
+}
+
+TEST(SparseTest, Test2) {
+  S21Matrix<> dense = SparseDense(40, 30, 3, 1);
+  dense(5, 5) = 1e-9;
+  S21SparseMatrix<> all(dense);
+  S21SparseMatrix<> thresholded(dense, 1e-6, SparseLayout::kCsc);
+  EXPECT_EQ(all.GetNonZeros(), thresholded.GetNonZeros() + 1);
+  EXPECT_DOUBLE_EQ(thresholded.Coeff(5, 5), 0.0);
+  dense(5, 5) = 0.0;
+  EXPECT_TRUE(thresholded.ToDense() == dense);
+  EXPECT_TRUE(thresholded.ToLayout(SparseLayout::kCsr).ToDense() == dense);
+  EXPECT_EQ(thresholded.ToLayout(SparseLayout::kCsr).GetLayout(),
+            SparseLayout::kCsr);
+  S21SparseMatrix<> transposed = thresholded.Transpose();
+  EXPECT_EQ(transposed.GetRows(), 30);
+  EXPECT_EQ(transposed.GetLayout(), SparseLayout::kCsc);
+  EXPECT_TRUE(transposed.ToDense() == dense.Transpose());
+  dense(5, 5) = 1e-9;  // Kept by the unthresholded copy
+  EXPECT_TRUE(all.Transpose().ToDense() == dense.Transpose());
+}
+
+TEST(SparseTest, Test3) {
+  const ScopedThreadCount threads(4);
+  for (std::size_t n : {50, 2000}) {  // The larger one runs in parallel
+    S21Matrix<> dense = SparseDense(n, n + 3, 70, n);
+    std::vector<double> x(n + 3);
+    S21Matrix<> column(n + 3, 1);
+    for (std::size_t j = 0; j < n + 3; j++) column(j, 0) = x[j] = j % 5 - 2.0;
+    S21Matrix<> expected = dense * column;
+    for (SparseLayout layout : {SparseLayout::kCsr, SparseLayout::kCsc}) {
+      std::vector<double> y = S21SparseMatrix<>(dense, 0.0, layout)
+                                  .MulVector(x);
+      ASSERT_EQ(y.size(), n);
+      for (std::size_t i = 0; i < n; i++)
+        EXPECT_NEAR(y[i], expected(i, 0), 1e-9);
+    }
+  }
+  S21SparseMatrix<> sparse(3, 4);
+  EXPECT_THROW(sparse.MulVector(std::vector<double>(3)), std::runtime_error);
+}
+
+TEST(SparseTest, Test4) {
+  const ScopedThreadCount threads(3);
+  S21Matrix<> a = SparseDense(300, 200, 8, 2);
+  S21Matrix<> b = SparseDense(200, 250, 8, 5);
+  S21Matrix<> expected = a * b;
+  for (SparseLayout left : {SparseLayout::kCsr, SparseLayout::kCsc}) {
+    S21SparseMatrix<> sparse_a(a, 0.0, left);
+    EXPECT_TRUE(sparse_a * b == expected);
+    for (SparseLayout right : {SparseLayout::kCsr, SparseLayout::kCsc}) {
+      S21SparseMatrix<> product = sparse_a * S21SparseMatrix<>(b, 0.0, right);
+      EXPECT_EQ(product.GetLayout(), left);
+      EXPECT_TRUE(product.ToDense() == expected);
+      EXPECT_EQ(product.GetNonZeros(),
+                S21SparseMatrix<>(expected).GetNonZeros());
+    }
+  }
+  EXPECT_THROW(S21SparseMatrix<>(a) * S21SparseMatrix<>(a),
+               std::runtime_error);
+  EXPECT_THROW(S21SparseMatrix<>(a) * a, std::runtime_error);
+}
+
+TEST(SparseTest, Test5) {
+  S21Matrix<> a = SparseDense(20, 25, 4, 3);
+  S21Matrix<> b = SparseDense(20, 25, 4, 8);
+  S21SparseMatrix<> sum = S21SparseMatrix<>(a) + S21SparseMatrix<>(b);
+  S21SparseMatrix<> difference =
+      S21SparseMatrix<>(a) - S21SparseMatrix<>(b, 0.0, SparseLayout::kCsc);
+  difference.MulNumber(2.0);
+  EXPECT_TRUE(sum.ToDense() == a + b);
+  EXPECT_TRUE(difference.ToDense() == (a - b) * 2.0);
+  S21SparseMatrix<> zero(a);
+  zero.SubMatrix(S21SparseMatrix<>(a));
+  EXPECT_EQ(zero.GetNonZeros(), S21SparseMatrix<>(a).GetNonZeros());
+  EXPECT_TRUE(zero.ToDense() == S21Matrix<>(20, 25));
+  EXPECT_THROW(sum.SumMatrix(S21SparseMatrix<>(25, 20)), std::runtime_error);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+// Largest difference relative to the largest element of the reference.
+template <typename T>
+double RelativeError(const S21Matrix<T> &result, const S21Matrix<T> &expected) {
+  double error = 0, scale = 0;
+  for (std::size_t i = 0; i < expected.GetRows(); i++) {
+    for (std::size_t j = 0; j < expected.GetCols(); j++) {
+      error = std::max(error, std::abs(double(result(i, j) - expected(i, j))));
+      scale = std::max(scale, std::abs(double(expected(i, j))));
+    }
+  }
+  return error / scale;
+}
+
+}  // namespace
+
+TEST(StrassenTest, Test1) {
+  // Odd and uneven dimensions peel a row, a column or an inner index at
+  // different levels of recursion.
+  StrassenOptions options;
+  options.crossover = 8;
+  const std::size_t shapes[][3] = {{64, 64, 64},  {37, 53, 41}, {50, 33, 71},
+                                   {9, 120, 17},  {16, 16, 16}, {100, 7, 90},
+                                   {127, 127, 127}};
+  for (const auto &shape : shapes) {
+    S21Matrix<> a = Sample(shape[0], shape[1], 1.0);
+    S21Matrix<> b = Sample(shape[1], shape[2], 2.0);
+    S21Matrix<> c = MulMatrixStrassen(a, b, options);
+    EXPECT_EQ(c.GetRows(), shape[0]);
+    EXPECT_EQ(c.GetCols(), shape[2]);
+    EXPECT_LT(RelativeError(c, a * b), 1e-12);
+  }
+
+  S21Matrix<float> af = Sample<float>(70, 70, 3.0);
+  S21Matrix<float> bf = Sample<float>(70, 70, 4.0);
+  EXPECT_LT(RelativeError(MulMatrixStrassen(af, bf, options), af * bf), 1e-4);
+}
+
+TEST(StrassenTest, Test2) {
+  // The first level runs its seven products in parallel.
+  StrassenOptions options;
+  options.crossover = 16;
+  S21Matrix<> a = Sample(131, 98, 5.0), b = Sample(98, 103, 6.0);
+  const ScopedThreadCount threads(4);
+  S21Matrix<> c = MulMatrixStrassen(a, b, options);
+  EXPECT_LT(RelativeError(c, a * b), 1e-12);
+}
+
+TEST(StrassenTest, Test3) {
+  // Below the crossover the classical kernel gives the same result.
+  std::pmr::monotonic_buffer_resource arena;
+  S21Matrix<> a(Sample(30, 40, 7.0), &arena), b = Sample(40, 20, 8.0);
+  S21Matrix<> c = MulMatrixStrassen(a, b);
+  EXPECT_EQ(c.GetResource(), &arena);
+  EXPECT_TRUE(c == a * b);
+  EXPECT_EQ(MulMatrixStrassen(S21Matrix<>(3, 0), S21Matrix<>(0, 4))(2, 3), 0);
+  EXPECT_THROW(MulMatrixStrassen(a, a), std::runtime_error);
+}
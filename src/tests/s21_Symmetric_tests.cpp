@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+// A symmetric matrix with the given diagonal shift; positive definite for a
+// large shift, indefinite with tiny diagonal for a zero one.
+S21Matrix<> Symmetric(std::size_t n, double shift) {
+  const S21Matrix<> a = Sample(n, n, 1.0);
+  S21Matrix<> result(n, n);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++)
+      result(i, j) = i == j ? shift : 0.5 * (a(i, j) + a(j, i));
+  return result;
+}
+
+// Overwrites the strictly upper triangle, which must not be read.
+S21Matrix<> Lower(S21Matrix<> a) {
+  for (std::size_t i = 0; i < a.GetRows(); i++)
+    for (std::size_t j = i + 1; j < a.GetCols(); j++) a(i, j) = 1e6;
+  return a;
+}
+
+}  // namespace
+
+TEST(SymmetricTest, Test1) {
+  // 150 spans several S21_CHOLESKY_BLOCK panels plus a partial one.
+  const S21Matrix<> a = Symmetric(150, 150.0);
+  Cholesky<> cholesky(Lower(a));
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  EXPECT_EQ(cholesky.GetSize(), 150);
+  const S21Matrix<> l = cholesky.GetL();
+  EXPECT_DOUBLE_EQ(l(3, 4), 0.0);
+  EXPECT_LT(Distance(l * l.Transpose(), a), 1e-10);
+  // det(A) overflows; det(A / 150) does not.
+  EXPECT_NEAR(cholesky.LogDeterminant() - 150.0 * std::log(150.0),
+              std::log(LU<>(a * (1.0 / 150.0)).Determinant()), 1e-9);
+  EXPECT_THROW(cholesky.Determinant(), std::overflow_error);
+
+  const S21Matrix<> b = Sample(150, 37, 2.0);
+  const S21Matrix<> x = cholesky.Solve(b);
+  EXPECT_LT(Distance(a * x, b), 1e-12);
+  EXPECT_LT(Distance(cholesky.Inverse(), S21Matrix<>(a).InverseMatrix()),
+            1e-12);
+  S21Vector<> v(150);
+  for (std::size_t i = 0; i < 150; i++) v[i] = b(i, 5);
+  const S21Vector<> y = cholesky.Solve(v);
+  for (std::size_t i = 0; i < 150; i++) EXPECT_NEAR(y[i], x(i, 5), 1e-12);
+
+  const S21Matrix<> small = Symmetric(3, 2.0);
+  EXPECT_NEAR(Cholesky<>(small).Determinant(), LU<>(small).Determinant(),
+              1e-12);
+  EXPECT_NEAR(Cholesky<>(small.Block(0, 0, 2, 2)).Determinant(),
+              small(0, 0) * small(1, 1) - small(0, 1) * small(1, 0), 1e-12);
+}
+
+TEST(SymmetricTest, Test2) {
+  // A zero diagonal forces interchanges and blocks of order two.
+  const S21Matrix<> a = Symmetric(97, 0.0);
+  LDLT<> ldlt(Lower(a));
+  ASSERT_FALSE(ldlt.IsSingular());
+  const S21Matrix<> l = ldlt.GetL(), d = ldlt.GetD();
+  bool two = false;
+  for (std::size_t k = 0; k + 1 < 97; k++) two = two || d(k + 1, k) != 0.0;
+  EXPECT_TRUE(two);
+  const std::vector<std::size_t> &p = ldlt.GetPermutation();
+  S21Matrix<> permuted(97, 97);
+  for (std::size_t i = 0; i < 97; i++)
+    for (std::size_t j = 0; j < 97; j++) permuted(i, j) = a(p[i], p[j]);
+  EXPECT_LT(Distance(l * d * l.Transpose(), permuted), 1e-12);
+
+  const double det = LU<>(a).Determinant();
+  EXPECT_NEAR(ldlt.LogAbsDeterminant(), std::log(std::abs(det)), 1e-9);
+  EXPECT_EQ(ldlt.DeterminantSign(), det < 0 ? -1 : 1);
+  const S21Matrix<> b = Sample(97, 5, 3.0);
+  EXPECT_LT(Distance(a * ldlt.Solve(b), b), 1e-10);
+  EXPECT_LT(Distance(ldlt.Inverse(), S21Matrix<>(a).InverseMatrix()), 1e-10);
+
+  // A positive definite matrix is not positive definite once negated.
+  const S21Matrix<> spd = Symmetric(20, 20.0);
+  EXPECT_FALSE(Cholesky<>(spd * -1.0).IsPositiveDefinite());
+  const S21Matrix<> rhs = Sample(20, 1, 1.0);
+  EXPECT_THROW(Cholesky<>(spd * -1.0).Solve(rhs), std::runtime_error);
+  EXPECT_THROW(Cholesky<>(spd * -1.0).GetL(), std::runtime_error);
+  LDLT<> negated(spd * -1.0);
+  EXPECT_EQ(negated.DeterminantSign(), 1);
+  EXPECT_NEAR(negated.Determinant(), LU<>(spd * -1.0).Determinant(), 1e-6);
+}
+
+TEST(SymmetricTest, Test3) {
+  // Large enough to run the panel and trailing updates on several threads.
+  const S21Matrix<> spd = Symmetric(300, 300.0), a = Symmetric(300, 0.0);
+  const S21Matrix<> b = Sample(300, 200, 4.0);
+  const Cholesky<> serial_cholesky(spd);
+  const LDLT<> serial_ldlt(a);
+  const ScopedThreadCount threads(3);
+  const Cholesky<> cholesky(spd);
+  const LDLT<> ldlt(a);
+  const S21Matrix<> x = cholesky.Solve(b), y = ldlt.Solve(b);
+  EXPECT_LT(Distance(cholesky.GetL(), serial_cholesky.GetL()), 1e-13);
+  EXPECT_LT(Distance(ldlt.GetL(), serial_ldlt.GetL()), 1e-13);
+  EXPECT_LT(Distance(spd * x, b), 1e-12);
+  EXPECT_LT(Distance(a * y, b), 1e-9);
+
+  S21Matrix<> singular = Symmetric(4, 1.0);
+  for (std::size_t j = 0; j < 4; j++) singular(3, j) = singular(j, 3) = 0.0;
+  LDLT<> ldlt_singular(singular);
+  EXPECT_TRUE(ldlt_singular.IsSingular());
+  EXPECT_DOUBLE_EQ(ldlt_singular.Determinant(), 0.0);
+  EXPECT_EQ(ldlt_singular.DeterminantSign(), 0);
+  EXPECT_THROW(ldlt_singular.Solve(b.Block(0, 0, 4, 1)), std::runtime_error);
+  EXPECT_THROW(ldlt.Solve(b.Block(0, 0, 299, 1)), std::runtime_error);
+  EXPECT_THROW(LDLT<>(Sample(3, 4, 1.0)), std::runtime_error);
+  EXPECT_THROW(Cholesky<>(Sample(3, 4, 1.0)), std::runtime_error);
+  S21Vector<> v(300);
+  EXPECT_THROW(cholesky.Solve(v, v), std::runtime_error);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../s21_matrix_oop.hpp"
+
+using namespace S21;
+
+TEST(ThreadPoolTest, Test1) {
+  ThreadPool pool(4);
+  ASSERT_EQ(pool.GetThreadCount(), 4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.ParallelFor(hits.size(), [&](std::size_t i) { hits[i]++; });
+  for (const auto &hit : hits) ASSERT_EQ(hit.load(), 1);
+}
+
+TEST(ThreadPoolTest, Test2) {
+  ThreadPool pool(3);
+  EXPECT_THROW(pool.ParallelFor(64,
+                                [](std::size_t i) {
+                                  if (i == 17) throw std::runtime_error("17");
+                                }),
+               std::runtime_error);
+  std::atomic<int> sum{0};
+  pool.ParallelFor(10, [&](std::size_t i) { sum += static_cast<int>(i); });
+  ASSERT_EQ(sum.load(), 45);
+}
+
+TEST(ThreadPoolTest, Test3) {
+  ThreadPool pool(4);
+  ThreadPool::ScopedSerial serial;
+  ASSERT_TRUE(ThreadPool::IsSerialContext());
+  const auto caller = std::this_thread::get_id();
+  bool inline_only = true;
+  pool.ParallelFor(32, [&](std::size_t) {
+    if (std::this_thread::get_id() != caller) inline_only = false;
+  });
+  EXPECT_TRUE(inline_only);
+}
+
+TEST(ThreadPoolTest, Test4) {
+  ThreadPool pool(2);
+  pool.SetThreadCount(5);
+  ASSERT_EQ(pool.GetThreadCount(), 5);
+  pool.SetThreadCount(0);
+  ASSERT_EQ(pool.GetThreadCount(), 1);
+  ASSERT_EQ(detail::ParseThreadCount("8"), 8);
+  ASSERT_EQ(detail::ParseThreadCount("-2"), 0);
+  ASSERT_EQ(detail::ParseThreadCount("4x"), 0);
+  ASSERT_EQ(detail::ParseThreadCount(nullptr), 0);
+}
+
+TEST(ThreadPoolTest, Test5) {
+  const std::size_t n = 200;
+  S21Matrix<double> a(n, n), b(n, n);
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t j = 0; j < n; j++) {
+      a(i, j) = static_cast<double>((i + 2 * j) % 9) - 4;
+      b(i, j) = static_cast<double>((3 * i + j) % 7) - 3;
+    }
+  S21Matrix<double> expected(n, n);
+  detail::GemmBlocked(n, n, n, 1.0, a.Data(), a.Stride(), b.Data(), b.Stride(),
+                      0.0, expected.Data(), expected.Stride());
+  ThreadPool pool(4);
+  S21Matrix<double> result(n, n);
+  detail::GemmParallel(pool, n, n, n, 1.0, a.Data(), a.Stride(), b.Data(),
+                       b.Stride(), 0.0, result.Data(), result.Stride());
+  EXPECT_TRUE(result.EqMatrix(expected));
+}
@@ -29,6 +29,68 @@ TEST(TransposeTest, Test2) {
 TEST(TransposeTest, Test3) {
   S21Matrix matrix1{1, 2};
   matrix1[0][0] = 1.0;
-  matrix1[0][1] = 1.0;
-  EXPECT_THROW(matrix1.Transpose(), std::runtime_error);
+  matrix1[0][1] = 2.0;
+  S21Matrix res = matrix1.Transpose();
+  ASSERT_EQ(res.GetRows(), 2);
+  ASSERT_EQ(res.GetCols(), 1);
+  EXPECT_DOUBLE_EQ(res(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(res(1, 0), 2.0);
+}
+
+namespace {
+
+S21Matrix<> Numbered(std::size_t rows, std::size_t cols) {
+  S21Matrix<> matrix(rows, cols);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      matrix[i][j] = static_cast<double>(i * cols + j);
+  return matrix;
+}
+
+bool IsTransposeOf(const S21Matrix<> &result, const S21Matrix<> &matrix) {
+  if (result.GetRows() != matrix.GetCols() ||
+      result.GetCols() != matrix.GetRows())
+    return false;
+  for (std::size_t i = 0; i < matrix.GetRows(); i++)
+    for (std::size_t j = 0; j < matrix.GetCols(); j++)
+      if (result(j, i) != matrix(i, j)) return false;
+  return true;
+}
+
+}  // namespace
+
+TEST(TransposeTest, Test4) {
+  // Shapes around the tile size, and one large enough to run in parallel
+  for (auto [rows, cols] : {std::pair<std::size_t, std::size_t>{31, 33},
+                            {64, 1}, {1, 100}, {97, 200}, {1100, 1000}}) {
+    const S21Matrix<> matrix = Numbered(rows, cols);
+    EXPECT_TRUE(IsTransposeOf(matrix.Transpose(), matrix));
+  }
+}
+
+TEST(TransposeTest, Test5) {
+  for (std::size_t n : {0, 1, 2, 33, 70, 1030}) {
+    const S21Matrix<> matrix = Numbered(n, n);
+    S21Matrix<> copy(matrix);
+    copy.TransposeInPlace();
+    EXPECT_TRUE(IsTransposeOf(copy, matrix));
+    const double *buffer = copy.Data();
+    S21Matrix<> moved = std::move(copy).Transpose();
+    EXPECT_EQ(moved.Data(), buffer);
+    EXPECT_TRUE(moved.EqMatrix(matrix));
+  }
+}
+
+TEST(TransposeTest, Test6) {
+  for (auto [rows, cols] : {std::pair<std::size_t, std::size_t>{1, 5},
+                            {2, 3}, {7, 13}, {40, 9}, {128, 96}}) {
+    const S21Matrix<> matrix = Numbered(rows, cols);
+    S21Matrix<> copy(matrix);
+    const double *buffer = copy.Data();
+    copy.TransposeInPlace();
+    EXPECT_EQ(copy.Data(), buffer);
+    EXPECT_TRUE(IsTransposeOf(copy, matrix));
+    S21Matrix<> back = std::move(copy).Transpose();
+    EXPECT_TRUE(back.EqMatrix(matrix));
+  }
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+S21Vector<> SampleVector(std::size_t size, double seed) {
+  S21Vector<> vector(size);
+  for (std::size_t i = 0; i < size; i++) vector[i] = std::cos(seed + i * 0.7);
+  return vector;
+}
+
+// y = alpha * op(A) * x + beta * y by plain loops.
+S21Vector<> Reference(double alpha, const S21Matrix<> &a, bool transposed,
+                      const S21Vector<> &x, double beta, S21Vector<> y) {
+  const std::size_t rows = transposed ? a.GetCols() : a.GetRows();
+  const std::size_t cols = transposed ? a.GetRows() : a.GetCols();
+  for (std::size_t i = 0; i < rows; i++) {
+    double sum = 0;
+    for (std::size_t j = 0; j < cols; j++)
+      sum += (transposed ? a(j, i) : a(i, j)) * x[j];
+    y[i] = alpha * sum + beta * y[i];
+  }
+  return y;
+}
+
+// Largest absolute difference between two vectors of the same size.
+double VectorDistance(const S21Vector<> &lhs, const S21Vector<> &rhs) {
+  double result = 0;
+  for (std::size_t i = 0; i < lhs.GetSize(); i++)
+    result = std::max(result, std::abs(lhs[i] - rhs[i]));
+  return result;
+}
+
+}  // namespace
+
+TEST(VectorTest, Test1) {
+  S21Vector<> a{1.0, 2.0, 3.0}, b{4.0, -5.0, 6.0};
+  EXPECT_EQ(a.GetSize(), 3);
+  EXPECT_DOUBLE_EQ(a.Dot(b), 12.0);
+  a.Axpy(2.0, b);
+  EXPECT_TRUE(a.EqVector(S21Vector<>{9.0, -8.0, 15.0}));
+  a.SubVector(b);
+  a.MulNumber(0.5);
+  EXPECT_TRUE(a.EqVector(S21Vector<>{2.5, -1.5, 4.5}));
+  a.SumVector(b);
+  EXPECT_DOUBLE_EQ(a(2), 10.5);
+  EXPECT_THROW(a(3), std::out_of_range);
+  EXPECT_THROW(a.Dot(S21Vector<>(2)), std::runtime_error);
+  EXPECT_THROW(a.Axpy(1.0, S21Vector<>(4)), std::runtime_error);
+  EXPECT_FALSE(a.EqVector(S21Vector<>(2)));
+  EXPECT_EQ(S21Vector<>().GetSize(), 0);
+}
+
+TEST(VectorTest, Test2) {
+  const S21Matrix<> a = Sample(37, 23);
+  const S21Vector<> x = SampleVector(23, 1.0), xt = SampleVector(37, 2.0);
+  S21Vector<> y = SampleVector(37, 3.0), yt = SampleVector(23, 4.0);
+  const S21Vector<> expected = Reference(1.5, a, false, x, -0.5, y);
+  const S21Vector<> expected_t = Reference(2.0, a, true, xt, 3.0, yt);
+  Gemv(1.5, a, x, -0.5, y);
+  GemvT(2.0, a, xt, 3.0, yt);
+  EXPECT_LT(VectorDistance(y, expected), 1e-12);
+  EXPECT_LT(VectorDistance(yt, expected_t), 1e-12);
+  EXPECT_LT(VectorDistance(a * x, Reference(1.0, a, false, x, 0.0, y)), 1e-12);
+
+  // beta == 0 overwrites the output, even NaN.
+  S21Vector<> nan(37);
+  for (std::size_t i = 0; i < 37; i++)
+    nan[i] = std::numeric_limits<double>::quiet_NaN();
+  Gemv(1.0, a, x, 0.0, nan);
+  EXPECT_TRUE(nan.EqVector(a * x));
+
+  EXPECT_THROW(Gemv(1.0, a, xt, 0.0, y), std::runtime_error);
+  EXPECT_THROW(GemvT(1.0, a, x, 0.0, yt), std::runtime_error);
+  S21Vector<> square = SampleVector(23, 5.0);
+  EXPECT_THROW(Gemv(1.0, Sample(23, 23), square, 0.0, square),
+               std::runtime_error);
+}
+
+TEST(VectorTest, Test3) {
+  // Large enough to be split across threads, with ragged column blocks.
+  const S21Matrix<> a = Sample(700, 523);
+  const S21Vector<> x = SampleVector(523, 1.0), xt = SampleVector(700, 2.0);
+  S21Vector<> y = SampleVector(700, 3.0), yt = SampleVector(523, 4.0);
+  const S21Vector<> expected = Reference(1.0, a, false, x, 2.0, y);
+  const S21Vector<> expected_t = Reference(-1.0, a, true, xt, 1.0, yt);
+  const ScopedThreadCount threads(3);
+  Gemv(1.0, a, x, 2.0, y);
+  GemvT(-1.0, a, xt, 1.0, yt);
+  EXPECT_LT(VectorDistance(y, expected), 1e-12);
+  EXPECT_LT(VectorDistance(yt, expected_t), 1e-12);
+
+  S21Matrix<float> af(3, 2);
+  af(0, 0) = 1.0f;
+  af(2, 1) = 2.0f;
+  S21Vector<float> v = af * S21Vector<float>{3.0f, 4.0f};
+  EXPECT_FLOAT_EQ(v[0], 3.0f);
+  EXPECT_FLOAT_EQ(v[2], 8.0f);
+}
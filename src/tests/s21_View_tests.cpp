@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../s21_matrix_oop.hpp"
+#include "s21_test_util.hpp"
+
+using namespace S21;
+
+namespace {
+
+// Copies a block out with plain loops.
+S21Matrix<> Copy(const S21Matrix<> &matrix, std::size_t row, std::size_t col,
+                 std::size_t rows, std::size_t cols) {
+  S21Matrix<> result(rows, cols);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      result(i, j) = matrix(row + i, col + j);
+  return result;
+}
+
+}  // namespace
+
+TEST(ViewTest, Test1) {
+  S21Matrix<> a = Sample(6, 7, 1.0);
+  const S21Matrix<> original = a;
+  S21MatrixView<> block = a.Block(1, 2, 3, 4);
+  EXPECT_EQ(block.GetRows(), 3);
+  EXPECT_EQ(block.GetCols(), 4);
+  EXPECT_EQ(block.Stride(), 7);
+  EXPECT_DOUBLE_EQ(block(2, 3), a(3, 5));
+  EXPECT_THROW(block(3, 0), std::out_of_range);
+  EXPECT_THROW(a.Block(4, 0, 3, 1), std::out_of_range);
+  EXPECT_THROW(a.Block(0, 8, 0, 0), std::out_of_range);
+  EXPECT_EQ(a.Block(6, 7, 0, 0).GetRows(), 0);
+
+  // Writes go to the matrix, and only to the block.
+  block(0, 0) = 10.0;
+  EXPECT_DOUBLE_EQ(a(1, 2), 10.0);
+  block *= 2.0;
+  block += Sample(3, 4, 2.0);
+  block -= original.Block(0, 0, 3, 4);
+  block.Block(1, 1, 2, 2) = S21Matrix<>(2, 2);
+  for (std::size_t i = 0; i < 6; i++) {
+    for (std::size_t j = 0; j < 7; j++) {
+      if (i < 1 || i > 3 || j < 2 || j > 5) {
+        EXPECT_DOUBLE_EQ(a(i, j), original(i, j));
+      } else if (i >= 2 && j >= 3 && j <= 4) {
+        EXPECT_DOUBLE_EQ(a(i, j), 0.0);
+      } else {
+        const double before = i == 1 && j == 2 ? 10.0 : original(i, j);
+        EXPECT_DOUBLE_EQ(a(i, j), 2.0 * before +
+                                      Sample(3, 4, 2.0)(i - 1, j - 2) -
+                                      original(i - 1, j - 2));
+      }
+    }
+  }
+
+  // Views mix with matrices in expressions.
+  const S21Matrix<> &c = a;
+  S21Matrix<> sum = c.Block(0, 0, 2, 2) * 3.0 + Copy(a, 4, 5, 2, 2);
+  EXPECT_DOUBLE_EQ(sum(1, 1), 3.0 * a(1, 1) + a(5, 6));
+  EXPECT_THROW(block = S21Matrix<>(2, 2), std::runtime_error);
+  S21MatrixView<const double> whole = c;
+  EXPECT_TRUE(S21Matrix<>(whole) == a);
+}
+
+TEST(ViewTest, Test2) {
+  S21Matrix<> a = Sample(90, 80, 3.0), b = Sample(70, 60, 4.0);
+  S21Matrix<> expected = Copy(a, 5, 10, 40, 30) * Copy(b, 20, 15, 30, 25);
+  EXPECT_TRUE((a.Block(5, 10, 40, 30) * b.Block(20, 15, 30, 25)) == expected);
+
+  // A trailing update in place, as in a blocked factorization.
+  S21Matrix<> c = a;
+  Gemm(-1.0, c.Block(20, 0, 70, 20), c.Block(0, 20, 20, 60), 1.0,
+       c.Block(20, 20, 70, 60));
+  S21Matrix<> update = Copy(a, 20, 20, 70, 60) -
+                       Copy(a, 20, 0, 70, 20) * Copy(a, 0, 20, 20, 60);
+  EXPECT_TRUE(S21Matrix<>(c.Block(20, 20, 70, 60)) == update);
+  EXPECT_TRUE(S21Matrix<>(c.Block(0, 0, 20, 80)) == Copy(a, 0, 0, 20, 80));
+  EXPECT_THROW(Gemm(1.0, c.Block(0, 0, 10, 10), a.Block(0, 0, 10, 10), 0.0,
+                    c.Block(5, 5, 10, 10)),
+               std::runtime_error);
+  EXPECT_THROW(Gemm(1.0, a.Block(0, 0, 10, 10), a.Block(0, 0, 9, 10), 0.0,
+                    c.Block(0, 0, 10, 10)),
+               std::runtime_error);
+
+  // Strided views: a column, and every other element of a block.
+  S21StridedView<const double> column = a.Strided(0, 3, 90, 1, 1, 1);
+  EXPECT_DOUBLE_EQ(column(89, 0), a(89, 3));
+  S21StridedView<double> even = c.Strided(1, 2, 4, 3, 2, 3);
+  even = S21Matrix<>(4, 3);
+  EXPECT_DOUBLE_EQ(c(7, 8), 0.0);
+  EXPECT_DOUBLE_EQ(c(7, 9), a(7, 9));
+  EXPECT_THROW(c.Strided(1, 2, 46, 3, 2, 3), std::out_of_range);
+  EXPECT_TRUE((a.Transpose() * column) ==
+              a.Transpose() * Copy(a, 0, 3, 90, 1));
+}
+
+TEST(ViewTest, Test3) {
+  const S21Matrix<> a = Sample(7, 7, 5.0);
+  for (std::size_t i = 0; i < 7; i++) {
+    for (std::size_t j = 0; j < 7; j++) {
+      S21MinorView<double> minor = a.GetMinorView(i, j);
+      EXPECT_EQ(minor.GetRows(), 6);
+      EXPECT_TRUE(S21Matrix<>(minor) == a.GetMinor(i, j));
+      EXPECT_NEAR(LU<>(minor).Determinant(), a.GetMinor(i, j).Determinant(),
+                  1e-12);
+    }
+  }
+  S21MinorView<double> minor = a.GetMinorView(2, 4);
+  EXPECT_DOUBLE_EQ(minor(2, 4), a(3, 5));
+  EXPECT_DOUBLE_EQ(minor(1, 3), a(1, 3));
+  EXPECT_THROW(minor(6, 0), std::out_of_range);
+  EXPECT_THROW(a.GetMinorView(7, 0), std::out_of_range);
+
+  // Minor of a block, and LU of a block and of an expression.
+  S21Matrix<> expected = Copy(a, 1, 1, 5, 5).GetMinor(0, 4);
+  EXPECT_TRUE(S21Matrix<>(a.Block(1, 1, 5, 5).GetMinorView(0, 4)) == expected);
+  EXPECT_NEAR(LU<>(a.Block(1, 1, 4, 4)).Determinant(),
+              Copy(a, 1, 1, 4, 4).Determinant(), 1e-12);
+  EXPECT_NEAR(LU<>(a + a).Determinant(), 128.0 * LU<>(a).Determinant(), 1e-9);
+  EXPECT_THROW(LU<>(a.Block(0, 0, 3, 4)), std::runtime_error);
+}
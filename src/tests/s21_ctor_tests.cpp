@@ -87,4 +87,33 @@ TEST(IndexOutOfRange, Test1) {
   A(1, 0) = 3;
   A(1, 1) = 4;
   EXPECT_THROW(A(-1, -1), std::out_of_range);
-}
\ No newline at end of file
+}
+
+TEST(Storage, Test1) {
+  S21Matrix A{3, 4};
+  ASSERT_EQ(A.Stride(), 4);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(A.Data()) %
+                S21Matrix<>::kAlignment,
+            0);
+  A(2, 1) = 7;
+  ASSERT_EQ(A.Data()[2 * A.Stride() + 1], 7);
+  ASSERT_EQ(&A[2][1], &A(2, 1));
+}
+
+TEST(Storage, Test2) {
+  S21Matrix A{2, 3};
+  double value = 0;
+  for (auto &element : A[1]) element = ++value;
+  ASSERT_EQ(A[1].size(), 3);
+  ASSERT_EQ(A(1, 2), 3);
+  const S21Matrix<> &ref = A;
+  ASSERT_EQ(ref[1][0], 1);
+}
+
+TEST(Storage, Test3) {
+  S21Matrix A{2, 2};
+  S21Matrix B = std::move(A);
+  ASSERT_EQ(A.GetRows(), 0);
+  ASSERT_EQ(A.Data(), nullptr);
+  ASSERT_EQ(B.GetRows(), 2);
+}
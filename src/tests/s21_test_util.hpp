@@ -0,0 +1,67 @@
+#ifndef S21_TESTS_S21_TEST_UTIL_HPP_
+#define S21_TESTS_S21_TEST_UTIL_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "../s21_matrix_oop.hpp"
+
+/// @file
+/// @brief Helpers shared by the test suites.
+
+/// @brief Creates a matrix of sin(seed + 0.37 i + 0.11 j): dense, in
+/// [-1, 1], with no two rows or columns alike and a different matrix for
+/// every seed.
+template <typename T = double>
+S21::S21Matrix<T> Sample(std::size_t rows, std::size_t cols,
+                         double seed = 0.0) {
+  S21::S21Matrix<T> matrix(rows, cols);
+  for (std::size_t i = 0; i < rows; i++)
+    for (std::size_t j = 0; j < cols; j++)
+      matrix(i, j) = static_cast<T>(std::sin(seed + i * 0.37 + j * 0.11));
+  return matrix;
+}
+
+/// @brief Creates Sample() with cols + 1 added to the diagonal, so that
+/// every row is strictly diagonally dominant: square ones are invertible
+/// and well conditioned without pivoting.
+template <typename T = double>
+S21::S21Matrix<T> DiagonallyDominant(std::size_t rows, std::size_t cols,
+                                     double seed = 0.0) {
+  S21::S21Matrix<T> matrix = Sample<T>(rows, cols, seed);
+  for (std::size_t i = 0; i < rows && i < cols; i++)
+    matrix(i, i) += static_cast<T>(cols + 1);
+  return matrix;
+}
+
+/// @brief Returns the largest absolute difference between the elements of
+/// two matrices of the same size.
+template <typename T>
+double Distance(const S21::S21Matrix<T> &lhs, const S21::S21Matrix<T> &rhs) {
+  double result = 0;
+  for (std::size_t i = 0; i < lhs.GetRows(); i++)
+    for (std::size_t j = 0; j < lhs.GetCols(); j++)
+      result = std::max(result, std::abs(double(lhs(i, j) - rhs(i, j))));
+  return result;
+}
+
+/// @brief Sets the thread count of the global pool for its lifetime, so
+/// that a failed assertion cannot leave it changed for later tests.
+class ScopedThreadCount {
+ public:
+  explicit ScopedThreadCount(std::size_t count)
+      : previous_(S21::ThreadPool::Instance().GetThreadCount()) {
+    S21::ThreadPool::Instance().SetThreadCount(count);
+  }
+  ~ScopedThreadCount() {
+    S21::ThreadPool::Instance().SetThreadCount(previous_);
+  }
+  ScopedThreadCount(const ScopedThreadCount &) = delete;
+  ScopedThreadCount &operator=(const ScopedThreadCount &) = delete;
+
+ private:
+  std::size_t previous_;
+};
+
+#endif  // S21_TESTS_S21_TEST_UTIL_HPP_